@@ -0,0 +1,129 @@
+/**
+
+  \file DONLP2Cache.c
+
+  remember energies, gradients and constraint auxiliaries
+  for the DONLP2 minimizers
+
+
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "DONLP2Cache.h"
+
+
+void initDONLP2Cache(DONLP2Cache* C, const Parameterization* P, const Para* q)
+{
+  int c;
+
+  C->n = q->n;
+  C->x = malloc(q->n*sizeof(double));
+  C->gradf = malloc(q->n*sizeof(double));
+  C->val = C->grad = 0;
+
+  C->next = 0;
+  for (c=0; c<NCACHEAUX; c++) {
+    C->xc[c] = malloc(q->n*sizeof(double));
+    C->boost[c] = 0;
+    C->valc[c] = C->gradc[c] = 0;
+
+    C->Q[c] = malloc(sizeof(SlaterDet));
+    C->X[c] = malloc(sizeof(SlaterDetAux));
+    C->dX[c] = malloc(sizeof(gradSlaterDetAux));
+    P->ParainitSlaterDet(q, C->Q[c]);
+    initSlaterDetAux(C->Q[c], C->X[c]);
+    initgradSlaterDetAux(C->Q[c], C->dX[c]);
+  }
+}
+
+
+void freeDONLP2Cache(DONLP2Cache* C)
+{
+  int c;
+
+  free(C->x);
+  free(C->gradf);
+  for (c=0; c<NCACHEAUX; c++) {
+    free(C->xc[c]);
+    freegradSlaterDetAux(C->dX[c]);
+    freeSlaterDetAux(C->X[c]);
+    freeSlaterDet(C->Q[c]);
+    free(C->dX[c]);
+    free(C->X[c]);
+    free(C->Q[c]);
+  }
+}
+
+
+static int cachedx(const DONLP2Cache* C, const double* xc, const double* x)
+{
+  return !memcmp(xc, x, C->n*sizeof(double));
+}
+
+
+int lookupDONLP2Cache(const DONLP2Cache* C, const double* x,
+		      double* eintr, double* eproj, double* gradf)
+{
+  if (!C->val || (gradf && !C->grad) || !cachedx(C, C->x, x))
+    return 0;
+
+  *eintr = C->eintr;
+  *eproj = C->eproj;
+  if (gradf)
+    memcpy(gradf, C->gradf, C->n*sizeof(double));
+
+  return 1;
+}
+
+
+void storeDONLP2Cache(DONLP2Cache* C, const double* x,
+		      double eintr, double eproj, const double* gradf)
+{
+  memcpy(C->x, x, C->n*sizeof(double));
+  C->eintr = eintr;
+  C->eproj = eproj;
+  C->val = 1;
+  C->grad = 0;
+  if (gradf) {
+    memcpy(C->gradf, gradf, C->n*sizeof(double));
+    C->grad = 1;
+  }
+}
+
+
+int constraintauxDONLP2Cache(DONLP2Cache* C,
+			     const Parameterization* P, const Para* q,
+			     const double* x, int boost, int grad)
+{
+  int c;
+
+  for (c=0; c<NCACHEAUX; c++)
+    if (C->valc[c] && C->boost[c] == boost && cachedx(C, C->xc[c], x))
+      break;
+
+  if (c == NCACHEAUX) {
+    c = C->next;
+    C->next = (c+1) % NCACHEAUX;
+
+    P->ParatoSlaterDet(q, C->Q[c]);
+    if (boost) {
+      // nail to center-of-mass
+      moveboostSlaterDet(C->Q[c], C->X[c]);
+    }
+    calcSlaterDetAux(C->Q[c], C->X[c]);
+
+    memcpy(C->xc[c], x, C->n*sizeof(double));
+    C->boost[c] = boost;
+    C->valc[c] = 1;
+    C->gradc[c] = 0;
+  }
+
+  if (grad && !C->gradc[c]) {
+    calcgradSlaterDetAux(C->Q[c], C->X[c], C->dX[c]);
+    C->gradc[c] = 1;
+  }
+
+  return c;
+}
@@ -0,0 +1,61 @@
+/**
+
+  \file DONLP2Cache.h
+
+  DONLP2 evaluates ef and egradf, and eh and egradh
+  for all constraints repeatedly at the same parameters,
+  remember the results of the last evaluations
+
+
+*/
+
+#ifndef _DONLP2CACHE_H
+#define _DONLP2CACHE_H
+
+#include "fmd/SlaterDet.h"
+#include "fmd/gradSlaterDet.h"
+#include "fmd/Parameterization.h"
+
+
+// constraint gradients are usually needed at the accepted point
+// after the next trial point was already evaluated
+#define NCACHEAUX 4
+
+typedef struct {
+  int n;		///< number of parameters
+  double* x;		///< parameters of cached energy and gradient
+  int val, grad;
+  double eintr, eproj;
+  double* gradf;
+
+  // auxiliaries for constraints at the last points
+  int next;
+  double* xc[NCACHEAUX];
+  int boost[NCACHEAUX];
+  int valc[NCACHEAUX], gradc[NCACHEAUX];
+  SlaterDet* Q[NCACHEAUX];
+  SlaterDetAux* X[NCACHEAUX];
+  gradSlaterDetAux* dX[NCACHEAUX];
+} DONLP2Cache;
+
+
+void initDONLP2Cache(DONLP2Cache* C, const Parameterization* P, const Para* q);
+
+/// release the workspaces allocated by initDONLP2Cache
+void freeDONLP2Cache(DONLP2Cache* C);
+
+/// energies (and gradient if gradf != NULL) at x, 0 if not cached
+int lookupDONLP2Cache(const DONLP2Cache* C, const double* x,
+		      double* eintr, double* eproj, double* gradf);
+
+/// remember energies (and gradient if gradf != NULL) at x
+void storeDONLP2Cache(DONLP2Cache* C, const double* x,
+		      double eintr, double eproj, const double* gradf);
+
+/// SlaterDet q (nailed to center-of-mass if boost) and auxiliaries
+/// for constraints at x, returns slot c in C->Q, C->X, C->dX
+int constraintauxDONLP2Cache(DONLP2Cache* C,
+			     const Parameterization* P, const Para* q,
+			     const double* x, int boost, int grad);
+
+#endif
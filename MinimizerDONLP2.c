@@ -30,6 +30,7 @@
 #include "fmd/Parameterization.h"
 #include "fmd/Constraint.h"
 #include "numerics/donlp2.h"
+#include "misc/profile.h"
 
 #ifdef MPI
 #include "fmdmpi/Hamiltonianmpi.h"
@@ -130,6 +131,7 @@ void MinimizeDONLP2(const Interaction* Int,
 
 void FORTRAN(ef)(const double* x, double* fx)
 {
+  PROFILECOUNT("donlp2 ef", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -149,6 +151,7 @@ void FORTRAN(ef)(const double* x, double* fx)
 
 void FORTRAN(egradf)(const double* x, double* gradf)
 {
+  PROFILECOUNT("donlp2 egradf", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -204,6 +207,7 @@ void FORTRAN(egradg)(int* i, const double* x, double* gradgi)
 
 void FORTRAN(eh)(int* i, const double* x, double* hxi)
 {
+  PROFILECOUNT("donlp2 eh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -223,6 +227,7 @@ void FORTRAN(eh)(int* i, const double* x, double* hxi)
 
 void FORTRAN(egradh)(int* i, const double* x, double* gradhi)
 {
+  PROFILECOUNT("donlp2 egradh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
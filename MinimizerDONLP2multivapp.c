@@ -34,11 +34,13 @@
 #include "fmd/ConstraintJ2.h"
 #include "fmd/Projection.h"
 #include "numerics/donlp2.h"
+#include "misc/profile.h"
 
 #include "fmd/Hamiltonian.h"
 #include "fmd/gradHamiltonian.h"
 
 #include "MinimizerDONLP2multivapp.h"
+#include "DONLP2Cache.h"
 
 #include "numerics/fortranc.h"
 #include "numerics/wignerd.h"
@@ -137,6 +139,11 @@ static struct {
   gradSlaterDet* dhmulti;
   gradSlaterDet* dnmulti;
 } Work;
+
+
+// DONLP2 evaluates ef and egradf, and eh and egradh
+// for all constraints repeatedly at the same x
+static DONLP2Cache Cache;
   
 
 #define M_2PI (2*M_PI)
@@ -336,11 +343,20 @@ void calcprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
   complex double nme, hme, j2me;
   double alpha, beta, gamma, w;
 
+  // diagonal kernels are hermitian, only one point of each pair
+  // of inverse rotations has to be calculated
+  int herm = (Q == Qp && angHermitian(angpara));
+
   int i, ip;
   for (i=0; i<nang; i++) {
+    if (herm && angpara->inv[i] < i)
+      continue;
+
     copySlaterDet(Qp, Qpp);
 
     getangintegrationpoint(i, angpara, &alpha, &beta, &gamma, &w);
+    if (herm)
+      w *= angHermitianweight(angpara, i);
 
     rotateSlaterDet(Qpp, alpha, beta, gamma);
     for (ip=0; ip<=1; ip++) {
@@ -363,6 +379,15 @@ void calcprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
     }
   }
 
+  // contributions of the inverse rotations
+  if (herm)
+    for (kp=-j; kp<=j; kp=kp+2)
+      for (k=-j; k<=kp; k=k+2) {
+	angHermitianpair(&H[idxjmk(j,k,kp)], &H[idxjmk(j,kp,k)]);
+	angHermitianpair(&N[idxjmk(j,k,kp)], &N[idxjmk(j,kp,k)]);
+	angHermitianpair(&J2[idxjmk(j,k,kp)], &J2[idxjmk(j,kp,k)]);
+      }
+
 }
 #endif
 
@@ -1200,6 +1225,8 @@ void MinimizeDONLP2multivapp(const Interaction* Int,
   Min.Q = malloc(sizeof(SlaterDet));
   P->ParainitSlaterDet(q, Min.Q); 
 
+  initDONLP2Cache(&Cache, P, q);
+
 #ifndef MPI
   // regular program execution or catched signal ?
   if (!setjmp(env))
@@ -1210,11 +1237,14 @@ void MinimizeDONLP2multivapp(const Interaction* Int,
 	  (int) FORTRAN(o8itin).optite + 11);
 
   copyxtopara(FORTRAN(o8xdat).x, Min.q);
+
+  freeDONLP2Cache(&Cache);
 }
 
 
 void FORTRAN(ef)(const double* x, double* fx)
 {
+  PROFILECOUNT("donlp2 ef", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1228,13 +1258,18 @@ void FORTRAN(ef)(const double* x, double* fx)
 
   double eintr, emult;
 
-  calcprojectedHamiltonian(Min.nfix,
-                           Min.Qfix,
-                           Min.Q,
-			   Min.Int,
-			   Min.j, Min.par, Min.ival,
-                           Min.projpar,
-                           &eintr, &emult);
+  // energy known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &emult, NULL)) {
+    calcprojectedHamiltonian(Min.nfix,
+			     Min.Qfix,
+			     Min.Q,
+			     Min.Int,
+			     Min.j, Min.par, Min.ival,
+			     Min.projpar,
+			     &eintr, &emult);
+
+    storeDONLP2Cache(&Cache, x, eintr, emult, NULL);
+  }
 
   *fx = (emult+Min.alpha*eintr);
   FORTRAN(o8cnt).icf++;
@@ -1247,6 +1282,7 @@ void FORTRAN(ef)(const double* x, double* fx)
 
 void FORTRAN(egradf)(const double* x, double* gradf)
 {
+  PROFILECOUNT("donlp2 egradf", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1260,23 +1296,29 @@ void FORTRAN(egradf)(const double* x, double* gradf)
 
   double eintr, emulti;
 
-  calcgradprojectedHamiltonian(Min.nfix,
-                               Min.Qfix,
-                               Min.Q,
-			       Min.Int,
-			       Min.j, Min.par, Min.ival, 
-                               Min.projpar,
-			       &eintr, &emulti);
+  // gradient known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &emulti, gradf)) {
+    calcgradprojectedHamiltonian(Min.nfix,
+				 Min.Qfix,
+				 Min.Q,
+				 Min.Int,
+				 Min.j, Min.par, Min.ival, 
+				 Min.projpar,
+				 &eintr, &emulti);
 
-  // add gradient from intrinsic energy
+    // add gradient from intrinsic energy
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
-  calcgradHamiltonian(Min.Int, Min.Q, Work.X, Work.dX, Work.dh);
+    calcSlaterDetAux(Min.Q, Work.X);
+    calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
+    calcgradHamiltonian(Min.Int, Min.Q, Work.X, Work.dX, Work.dh);
 
-  addmulttogradSlaterDet(Work.dhmulti, Work.dh, Min.alpha);
+    addmulttogradSlaterDet(Work.dhmulti, Work.dh, Min.alpha);
+
+    Min.P->ParaprojectgradSlaterDet(Min.q, Work.dhmulti, gradf);
+
+    storeDONLP2Cache(&Cache, x, eintr, emulti, gradf);
+  }
 
-  Min.P->ParaprojectgradSlaterDet(Min.q, Work.dhmulti, gradf);
   FORTRAN(o8cnt).icgf++;
   fprintf(stderr, "grad %3d: \tE = %8.3f MeV, Emulti = %8.3f MeV, Eintr = %8.3f MeV\n", 
 	  FORTRAN(o8cnt).icgf, hbc*(emulti+Min.alpha*eintr), hbc*emulti, hbc*eintr);
@@ -1319,21 +1361,16 @@ void FORTRAN(egradg)(int* i, const double* x, double* gradgi)
 
 void FORTRAN(eh)(int* i, const double* x, double* hxi)
 {
+  PROFILECOUNT("donlp2 eh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
 
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, *i > 1, 0);
 
-  if (*i > 1) {
-    // nail to center-of-mass
-    moveboostSlaterDet(Min.Q, Work.X);
-  }
-
-  calcSlaterDetAux(Min.Q, Work.X);
-  Min.Const[*i-1].me(Min.Q, Work.X, hxi);
+  Min.Const[*i-1].me(Cache.Q[c], Cache.X[c], hxi);
 
   fprintf(stderr, "\t\t\tme   %4s = %8.3f\n", 
   	  Min.Const[*i-1].label, Min.Const[*i-1].output(*hxi));
@@ -1344,22 +1381,16 @@ void FORTRAN(eh)(int* i, const double* x, double* hxi)
 
 void FORTRAN(egradh)(int* i, const double* x, double* gradhi)
 {
+  PROFILECOUNT("donlp2 egradh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
-
-  if (*i > 1) {
-    // nail to center-of-mass
-    moveboostSlaterDet(Min.Q, Work.X);
-  }
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, *i > 1, 1);
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
   zerogradSlaterDet(Work.dh);
-  Min.Const[*i-1].gradme(Min.Q, Work.X, Work.dX, Work.dh);
+  Min.Const[*i-1].gradme(Cache.Q[c], Cache.X[c], Cache.dX[c], Work.dh);
 
   Min.P->ParaprojectgradSlaterDet(Min.q, Work.dh, gradhi);
   fprintf(stderr, "\t\t\tgrad %4s = %8.3f\n", 
@@ -34,11 +34,13 @@
 #include "fmd/ConstraintJ2.h"
 #include "fmd/Projection.h"
 #include "numerics/donlp2.h"
+#include "misc/profile.h"
 
 #include "fmd/Hamiltonian.h"
 #include "fmd/gradHamiltonian.h"
 
 #include "MinimizerDONLP2multivappcm.h"
+#include "DONLP2Cache.h"
 
 #include "numerics/fortranc.h"
 #include "numerics/wignerd.h"
@@ -137,6 +139,10 @@ static struct {
   gradSlaterDet* dhmulti;
   gradSlaterDet* dnmulti;
 } Work;
+
+// DONLP2 evaluates ef and egradf, and eh and egradh
+// for all constraints repeatedly at the same x
+static DONLP2Cache Cache;
   
 
 #define M_2PI (2*M_PI)
@@ -1248,6 +1254,8 @@ void MinimizeDONLP2multivapp(const Interaction* Int,
   Min.Q = malloc(sizeof(SlaterDet));
   P->ParainitSlaterDet(q, Min.Q); 
 
+  initDONLP2Cache(&Cache, P, q);
+
 #ifndef MPI
   // regular program execution or catched signal ?
   if (!setjmp(env))
@@ -1258,11 +1266,14 @@ void MinimizeDONLP2multivapp(const Interaction* Int,
 	  (int) FORTRAN(o8itin).optite + 11);
 
   copyxtopara(FORTRAN(o8xdat).x, Min.q);
+
+  freeDONLP2Cache(&Cache);
 }
 
 
 void FORTRAN(ef)(const double* x, double* fx)
 {
+  PROFILECOUNT("donlp2 ef", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1276,13 +1287,18 @@ void FORTRAN(ef)(const double* x, double* fx)
 
   double eintr, emult;
 
-  calcprojectedHamiltonian(Min.nfix,
-                           Min.Qfix,
-                           Min.Q,
-			   Min.Int,
-			   Min.j, Min.par, Min.ival,
-                           Min.angpara, Min.cmpara,
-                           &eintr, &emult);
+  // energy known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &emult, NULL)) {
+    calcprojectedHamiltonian(Min.nfix,
+			     Min.Qfix,
+			     Min.Q,
+			     Min.Int,
+			     Min.j, Min.par, Min.ival,
+			     Min.angpara, Min.cmpara,
+			     &eintr, &emult);
+
+    storeDONLP2Cache(&Cache, x, eintr, emult, NULL);
+  }
 
   *fx = (emult+Min.alpha*eintr);
   FORTRAN(o8cnt).icf++;
@@ -1295,6 +1311,7 @@ void FORTRAN(ef)(const double* x, double* fx)
 
 void FORTRAN(egradf)(const double* x, double* gradf)
 {
+  PROFILECOUNT("donlp2 egradf", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1308,24 +1325,30 @@ void FORTRAN(egradf)(const double* x, double* gradf)
 
   double eintr, emulti;
 
-  calcgradprojectedHamiltonian(Min.nfix,
-                               Min.Qfix,
-                               Min.Q,
-			       Min.Int,
-			       Min.j, Min.par, Min.ival, 
-                               Min.angpara,
-			       Min.cmpara,
-			       &eintr, &emulti);
+  // gradient known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &emulti, gradf)) {
+    calcgradprojectedHamiltonian(Min.nfix,
+				 Min.Qfix,
+				 Min.Q,
+				 Min.Int,
+				 Min.j, Min.par, Min.ival, 
+				 Min.angpara,
+				 Min.cmpara,
+				 &eintr, &emulti);
 
-  // add gradient from intrinsic energy
+    // add gradient from intrinsic energy
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
-  calcgradHamiltonian(Min.Int, Min.Q, Work.X, Work.dX, Work.dh);
+    calcSlaterDetAux(Min.Q, Work.X);
+    calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
+    calcgradHamiltonian(Min.Int, Min.Q, Work.X, Work.dX, Work.dh);
 
-  addmulttogradSlaterDet(Work.dhmulti, Work.dh, Min.alpha);
+    addmulttogradSlaterDet(Work.dhmulti, Work.dh, Min.alpha);
+
+    Min.P->ParaprojectgradSlaterDet(Min.q, Work.dhmulti, gradf);
+
+    storeDONLP2Cache(&Cache, x, eintr, emulti, gradf);
+  }
 
-  Min.P->ParaprojectgradSlaterDet(Min.q, Work.dhmulti, gradf);
   FORTRAN(o8cnt).icgf++;
   fprintf(stderr, "grad %3d: \tE = %8.3f MeV, Emulti = %8.3f MeV, Eintr = %8.3f MeV\n", 
 	  FORTRAN(o8cnt).icgf, hbc*(emulti+Min.alpha*eintr), hbc*emulti, hbc*eintr);
@@ -1368,21 +1391,16 @@ void FORTRAN(egradg)(int* i, const double* x, double* gradgi)
 
 void FORTRAN(eh)(int* i, const double* x, double* hxi)
 {
+  PROFILECOUNT("donlp2 eh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
 
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
-
-  if (*i > 1) {
-    // nail to center-of-mass
-    moveboostSlaterDet(Min.Q, Work.X);
-  }
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, *i > 1, 0);
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  Min.Const[*i-1].me(Min.Q, Work.X, hxi);
+  Min.Const[*i-1].me(Cache.Q[c], Cache.X[c], hxi);
 
   fprintf(stderr, "\t\t\tme   %4s = %8.3f\n", 
   	  Min.Const[*i-1].label, Min.Const[*i-1].output(*hxi));
@@ -1393,22 +1411,16 @@ void FORTRAN(eh)(int* i, const double* x, double* hxi)
 
 void FORTRAN(egradh)(int* i, const double* x, double* gradhi)
 {
+  PROFILECOUNT("donlp2 egradh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
-
-  if (*i > 1) {
-    // nail to center-of-mass
-    moveboostSlaterDet(Min.Q, Work.X);
-  }
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, *i > 1, 1);
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
   zerogradSlaterDet(Work.dh);
-  Min.Const[*i-1].gradme(Min.Q, Work.X, Work.dX, Work.dh);
+  Min.Const[*i-1].gradme(Cache.Q[c], Cache.X[c], Cache.dX[c], Work.dh);
 
   Min.P->ParaprojectgradSlaterDet(Min.q, Work.dh, gradhi);
   fprintf(stderr, "\t\t\tgrad %4s = %8.3f\n", 
@@ -32,6 +32,7 @@
 #include "fmd/ConstraintJ2.h"
 #include "fmd/Projection.h"
 #include "numerics/donlp2.h"
+#include "misc/profile.h"
 
 #include "fmd/Hamiltonian.h"
 #include "fmd/gradHamiltonian.h"
@@ -1216,6 +1217,7 @@ void MinimizeDONLP2orthproj(const Interaction* Int, int j, int k, int par,
 
 void FORTRAN(ef)(const double* x, double* fx)
 {
+  PROFILECOUNT("donlp2 ef", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1250,6 +1252,7 @@ void FORTRAN(ef)(const double* x, double* fx)
 
 void FORTRAN(egradf)(const double* x, double* gradf)
 {
+  PROFILECOUNT("donlp2 egradf", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1315,6 +1318,7 @@ void FORTRAN(egradg)(int* i, const double* x, double* gradgi)
 
 void FORTRAN(eh)(int* i, const double* x, double* hxi)
 {
+  PROFILECOUNT("donlp2 eh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1335,6 +1339,7 @@ void FORTRAN(eh)(int* i, const double* x, double* hxi)
 
 void FORTRAN(egradh)(int* i, const double* x, double* gradhi)
 {
+  PROFILECOUNT("donlp2 egradh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -30,6 +30,7 @@
 #include "fmd/Parameterization.h"
 #include "fmd/Constraint.h"
 #include "numerics/donlp2.h"
+#include "misc/profile.h"
 
 #ifdef MPI
 #include "fmdmpi/Hamiltonianmpi.h"
@@ -135,6 +136,7 @@ void MinimizeDONLP2p(const Interaction* Int, int par,
 
 void FORTRAN(ef)(const double* x, double* fx)
 {
+  PROFILECOUNT("donlp2 ef", 1);
   complex double hd, hp, nd, np;
 
   if (sigterminate)
@@ -168,6 +170,7 @@ void FORTRAN(ef)(const double* x, double* fx)
 
 void FORTRAN(egradf)(const double* x, double* gradf)
 {
+  PROFILECOUNT("donlp2 egradf", 1);
   complex double hd, hp, nd, np;
   complex double H, N;
 
@@ -255,6 +258,7 @@ void FORTRAN(egradg)(int* i, const double* x, double* gradgi)
 
 void FORTRAN(eh)(int* i, const double* x, double* hxi)
 {
+  PROFILECOUNT("donlp2 eh", 1);
   if (sigterminate)
     longjmp(env, 1);
   copyxtopara(x, Min.q);
@@ -272,6 +276,7 @@ void FORTRAN(eh)(int* i, const double* x, double* hxi)
 
 void FORTRAN(egradh)(int* i, const double* x, double* gradhi)
 {
+  PROFILECOUNT("donlp2 egradh", 1);
   if (sigterminate)
     longjmp(env, 1);
   copyxtopara(x, Min.q);
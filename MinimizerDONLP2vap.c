@@ -32,11 +32,13 @@
 #include "fmd/ConstraintJ2.h"
 #include "fmd/Projection.h"
 #include "numerics/donlp2.h"
+#include "misc/profile.h"
 
 #include "fmd/Hamiltonian.h"
 #include "fmd/gradHamiltonian.h"
 
 #include "MinimizerDONLP2vap.h"
+#include "DONLP2Cache.h"
 
 #include "numerics/fortranc.h"
 #include "numerics/wignerd.h"
@@ -116,6 +118,11 @@ static struct {
   SlaterDet* Qpp;
   SlaterDetAux* X;
 } Work;
+
+
+// DONLP2 evaluates ef and egradf, and eh and egradh
+// for all constraints repeatedly at the same x
+static DONLP2Cache Cache;
   
 
 #ifdef ORIENTED
@@ -935,6 +942,8 @@ void MinimizeDONLP2vap(const Interaction* Int, int j, int par,
   Min.dhproj = malloc(sizeof(gradSlaterDet));
   Min.dnproj = malloc(sizeof(gradSlaterDet));
   Min.P->ParainitSlaterDet(q, Min.Q);
+
+  initDONLP2Cache(&Cache, P, q);
   Min.P->ParainitSlaterDet(q, Min.Qp);
   Min.P->ParainitSlaterDet(q, Min.Qpp);
   initSlaterDetAux(Min.Q, Min.X);
@@ -958,11 +967,14 @@ void MinimizeDONLP2vap(const Interaction* Int, int j, int par,
 	  (int) FORTRAN(o8itin).optite + 11);
 
   copyxtopara(FORTRAN(o8xdat).x, Min.q);
+
+  freeDONLP2Cache(&Cache);
 }
 
 
 void FORTRAN(ef)(const double* x, double* fx)
 {
+  PROFILECOUNT("donlp2 ef", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -972,18 +984,24 @@ void FORTRAN(ef)(const double* x, double* fx)
   Min.P->ParatoSlaterDet(Min.q, Min.Q);
 
   double eintr, eproj;
+
+  // energy known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &eproj, NULL)) {
 #ifdef MPI
-  calcprojectedHamiltonianmpi(Min.Q,
-			   Min.Int,
-			   Min.j, Min.par, Min.projpar,
-			   &eintr, &eproj);
+    calcprojectedHamiltonianmpi(Min.Q,
+			     Min.Int,
+			     Min.j, Min.par, Min.projpar,
+			     &eintr, &eproj);
 #else
-  calcprojectedHamiltonian(Min.Q,
-			   Min.Int,
-			   Min.j, Min.par, Min.projpar,
-			   &eintr, &eproj);
+    calcprojectedHamiltonian(Min.Q,
+			     Min.Int,
+			     Min.j, Min.par, Min.projpar,
+			     &eintr, &eproj);
 #endif
 
+    storeDONLP2Cache(&Cache, x, eintr, eproj, NULL);
+  }
+
   *fx = eproj;
   FORTRAN(o8cnt).icf++;
 
@@ -995,6 +1013,7 @@ void FORTRAN(ef)(const double* x, double* fx)
 
 void FORTRAN(egradf)(const double* x, double* gradf)
 {
+  PROFILECOUNT("donlp2 egradf", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1005,19 +1024,25 @@ void FORTRAN(egradf)(const double* x, double* gradf)
 
   double eintr, eproj;
 
+  // gradient known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &eproj, gradf)) {
 #ifdef MPI
-  calcgradprojectedHamiltonianmpi(Min.Q,
-			       Min.Int,
-			       Min.j, Min.par, Min.projpar,
-			       &eintr, &eproj);
+    calcgradprojectedHamiltonianmpi(Min.Q,
+				 Min.Int,
+				 Min.j, Min.par, Min.projpar,
+				 &eintr, &eproj);
 #else
-  calcgradprojectedHamiltonian(Min.Q,
-			       Min.Int,
-			       Min.j, Min.par, Min.projpar,
-			       &eintr, &eproj);
+    calcgradprojectedHamiltonian(Min.Q,
+				 Min.Int,
+				 Min.j, Min.par, Min.projpar,
+				 &eintr, &eproj);
 #endif
 
-  Min.P->ParaprojectgradSlaterDet(Min.q, Min.dhproj, gradf);
+    Min.P->ParaprojectgradSlaterDet(Min.q, Min.dhproj, gradf);
+
+    storeDONLP2Cache(&Cache, x, eintr, eproj, gradf);
+  }
+
   FORTRAN(o8cnt).icgf++;
   fprintf(stderr, "grad %3d: \tE = %8.3f MeV,   Eintr = %8.3f MeV\n", 
 	  FORTRAN(o8cnt).icgf, hbc*eproj, hbc*eintr);
@@ -1060,16 +1085,16 @@ void FORTRAN(egradg)(int* i, const double* x, double* gradgi)
 
 void FORTRAN(eh)(int* i, const double* x, double* hxi)
 {
+  PROFILECOUNT("donlp2 eh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
 
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, 0, 0);
 
-  calcSlaterDetAux(Min.Q, Min.X);
-  Min.Const[*i-1].me(Min.Q, Min.X, hxi);
+  Min.Const[*i-1].me(Cache.Q[c], Cache.X[c], hxi);
 
   fprintf(stderr, "\t\t\tme   %4s = %8.3f\n", 
   	  Min.Const[*i-1].label, Min.Const[*i-1].output(*hxi));
@@ -1080,17 +1105,16 @@ void FORTRAN(eh)(int* i, const double* x, double* hxi)
 
 void FORTRAN(egradh)(int* i, const double* x, double* gradhi)
 {
+  PROFILECOUNT("donlp2 egradh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, 0, 1);
 
-  calcSlaterDetAux(Min.Q, Min.X);
-  calcgradSlaterDetAux(Min.Q, Min.X, Min.dX);
   zerogradSlaterDet(Min.dH);
-  Min.Const[*i-1].gradme(Min.Q, Min.X, Min.dX, Min.dH);
+  Min.Const[*i-1].gradme(Cache.Q[c], Cache.X[c], Cache.dX[c], Min.dH);
 
   Min.P->ParaprojectgradSlaterDet(Min.q, Min.dH, gradhi);
   fprintf(stderr, "\t\t\tgrad %4s = %8.3f\n", 
@@ -34,11 +34,13 @@
 #include "fmd/ConstraintJ2.h"
 #include "fmd/Projection.h"
 #include "numerics/donlp2.h"
+#include "misc/profile.h"
 
 #include "fmd/Hamiltonian.h"
 #include "fmd/gradHamiltonian.h"
 
 #include "MinimizerDONLP2vapp.h"
+#include "DONLP2Cache.h"
 
 #include "numerics/fortranc.h"
 #include "numerics/wignerd.h"
@@ -119,13 +121,18 @@ static struct {
   gradSlaterDet* dN;
 
   SlaterDet* Qp;
-  SlaterDet* Qpp;
-  SlaterDetAux* X;
+  SlaterDet* Qpp;            // rotated Qp and its parity image
+  SlaterDetAux* X;           // auxiliaries for both parities
   gradSlaterDetAux* dX;
 
   gradSlaterDet* dhproj;
   gradSlaterDet* dnproj;
 } Work;
+
+
+// DONLP2 evaluates ef and egradf, and eh and egradh
+// for all constraints repeatedly at the same x
+static DONLP2Cache Cache;
   
 
 #define M_2PI (2*M_PI)
@@ -350,6 +357,7 @@ void calcprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
   int nang = angpara->n;
 
   reinitangintegration(Q, Qp, 0, 0, angpara);
+  const angDtable* Dtab = getangDtable(angpara, j+1);
 
   int k,kp;
   for (kp=-j; kp<=j; kp=kp+2)
@@ -362,33 +370,58 @@ void calcprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
   complex double nme, hme, j2me;
   double alpha, beta, gamma, w;
 
+  // Gaussian pair auxiliaries not changing over the integration points
+  SlaterDetAuxinv Y;
+  initSlaterDetAuxinv(Q, Qp, &Y);
+
+  // diagonal kernels are hermitian, only one point of each pair
+  // of inverse rotations has to be calculated
+  int herm = (Q == Qp && angHermitian(angpara));
+
   int i, ip;
   for (i=0; i<nang; i++) {
+    if (herm && angpara->inv[i] < i)
+      continue;
+
     copySlaterDet(Qp, Qpp);
 
     getangintegrationpoint(i, angpara, &alpha, &beta, &gamma, &w);
+    if (herm)
+      w *= angHermitianweight(angpara, i);
 
     rotateSlaterDet(Qpp, alpha, beta, gamma);
+    copySlaterDet(&Qpp[0], &Qpp[1]);
+    invertSlaterDet(&Qpp[1]);
+
+    calcSlaterDetAuxodinvparity(Q, &Qpp[0], &Y, &X[0], &X[1]);
+
     for (ip=0; ip<=1; ip++) {
-      if (ip) invertSlaterDet(Qpp);
-      
-      calcSlaterDetAuxod(Q, Qpp, X);
-      nme = X->ovlap;
-      calcHamiltonianod(Int, Q, Qpp, X, &hme);
-      calcConstraintJ2od(Q, Qpp, X, &j2me);
+      nme = X[ip].ovlap;
+      calcHamiltonianod(Int, Q, &Qpp[ip], &X[ip], &hme);
+      calcConstraintJ2od(Q, &Qpp[ip], &X[ip], &j2me);
 
       for (kp=-j; kp<=j; kp=kp+2)
 	for (k=-j; k<=j; k=k+2) {
 	  H[idxjmk(j,k,kp)] += w/2*(ip ? par : 1)*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,alpha,beta,gamma)*hme;
+	    angDstar(Dtab,i,j,k,kp)*hme;
 	  N[idxjmk(j,k,kp)] += w/2*(ip ? par : 1)*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,alpha,beta,gamma)*nme;
+	    angDstar(Dtab,i,j,k,kp)*nme;
 	  J2[idxjmk(j,k,kp)] += w/2*(ip ? par : 1)*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,alpha,beta,gamma)*j2me;
+	    angDstar(Dtab,i,j,k,kp)*j2me;
 	}
     }
   }
 
+  freeSlaterDetAuxinv(&Y);
+
+  // contributions of the inverse rotations
+  if (herm)
+    for (kp=-j; kp<=j; kp=kp+2)
+      for (k=-j; k<=kp; k=k+2) {
+	angHermitianpair(&H[idxjmk(j,k,kp)], &H[idxjmk(j,kp,k)]);
+	angHermitianpair(&N[idxjmk(j,k,kp)], &N[idxjmk(j,kp,k)]);
+	angHermitianpair(&J2[idxjmk(j,k,kp)], &J2[idxjmk(j,kp,k)]);
+      }
 }
 #endif
 
@@ -402,6 +435,7 @@ void calcprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
   int nang = angpara->n;
 
   reinitangintegration(Q, Qp, 0, 0, angpara);
+  const angDtable* Dtab = getangDtable(angpara, j+1);
 
   int k,kp;
   for (kp=-j; kp<=j; kp=kp+2)
@@ -425,6 +459,7 @@ void calcprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
 
   // processor 0 is master
   double angle[mpisize][3];
+  int iangle[mpisize];
   double weight[mpisize];
   double projpar[3];
   
@@ -449,6 +484,7 @@ void calcprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
 	}
 
       getangintegrationpoint(next, angpara, &angle[processor][0], &angle[processor][1], &angle[processor][2], &weight[processor]); 
+      iangle[processor] = next;
 
       for (int a=0; a<3; a++)
 	projpar[a] = angle[processor][a];
@@ -461,8 +497,10 @@ void calcprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
 
     } else {					// collect results from slaves
 
+      PROFILEBEGIN("mpi wait")
       MPI_Recv(hme, 2, MPI_DOUBLE_COMPLEX, 
 	       MPI_ANY_SOURCE, TAGHAMILTONIANOD, MPI_COMM_WORLD, &status);
+      PROFILEEND
       processor = status.MPI_SOURCE;
 
       MPI_Recv(nme, 2, MPI_DOUBLE_COMPLEX, 
@@ -474,7 +512,7 @@ void calcprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
       for (kp=-j; kp<=j; kp=kp+2)
 	for (k=-j; k<=j; k=k+2) {
 	  w = weight[processor]*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,angle[processor][0],angle[processor][1],angle[processor][2]);
+	    angDstar(Dtab,iangle[processor],j,k,kp);
 
 	  H[idxjmk(j,k,kp)] += w/2*(hme[0] + par* hme[1]);
 	  N[idxjmk(j,k,kp)] += w/2*(nme[0] + par* nme[1]);
@@ -515,6 +553,7 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
   int nang = angpara->n;
 
   reinitangintegration(Q, Qp, 0, 0, angpara);
+  const angDtable* Dtab = getangDtable(angpara, j+1);
 
   int k,kp;
   for (kp=-j; kp<=j; kp=kp+2)
@@ -527,6 +566,10 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
 
   double alpha, beta, gamma, w;
 
+  // Gaussian pair auxiliaries not changing over the integration points
+  SlaterDetAuxinv Y;
+  initSlaterDetAuxinv(Q, Qp, &Y);
+
   int i, ip;
   for (i=0; i<nang; i++) {
     copySlaterDet(Qp, Qpp);
@@ -534,32 +577,34 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
     getangintegrationpoint(i, angpara, &alpha, &beta, &gamma, &w);
 
     rotateSlaterDet(Qpp, alpha, beta, gamma);
+    copySlaterDet(&Qpp[0], &Qpp[1]);
+    invertSlaterDet(&Qpp[1]);
 
-    for (ip=0; ip<=1; ip++) {
-      if (ip) invertSlaterDet(Qpp);
+    calcSlaterDetAuxodinvparity(Q, &Qpp[0], &Y, &X[0], &X[1]);
 
-      calcSlaterDetAuxod(Q, Qpp, X);
-      calcgradSlaterDetAuxod(Q, Qpp, X, dX);
-      calcgradOvlapod(Q, Qpp, X, dX, dn);
-      dn->val = X->ovlap;
-      calcgradHamiltonianod(Int, Q, Qpp, X, dX, dh);
+    for (ip=0; ip<=1; ip++) {
+      calcgradSlaterDetAuxod(Q, &Qpp[ip], &X[ip], dX);
+      calcgradOvlapod(Q, &Qpp[ip], &X[ip], dX, dn);
+      dn->val = X[ip].ovlap;
+      calcgradHamiltonianod(Int, Q, &Qpp[ip], &X[ip], dX, dh);
 
       for (kp=-j; kp<=j; kp=kp+2)
 	for (k=-j; k<=j; k=k+2) {
 
 	  H[idxjmk(j,k,kp)] += w/2*(ip ? par : 1)*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,alpha,beta,gamma)*dh->val;
+	    angDstar(Dtab,i,j,k,kp)*dh->val;
 	  N[idxjmk(j,k,kp)] += w/2*(ip ? par : 1)*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,alpha,beta,gamma)*dn->val;
+	    angDstar(Dtab,i,j,k,kp)*dn->val;
 
 	  addmulttogradSlaterDet(&dH[idxjmk(j,k,kp)], dh, w/2*(ip ? par : +1)*
-				 (j+1)/(8*M_PI2)*Djmkstar(j,k,kp,alpha,beta,gamma));
+				 (j+1)/(8*M_PI2)*angDstar(Dtab,i,j,k,kp));
 	  addmulttogradSlaterDet(&dN[idxjmk(j,k,kp)], dn, w/2*(ip ? par : +1)*
-				 (j+1)/(8*M_PI2)*Djmkstar(j,k,kp,alpha,beta,gamma));
+				 (j+1)/(8*M_PI2)*angDstar(Dtab,i,j,k,kp));
 	}
     }
   }
 
+  freeSlaterDetAuxinv(&Y);
 }
 #endif
 
@@ -577,6 +622,7 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
   int nang = angpara->n;
 
   reinitangintegration(Q, Qp, 0, 0, angpara);
+  const angDtable* Dtab = getangDtable(angpara, j+1);
 
   int k,kp;
   for (kp=-j; kp<=j; kp=kp+2)
@@ -601,6 +647,7 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
 
   // processor 0 is master
   double angle[mpisize][3];
+  int iangle[mpisize];
   double weight[mpisize];
   double projpar[3];
   
@@ -624,6 +671,7 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
 	}
 
       getangintegrationpoint(next, angpara, &angle[processor][0], &angle[processor][1], &angle[processor][2], &weight[processor]); 
+      iangle[processor] = next;
       for (int k=0; k<3; k++)
 	projpar[k] = angle[processor][k];
 
@@ -639,7 +687,9 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
 
       complex double w;
 
+      PROFILEBEGIN("mpi wait")
       MPI_Recv(&dh->val, 1, MPI_DOUBLE_COMPLEX, MPI_ANY_SOURCE, TAGGRADHAMILTONIANODVAL, MPI_COMM_WORLD, &status);
+      PROFILEEND
 
       processor = status.MPI_SOURCE;
 
@@ -649,7 +699,7 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
      for (kp=-j; kp<=j; kp=kp+2)
 	for (k=-j; k<=j; k=k+2) {
 	  w = weight[processor]*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,angle[processor][0],angle[processor][1],angle[processor][2]);
+	    angDstar(Dtab,iangle[processor],j,k,kp);
 
 	  H[idxjmk(j,k,kp)] += w/2* dh->val;
 	  addmulttogradSlaterDet(&dH[idxjmk(j,k,kp)], dh, w/2);
@@ -662,7 +712,7 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
      for (kp=-j; kp<=j; kp=kp+2)
 	for (k=-j; k<=j; k=k+2) {
 	  w = weight[processor]*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,angle[processor][0],angle[processor][1],angle[processor][2]);
+	    angDstar(Dtab,iangle[processor],j,k,kp);
 
 	  H[idxjmk(j,k,kp)] += w/2*par* dh->val;
 	  addmulttogradSlaterDet(&dH[idxjmk(j,k,kp)], dh, w/2*par);
@@ -675,7 +725,7 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
      for (kp=-j; kp<=j; kp=kp+2)
 	for (k=-j; k<=j; k=k+2) {
 	  w = weight[processor]*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,angle[processor][0],angle[processor][1],angle[processor][2]);
+	    angDstar(Dtab,iangle[processor],j,k,kp);
 
 	  N[idxjmk(j,k,kp)] += w/2* dn->val;
 	  addmulttogradSlaterDet(&dN[idxjmk(j,k,kp)], dn, w/2);
@@ -688,7 +738,7 @@ void calcgradprojectedHamiltonianmatrix(const SlaterDet* Q, const SlaterDet* Qp,
      for (kp=-j; kp<=j; kp=kp+2)
 	for (k=-j; k<=j; k=k+2) {
 	  w = weight[processor]*(j+1)/(8*M_PI2)*
-	    Djmkstar(j,k,kp,angle[processor][0],angle[processor][1],angle[processor][2]);
+	    angDstar(Dtab,iangle[processor],j,k,kp);
 
 	  N[idxjmk(j,k,kp)] += w/2*par* dn->val;
 	  addmulttogradSlaterDet(&dN[idxjmk(j,k,kp)], dn, w/2*par);
@@ -718,13 +768,15 @@ void initWork(int j, int par,
   int k;
 
   Work.Qp = malloc(sizeof(SlaterDet));
-  Work.Qpp = malloc(sizeof(SlaterDet));
-  Work.X = malloc(sizeof(SlaterDetAux));
+  Work.Qpp = malloc(2*sizeof(SlaterDet));
+  Work.X = malloc(2*sizeof(SlaterDetAux));
   Work.dX = malloc(sizeof(gradSlaterDetAux));
 
   initSlaterDet(Q, Work.Qp);
-  initSlaterDet(Q, Work.Qpp);
-  initSlaterDetAux(Q, Work.X);
+  initSlaterDet(Q, &Work.Qpp[0]);
+  initSlaterDet(Q, &Work.Qpp[1]);
+  initSlaterDetAux(Q, &Work.X[0]);
+  initSlaterDetAux(Q, &Work.X[1]);
   initgradSlaterDetAux(Q, Work.dX);
 
   Work.dH = malloc((j+1)*(j+1)*sizeof(gradSlaterDet));
@@ -980,6 +1032,8 @@ void MinimizeDONLP2vapp(const Interaction* Int,
   Min.Q = malloc(sizeof(SlaterDet));
   P->ParainitSlaterDet(q, Min.Q); 
 
+  initDONLP2Cache(&Cache, P, q);
+
 #ifndef MPI
   // regular program execution or catched signal ?
   if (!setjmp(env))
@@ -990,11 +1044,14 @@ void MinimizeDONLP2vapp(const Interaction* Int,
 	  (int) FORTRAN(o8itin).optite + 11);
 
   copyxtopara(FORTRAN(o8xdat).x, Min.q);
+
+  freeDONLP2Cache(&Cache);
 }
 
 
 void FORTRAN(ef)(const double* x, double* fx)
 {
+  PROFILECOUNT("donlp2 ef", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1008,11 +1065,16 @@ void FORTRAN(ef)(const double* x, double* fx)
 
   double eintr, eproj;
 
-  calcprojectedHamiltonian(Min.Q,
-			   Min.Int,
-			   Min.j, Min.par, Min.ival,
-                           Min.projpar,
-                           &eintr, &eproj);
+  // energy known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &eproj, NULL)) {
+    calcprojectedHamiltonian(Min.Q,
+			     Min.Int,
+			     Min.j, Min.par, Min.ival,
+			     Min.projpar,
+			     &eintr, &eproj);
+
+    storeDONLP2Cache(&Cache, x, eintr, eproj, NULL);
+  }
 
   *fx = (eproj+Min.alpha*eintr);
   FORTRAN(o8cnt).icf++;
@@ -1025,6 +1087,7 @@ void FORTRAN(ef)(const double* x, double* fx)
 
 void FORTRAN(egradf)(const double* x, double* gradf)
 {
+  PROFILECOUNT("donlp2 egradf", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1038,21 +1101,27 @@ void FORTRAN(egradf)(const double* x, double* gradf)
 
   double eintr, eproj;
 
-  calcgradprojectedHamiltonian(Min.Q,
-			       Min.Int,
-			       Min.j, Min.par, Min.ival, 
-                               Min.projpar,
-			       &eintr, &eproj);
+  // gradient known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &eproj, gradf)) {
+    calcgradprojectedHamiltonian(Min.Q,
+				 Min.Int,
+				 Min.j, Min.par, Min.ival, 
+				 Min.projpar,
+				 &eintr, &eproj);
 
-  // add gradient from intrinsic energy
+    // add gradient from intrinsic energy
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
-  calcgradHamiltonian(Min.Int, Min.Q, Work.X, Work.dX, Work.dH);
+    calcSlaterDetAux(Min.Q, Work.X);
+    calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
+    calcgradHamiltonian(Min.Int, Min.Q, Work.X, Work.dX, Work.dH);
 
-  addmulttogradSlaterDet(Work.dhproj, Work.dH, Min.alpha);
+    addmulttogradSlaterDet(Work.dhproj, Work.dH, Min.alpha);
+
+    Min.P->ParaprojectgradSlaterDet(Min.q, Work.dhproj, gradf);
+
+    storeDONLP2Cache(&Cache, x, eintr, eproj, gradf);
+  }
 
-  Min.P->ParaprojectgradSlaterDet(Min.q, Work.dhproj, gradf);
   FORTRAN(o8cnt).icgf++;
   fprintf(stderr, "grad %3d: \tE = %8.3f MeV, Eproj = %8.3f MeV, Eintr = %8.3f MeV\n", 
 	  FORTRAN(o8cnt).icgf, hbc*(eproj+Min.alpha*eintr), hbc*eproj, hbc*eintr);
@@ -1095,21 +1164,16 @@ void FORTRAN(egradg)(int* i, const double* x, double* gradgi)
 
 void FORTRAN(eh)(int* i, const double* x, double* hxi)
 {
+  PROFILECOUNT("donlp2 eh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
 
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
-
-  if (*i > 1) {
-    // nail to center-of-mass
-    moveboostSlaterDet(Min.Q, Work.X);
-  }
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, *i > 1, 0);
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  Min.Const[*i-1].me(Min.Q, Work.X, hxi);
+  Min.Const[*i-1].me(Cache.Q[c], Cache.X[c], hxi);
 
   fprintf(stderr, "\t\t\tme   %4s = %8.3f\n", 
   	  Min.Const[*i-1].label, Min.Const[*i-1].output(*hxi));
@@ -1120,22 +1184,16 @@ void FORTRAN(eh)(int* i, const double* x, double* hxi)
 
 void FORTRAN(egradh)(int* i, const double* x, double* gradhi)
 {
+  PROFILECOUNT("donlp2 egradh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
-
-  if (*i > 1) {
-    // nail to center-of-mass
-    moveboostSlaterDet(Min.Q, Work.X);
-  }
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, *i > 1, 1);
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
   zerogradSlaterDet(Work.dH);
-  Min.Const[*i-1].gradme(Min.Q, Work.X, Work.dX, Work.dH);
+  Min.Const[*i-1].gradme(Cache.Q[c], Cache.X[c], Cache.dX[c], Work.dH);
 
   Min.P->ParaprojectgradSlaterDet(Min.q, Work.dH, gradhi);
   fprintf(stderr, "\t\t\tgrad %4s = %8.3f\n", 
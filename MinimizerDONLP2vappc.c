@@ -35,6 +35,7 @@
 #include "fmd/ConstraintJ2.h"
 #include "fmd/Projection.h"
 #include "numerics/donlp2.h"
+#include "misc/profile.h"
 
 #include "fmd/Hamiltonian.h"
 #include "fmd/gradHamiltonian.h"
@@ -43,6 +44,7 @@
 #include "fmd/gradCenterofMass.h"
 
 #include "MinimizerDONLP2vapp.h"
+#include "DONLP2Cache.h"
 
 #include "numerics/fortranc.h"
 #include "numerics/wignerd.h"
@@ -133,6 +135,11 @@ static struct {
   gradSlaterDet* dhproj;
   gradSlaterDet* dnproj;
 } Work;
+
+
+// DONLP2 evaluates ef and egradf, and eh and egradh
+// for all constraints repeatedly at the same x
+static DONLP2Cache Cache;
   
 
 #define M_2PI (2*M_PI)
@@ -1013,6 +1020,8 @@ void MinimizeDONLP2vapp(const Interaction* Int,
   Min.Q = malloc(sizeof(SlaterDet));
   P->ParainitSlaterDet(q, Min.Q); 
 
+  initDONLP2Cache(&Cache, P, q);
+
 #ifndef MPI
   // regular program execution or catched signal ?
   if (!setjmp(env))
@@ -1023,11 +1032,14 @@ void MinimizeDONLP2vapp(const Interaction* Int,
 	  (int) FORTRAN(o8itin).optite + 11);
 
   copyxtopara(FORTRAN(o8xdat).x, Min.q);
+
+  freeDONLP2Cache(&Cache);
 }
 
 
 void FORTRAN(ef)(const double* x, double* fx)
 {
+  PROFILECOUNT("donlp2 ef", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1041,11 +1053,16 @@ void FORTRAN(ef)(const double* x, double* fx)
 
   double eintr, eproj;
 
-  calcprojectedHamiltonian(Min.Q,
-			   Min.Int,
-			   Min.j, Min.par, Min.ival,
-                           Min.projpar,
-                           &eintr, &eproj);
+  // energy known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &eproj, NULL)) {
+    calcprojectedHamiltonian(Min.Q,
+			     Min.Int,
+			     Min.j, Min.par, Min.ival,
+			     Min.projpar,
+			     &eintr, &eproj);
+
+    storeDONLP2Cache(&Cache, x, eintr, eproj, NULL);
+  }
 
   *fx = (eproj+Min.alpha*eintr);
   FORTRAN(o8cnt).icf++;
@@ -1058,6 +1075,7 @@ void FORTRAN(ef)(const double* x, double* fx)
 
 void FORTRAN(egradf)(const double* x, double* gradf)
 {
+  PROFILECOUNT("donlp2 egradf", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
@@ -1071,15 +1089,21 @@ void FORTRAN(egradf)(const double* x, double* gradf)
 
   double eintr, eproj;
 
-  calcgradprojectedHamiltonian(Min.Q,
-			       Min.Int,
-			       Min.j, Min.par, Min.ival, 
-                               Min.projpar,
-			       &eintr, &eproj);
+  // gradient known from preceding evaluation ?
+  if (!lookupDONLP2Cache(&Cache, x, &eintr, &eproj, gradf)) {
+    calcgradprojectedHamiltonian(Min.Q,
+				 Min.Int,
+				 Min.j, Min.par, Min.ival, 
+				 Min.projpar,
+				 &eintr, &eproj);
 
-  addmulttogradSlaterDet(Work.dhproj, Work.dhintr, Min.alpha);
+    addmulttogradSlaterDet(Work.dhproj, Work.dhintr, Min.alpha);
+
+    Min.P->ParaprojectgradSlaterDet(Min.q, Work.dhproj, gradf);
+
+    storeDONLP2Cache(&Cache, x, eintr, eproj, gradf);
+  }
 
-  Min.P->ParaprojectgradSlaterDet(Min.q, Work.dhproj, gradf);
   FORTRAN(o8cnt).icgf++;
   fprintf(stderr, "grad %3d: \tE = %8.3f MeV, Eproj = %8.3f MeV, Eintr = %8.3f MeV\n", 
 	  FORTRAN(o8cnt).icgf, hbc*(eproj+Min.alpha*eintr), hbc*eproj, hbc*eintr);
@@ -1122,21 +1146,16 @@ void FORTRAN(egradg)(int* i, const double* x, double* gradgi)
 
 void FORTRAN(eh)(int* i, const double* x, double* hxi)
 {
+  PROFILECOUNT("donlp2 eh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
 
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
-
-  if (*i > 1) {
-    // nail to center-of-mass
-    moveboostSlaterDet(Min.Q, Work.X);
-  }
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, *i > 1, 0);
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  Min.Const[*i-1].me(Min.Q, Work.X, hxi);
+  Min.Const[*i-1].me(Cache.Q[c], Cache.X[c], hxi);
 
   fprintf(stderr, "\t\t\tme   %4s = %8.3f\n", 
   	  Min.Const[*i-1].label, Min.Const[*i-1].output(*hxi));
@@ -1147,22 +1166,16 @@ void FORTRAN(eh)(int* i, const double* x, double* hxi)
 
 void FORTRAN(egradh)(int* i, const double* x, double* gradhi)
 {
+  PROFILECOUNT("donlp2 egradh", 1);
 #ifndef MPI
   if (sigterminate)
     longjmp(env, 1);
 #endif
   copyxtopara(x, Min.q);
-  Min.P->ParatoSlaterDet(Min.q, Min.Q);
-
-  if (*i > 1) {
-    // nail to center-of-mass
-    moveboostSlaterDet(Min.Q, Work.X);
-  }
+  int c = constraintauxDONLP2Cache(&Cache, Min.P, Min.q, x, *i > 1, 1);
 
-  calcSlaterDetAux(Min.Q, Work.X);
-  calcgradSlaterDetAux(Min.Q, Work.X, Work.dX);
   zerogradSlaterDet(Work.dH);
-  Min.Const[*i-1].gradme(Min.Q, Work.X, Work.dX, Work.dH);
+  Min.Const[*i-1].gradme(Cache.Q[c], Cache.X[c], Cache.dX[c], Work.dH);
 
   Min.P->ParaprojectgradSlaterDet(Min.q, Work.dH, gradhi);
   fprintf(stderr, "\t\t\tgrad %4s = %8.3f\n", 
@@ -0,0 +1,230 @@
+/**
+
+  \file benchkernels.c
+
+  time the core kernels for a SlaterDet and an interaction,
+  results and checksums are written as JSON to stdout
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include <time.h>
+
+#include "fmd/SlaterDet.h"
+#include "fmd/gradSlaterDet.h"
+#include "fmd/Interaction.h"
+#include "fmd/Potential.h"
+#include "fmd/gradPotential.h"
+#include "fmd/Projection.h"
+#include "fmd/Symmetry.h"
+#include "fmd/ProjectedObservables.h"
+
+#include "misc/utils.h"
+
+
+#define SQR(x) ((x)*(x))
+
+typedef struct {
+  const Interaction* Int;
+  const SlaterDet* Q;
+  const SlaterDet* Qp;
+  SlaterDetAux* X;
+  gradSlaterDetAux* dX;
+  gradSlaterDet* dv;
+  const Projection* P;
+  void* mbme;
+} benchpara;
+
+
+static double seconds(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec+1e-9*t.tv_nsec;
+}
+
+
+static double benchSlaterDetAux(benchpara* b)
+{
+  int A = b->Q->A;
+  int k;
+
+  calcSlaterDetAux(b->Q, b->X);
+
+  // calcSlaterDetAux does not calculate the overlap, use trace of inverse
+  double sum = 0.0;
+  for (k=0; k<A; k++)
+    sum += creal(b->X->o[k+k*A]);
+  return sum;
+}
+
+
+static double benchSlaterDetAuxod(benchpara* b)
+{
+  calcSlaterDetAuxod(b->Q, b->Qp, b->X);
+  return cabs(b->X->ovlap);
+}
+
+
+static double benchPotential(benchpara* b)
+{
+  double v[b->Int->n];
+  int i;
+
+  calcSlaterDetAux(b->Q, b->X);
+  calcPotential(b->Int, b->Q, b->X, v);
+
+  double sum = 0.0;
+  for (i=0; i<b->Int->n; i++)
+    sum += v[i];
+  return sum;
+}
+
+
+static double benchgradPotential(benchpara* b)
+{
+  int i, k;
+
+  calcSlaterDetAux(b->Q, b->X);
+  calcgradSlaterDetAux(b->Q, b->X, b->dX);
+  b->dv->val = 0.0;
+  zerogradSlaterDet(b->dv);
+  calcgradPotential(b->Int, b->Q, b->X, b->dX, b->dv);
+
+  double sum = creal(b->dv->val);
+  for (i=0; i<b->Q->ngauss; i++) {
+    const gradGaussian* g = &b->dv->gradval[i];
+    sum += cabs(g->chi[0])+cabs(g->chi[1])+cabs(g->a);
+    for (k=0; k<3; k++)
+      sum += cabs(g->b[k]);
+  }
+  return sum;
+}
+
+
+static double benchprojectedMBME(benchpara* b)
+{
+  const Projection* P = b->P;
+  int rank = OpObservables.rank;
+  int size = OpObservables.size;
+  complex double (**val)[(rank+1)*size] = b->mbme;
+  int p, j, k, c;
+
+  calcprojectedMBME(P, &OpObservables, b->Q, b->Q, 0, 0, b->mbme);
+
+  double sum = 0.0;
+  for (p=0; p<=1; p++)
+    for (j=P->odd; j<P->jmax; j=j+2)
+      for (k=0; k<SQR(j+1); k++)
+	for (c=0; c<(rank+1)*OpObservables.dim; c++)
+	  sum += cabs(val[idxpij(P->jmax,p,j)][k][c]);
+  return sum;
+}
+
+
+// repeat kernel until mintime has passed
+static void timekernel(const char* name, const char* projpar,
+		       double (*kernel)(benchpara*), benchpara* b,
+		       double mintime, int first)
+{
+  double checksum = kernel(b);
+  int calls = 0;
+  double start = seconds(), elapsed;
+
+  do {
+    kernel(b);
+    calls++;
+    elapsed = seconds()-start;
+  } while (elapsed < mintime);
+
+  fprintf(stdout, "%s    {\"kernel\": \"%s\", ", first ? "" : ",\n", name);
+  if (projpar)
+    fprintf(stdout, "\"projection\": \"%s\", ", projpar);
+  fprintf(stdout, "\"calls\": %d, \"seconds\": %.6f, \"usecpercall\": %.3f, "
+	  "\"checksum\": %.12e}",
+	  calls, elapsed, 1e6*elapsed/calls, checksum);
+  fflush(stdout);
+}
+
+
+int main(int argc, char* argv[])
+{
+  int c;
+  double mintime = 1.0;
+
+  if (argc < 3) {
+    fprintf(stderr, "\nusage: %s [OPTIONS] interaction slaterdetfile [PROJPARA ...]\n"
+	    "\n   -t TIME         time every kernel for at least TIME seconds (default %g)"
+	    "\n   -j THREADS      number of threads\n",
+	    argv[0], mintime);
+    exit(-1);
+  }
+
+  while ((c = getopt(argc, argv, "t:j:")) != -1)
+    switch (c) {
+    case 't':
+      mintime = atof(optarg);
+      break;
+    case 'j':
+      setnumthreads(atoi(optarg));
+      break;
+    }
+
+  char* interactionfile = argv[optind];
+  char* slaterdetfile = argv[optind+1];
+
+  Interaction Int;
+  if (readInteractionfromFile(&Int, interactionfile))
+    exit(-1);
+  Int.cm = 1;
+
+  SlaterDet Q, Qp;
+  if (readSlaterDetfromFile(&Q, slaterdetfile))
+    exit(-1);
+
+  SlaterDetAux X;
+  initSlaterDetAux(&Q, &X);
+  normalizeSlaterDet(&Q, &X);
+
+  // off-diagonal kernels use a rotated copy
+  initSlaterDet(&Q, &Qp);
+  copySlaterDet(&Q, &Qp);
+  rotateSlaterDet(&Qp, 0.3, 0.7, 1.1);
+
+  gradSlaterDetAux dX;
+  gradSlaterDet dv;
+  initgradSlaterDetAux(&Q, &dX);
+  initgradSlaterDet(&Q, &dv);
+
+  initOpObservables(&Int);
+
+  benchpara b = { &Int, &Q, &Qp, &X, &dX, &dv, NULL, NULL };
+
+  fprintf(stdout, "{\n  \"interaction\": \"%s\",\n  \"slaterdet\": \"%s\",\n"
+	  "  \"A\": %d,\n  \"ngauss\": %d,\n  \"kernels\": [\n",
+	  interactionfile, slaterdetfile, Q.A, Q.ngauss);
+
+  timekernel("calcSlaterDetAux", NULL, benchSlaterDetAux, &b, mintime, 1);
+  timekernel("calcSlaterDetAuxod", NULL, benchSlaterDetAuxod, &b, mintime, 0);
+  timekernel("calcPotential", NULL, benchPotential, &b, mintime, 0);
+  timekernel("calcgradPotential", NULL, benchgradPotential, &b, mintime, 0);
+
+  Projection P;
+  int i;
+  for (i=optind+2; i<argc; i++) {
+    initProjection(&P, Q.A % 2, argv[i]);
+    b.P = &P;
+    b.mbme = initprojectedMBME(&P, &OpObservables);
+    timekernel("calcprojectedMBME", argv[i], benchprojectedMBME, &b, mintime, 0);
+    freeprojectedMBME(&P, b.mbme);
+  }
+
+  fprintf(stdout, "\n  ]\n}\n");
+
+  return 0;
+}
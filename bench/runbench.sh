@@ -0,0 +1,61 @@
+#!/bin/sh
+#
+# run the kernel benchmarks and a short VAP minimization,
+# write results as JSON to stdout
+#
+# BENCHTIME       minimal time per kernel in seconds (default 1)
+# BENCHVAPSTEPS   number of DONLP2 steps in VAP benchmark (default 5)
+
+SRC=$(cd ..; pwd)
+BENCHTIME=${BENCHTIME:-1}
+BENCHVAPSTEPS=${BENCHVAPSTEPS:-5}
+
+VOLKOV=$SRC/examples/VolkovV1-M0.60.int
+AV18=$SRC/AV18-UsrgD2000f-v11ls-2.0.int
+
+tmp=$(mktemp -d)
+trap 'rm -rf $tmp' EXIT
+
+# examples/C12.fmd has DOS line endings and blank lines inside the
+# parameter block, the parser wants neither
+sed -e 's/[ \t\r]*$//' -e '/^$/d' $SRC/examples/C12.fmd > $tmp/C12.fmd
+
+now() {
+  date +%s.%N
+}
+
+echo "{"
+echo "  \"git\": \"$(cd $SRC; git show -s --pretty=format:%h 2>/dev/null)\","
+echo "  \"compiler\": \"$(${CC:-gcc} --version | head -1)\","
+echo "  \"host\": \"$(uname -n)\","
+echo "  \"runs\": ["
+
+sep=""
+run() {
+  if $SRC/bench/benchkernels -t $BENCHTIME "$@" > $tmp/run.json; then
+    printf "$sep"
+    sed 's/^/    /' $tmp/run.json
+    sep=",\n"
+  else
+    echo "benchkernels $* failed" >&2
+  fi
+}
+
+run $VOLKOV $SRC/He4.fmd ang-4-4
+run $VOLKOV $SRC/B8-QD20.fmd ang-6-6 ang-zcw-5
+run $AV18 $SRC/B8-QD20.fmd ang-6-6
+run $VOLKOV $tmp/C12.fmd ang-4-4
+
+echo "  ],"
+
+# DONLP2 VAP minimization steps, working on a copy of the parameters
+mkdir $tmp/vapp
+cp $SRC/B8-QD20.fmd $VOLKOV $tmp/vapp
+start=$(now)
+(cd $tmp/vapp; $SRC/minenergyconvapp -m $BENCHVAPSTEPS ang-4-4 \
+  VolkovV1-M0.60.int B8-QD20.fmd > vapp.out 2>&1)
+end=$(now)
+eproj=$(sed -n 's/^final:.*Eproj = *\([-0-9.]*\).*/\1/p' $tmp/vapp/vapp.out)
+
+echo "  \"vapp\": {\"projection\": \"ang-4-4\", \"steps\": $BENCHVAPSTEPS, \"seconds\": $(awk "BEGIN { printf \"%.3f\", $end-$start }"), \"checksum\": ${eproj:-null}}"
+echo "}"
@@ -21,6 +21,7 @@
 #include "fmd/Projection.h"
 #include "fmd/Symmetry.h"
 #include "fmd/ProjectedObservables.h"
+#include "fmd/MEDatabase.h"
 
 #include "misc/utils.h"
 #include "misc/physics.h"
@@ -72,13 +73,18 @@ int main(int argc, char* argv[])
   if (argc < 4) {
     fprintf(stderr, "\nusage: %s [OPTIONS] PROJPAR INTERACTION NUCSFILE"
 	    "\n   -h                hermitize matrix elements"
+	    "\n   -H                calculate only half of the matrix elements, use hermiticity"
+	    "\n                     diagonal ones on half of the angular grid if it is closed"
+	    "\n                     under inversion (ang-N-M with odd M) and without -cm-"
 	    "\n   -A                show really all eigenstates"
 	    "\n   -s                write Eigenstates into file"
             "\n   -l                write Energy Level file"
             "\n   -n NORM           set minimal norm for K-mixing eigenstates"
 	    "\n   -t THRESH         set threshold for K-mixing SVD"
             "\n   -N NORM           set minimal norm for Multiconfig eigenstates"
-	    "\n   -T THRESH         set threshold for Multiconfig SVD\n", 
+	    "\n   -T THRESH         set threshold for Multiconfig SVD"
+	    "\n   -j THREADS        number of threads for projection"
+	    "\n   -d                use matrix element database\n", 
 	    argv[0]);
     return -1;
   }
@@ -95,11 +101,14 @@ int main(int argc, char* argv[])
   /* manage command-line options */
 
   char c;
-  while ((c = getopt(argc, argv, "hAln:t:N:T:")) != -1)
+  while ((c = getopt(argc, argv, "hHAln:t:N:T:j:d")) != -1)
     switch (c) {
     case 'h':
       hermit=1;
       break;
+    case 'H':
+      useHermiticity(1);
+      break;
     case 'A':
       all=1;
       break;
@@ -118,6 +127,12 @@ int main(int argc, char* argv[])
     case 'T':
       threshmulti = atof(optarg);
       break;
+    case 'j':
+      setnumthreads(atoi(optarg));
+      break;
+    case 'd':
+      useMEDatabase(1);
+      break;
     }
 
   char* projpar = argv[optind];
@@ -170,9 +185,11 @@ int main(int argc, char* argv[])
     for (a=0; a<n; a++)
       obsme[a+b*n] = initprojectedMBME(&P, &OpObservables);
 
+  int herm = usingHermiticity(&OpObservables);
+
   // read or calculate matrix elements
   for (b=0; b<n; b++)
-    for (a=0; a<n; a++)
+    for (a=0; a<(herm ? b+1 : n); a++)
       if (readprojectedMBMEfromFile(mbfile[a], mbfile[b], &P, &OpObservables, 
 				    S[a], S[b], obsme[a+b*n])) {
 #ifdef MPI
@@ -186,6 +203,12 @@ int main(int argc, char* argv[])
 				 &P, &OpObservables, S[a], S[b], obsme[a+b*n]);
       }
 
+  // remaining matrix elements by hermiticity
+  if (herm)
+    for (b=0; b<n; b++)
+      for (a=b+1; a<n; a++)
+	adjointprojectedMBME(&P, &OpObservables, obsme[b+a*n], obsme[a+b*n]);
+
   // scale matrix elements
   if (Int.mescaling) {
     fprintf(stderr, "... scaling matrix elements\n");
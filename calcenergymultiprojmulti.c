@@ -71,13 +71,17 @@ int main(int argc, char* argv[])
 
   if (argc < 4) {
     fprintf(stderr, "\nusage: %s [OPTIONS] PROJPAR INTERACTION NUCSFILE"
+	    "\n   -H                calculate only half of the matrix elements, use hermiticity"
+	    "\n                     diagonal ones on half of the angular grid if it is closed"
+	    "\n                     under inversion (ang-N-M with odd M) and without -cm-"
 	    "\n   -A                show really all eigenstates"
 	    "\n   -s                write Eigenstates into file"
             "\n   -l                write Energy Level file"
             "\n   -n NORM           set minimal norm for K-mixing eigenstates"
 	    "\n   -t THRESH         set threshold for K-mixing SVD"
             "\n   -N NORM           set minimal norm for Multiconfig eigenstates"
-	    "\n   -T THRESH         set threshold for Multiconfig SVD\n", 
+	    "\n   -T THRESH         set threshold for Multiconfig SVD"
+	    "\n   -j THREADS        number of threads for projection\n", 
 	    argv[0]);
     return -1;
   }
@@ -93,8 +97,11 @@ int main(int argc, char* argv[])
   /* manage command-line options */
 
   char c;
-  while ((c = getopt(argc, argv, "Aln:t:N:T:")) != -1)
+  while ((c = getopt(argc, argv, "HAln:t:N:T:j:")) != -1)
     switch (c) {
+    case 'H':
+      useHermiticity(1);
+      break;
     case 'A':
       all=1;
       break;
@@ -113,6 +120,9 @@ int main(int argc, char* argv[])
     case 'T':
       threshmulti=atof(optarg);
       break;
+    case 'j':
+      setnumthreads(atoi(optarg));
+      break;
     }
 
   char* projpar = argv[optind];
@@ -173,9 +183,11 @@ int main(int argc, char* argv[])
     for (a=0; a<n; a++)
       obsme[a+b*n] = initprojectedMultiMBME(&P, &OpObservables, &Q[a], &Q[b]);
 
+  int herm = usingHermiticity(&OpObservables);
+
   // read or calculate matrix elements
   for (b=0; b<n; b++)
-    for (a=0; a<n; a++)
+    for (a=0; a<(herm ? b+1 : n); a++)
       if (readprojectedMultiMBMEfromFile(mbfile[a], mbfile[b], &Q[a], &Q[b],
 					 &P, &OpObservables, obsme[a+b*n])) {
 #ifdef MPI
@@ -187,6 +199,16 @@ int main(int argc, char* argv[])
 				      &P, &OpObservables, obsme[a+b*n]);
       }
 
+  // remaining matrix elements by hermiticity
+  int IA, IB;
+  if (herm)
+    for (b=0; b<n; b++)
+      for (a=b+1; a<n; a++)
+	for (IB=0; IB<Q[b].N; IB++)
+	  for (IA=0; IA<Q[a].N; IA++)
+	    adjointprojectedMBME(&P, &OpObservables, 
+				 obsme[b+a*n][IB+IA*Q[b].N], obsme[a+b*n][IA+IB*Q[a].N]);
+
   // scale matrix elements
   if (Int.mescaling) {
     fprintf(stderr, "scaling not yet implemented, aborting\n");
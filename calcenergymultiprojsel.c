@@ -25,6 +25,7 @@
 #include "fmd/Projection.h"
 #include "fmd/Symmetry.h"
 #include "fmd/ProjectedObservables.h"
+#include "fmd/MEDatabase.h"
 
 #include "misc/utils.h"
 #include "misc/physics.h"
@@ -362,7 +363,8 @@ int main(int argc, char* argv[])
 	    "\n   -i ISEL        select for #ISEL"
 	    "\n   -o OVLTHRESH   overlap threshold"
 	    "\n   -e ENTHRESH    energy threshold [MeV]"
-	    "\n   -t THRESH      threshold for SVD\n", argv[0]);
+	    "\n   -t THRESH      threshold for SVD"
+	    "\n   -d             use matrix element database\n", argv[0]);
     exit(-1);
   }
 
@@ -383,7 +385,7 @@ int main(int argc, char* argv[])
   /* manage command-line options */
 
   char c;
-  while ((c = getopt(argc, argv, "f:t:n:j:p:i:o:e:")) != -1)
+  while ((c = getopt(argc, argv, "f:t:n:j:p:i:o:e:d")) != -1)
     switch (c) {
     case 'f':
       fixnucsfile = optarg;
@@ -409,6 +411,9 @@ int main(int argc, char* argv[])
     case 'e':
       enthresh = atof(optarg)/hbc;
       break;
+    case 'd':
+      useMEDatabase(1);
+      break;
     }
 
   char* projpar = argv[optind];
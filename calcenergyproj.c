@@ -73,12 +73,16 @@ int main(int argc, char* argv[])
   if (argc < 4) {
     fprintf(stderr, "\nusage: %s [OPTIONS] PROJPARA INTERACTION [SYMMETRY:]MBSTATE"
 	    "\n   -h                hermitize matrix elements"
+	    "\n   -H                use hermiticity, only half of the angular grid"
+	    "\n                     if it is closed under inversion (ang-N-M with odd M)"
+	    "\n                     and without -cm- integration"
 	    "\n   -K K              use only K projection"
             "\n   -n NORM           set minimal norm for K-mixing eigenstates"
 	    "\n   -t THRESH         set threshold for K-mixing SVD"
 	    "\n   -A                show really all eigenstates"
             "\n   -l                write energy level file"
-	    "\n   -s                write Eigenstates into file\n",
+	    "\n   -s                write Eigenstates into file"
+	    "\n   -j THREADS        number of threads for projection\n",
 	    filepart(argv[0]));
     cleanup(-1);
   }
@@ -95,11 +99,14 @@ int main(int argc, char* argv[])
   /* manage command-line options */
 
   char c;
-  while ((c = getopt(argc, argv, "hK:Alst:n:")) != -1)
+  while ((c = getopt(argc, argv, "hHK:Alst:n:j:")) != -1)
     switch (c) {
     case 'h':
       hermit=1;
       break;
+    case 'H':
+      useHermiticity(1);
+      break;
     case 'K':
       Ksel=1;
       K = atoi(optarg);
@@ -119,6 +126,9 @@ int main(int argc, char* argv[])
     case 't':
       threshkmix = atof(optarg);
       break;
+    case 'j':
+      setnumthreads(atoi(optarg));
+      break;
     }
 
   char* projpar = argv[optind];
@@ -82,9 +82,13 @@ int main(int argc, char* argv[])
   if (argc < 4) {
     fprintf(stderr, "\nusage: %s [OPTIONS] PROJPARA INTERACTION [IDX:]MBSTATE"
 	    "\n   -h                hermitize matrix elements"
+	    "\n   -H                calculate only half of the matrix elements, use hermiticity"
+	    "\n                     diagonal ones on half of the angular grid if it is closed"
+	    "\n                     under inversion (ang-N-M with odd M) and without -cm-"
 	    "\n   -K K              use only K projection"
 	    "\n   -A                show really all eigenstates"
-	    "\n   -s                write Eigenstates into file\n",
+	    "\n   -s                write Eigenstates into file"
+	    "\n   -j THREADS        number of threads for projection\n",
 	    filepart(argv[0]));
     cleanup(-1);
   }
@@ -100,11 +104,14 @@ int main(int argc, char* argv[])
   /* manage command-line options */
 
   char c;
-  while ((c = getopt(argc, argv, "hK:Ast:")) != -1)
+  while ((c = getopt(argc, argv, "hHK:Ast:j:")) != -1)
     switch (c) {
     case 'h':
       hermit=1;
       break;
+    case 'H':
+      useHermiticity(1);
+      break;
     case 'K':
       Ksel=1;
       K = atoi(optarg);
@@ -118,6 +125,9 @@ int main(int argc, char* argv[])
     case 't':
       threshkmix = atof(optarg);
       break;
+    case 'j':
+      setnumthreads(atoi(optarg));
+      break;
     }
 
   char* projpar = argv[optind];
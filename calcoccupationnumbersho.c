@@ -106,7 +106,7 @@ int main(int argc, char* argv[])
 
   int i;
   int ixi, xi, N, n, l, twoj, twom, orbit, idx;
-  double nshell, norbit[HONMAX+1];
+  double nshell, norbit[nmax+1];
 
   for (N=0; N<=nmax; N++) {
 
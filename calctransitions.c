@@ -19,6 +19,7 @@
 #include "fmd/SlaterDet.h"
 #include "fmd/ElectroMagneticMultipole.h"
 #include "fmd/Projection.h"
+#include "fmd/MEDatabase.h"
 
 #include "numerics/zcw.h"
 #include "misc/utils.h"
@@ -34,7 +35,8 @@ int main(int argc, char* argv[])
 
   if (argc < 2) {
     fprintf(stderr, "\nusage: %s [OPTIONS] mcstate"
-	    "\n   -A             show all eigenstates\n", argv[0]);
+	    "\n   -A             show all eigenstates"
+	    "\n   -d             use matrix element database\n", argv[0]);
     exit(-1);
   }
 
@@ -45,11 +47,14 @@ int main(int argc, char* argv[])
 
   /* manage command-line options */
 
-  while ((c = getopt(argc, argv, "A")) != -1)
+  while ((c = getopt(argc, argv, "Ad")) != -1)
     switch (c) {
     case 'A':
       all=1;
       break;
+    case 'd':
+      useMEDatabase(1);
+      break;
     }
 
   char* mcstatefile = argv[optind];
@@ -36,25 +36,35 @@ static void ob_angmom(void* par,
 }
 
 
-static void tb_angmom(void* par,
-		      const Gaussian* G1, const Gaussian* G2, 
-		      const Gaussian* G3, const Gaussian* G4, 
-		      const GaussianAux* X13, const GaussianAux* X24, 
-		      complex double ang[3])
-{	
-  complex double l2, s2, ls;
+// two-body parts are separable: l2, s2 and j2 are 2 L.L, 2 S.S and 2 J.J
+// with the one-body operators L, S and J
+static void sep_lsj(const void* par,
+		    const Gaussian* G1, const Gaussian* G2, 
+		    const GaussianAux* X, complex double lsj[9])
+{
+  complex double l, s;
+  int i;
 
-  l2 = cvec3mult(X13->rhoxpi, X24->rhoxpi)* X13->Q* X24->Q;
-  s2 = 0.25*cvec3mult(X13->sig, X24->sig)* X13->T* X24->T* X13->R* X24->R;
-  ls = 0.25*(cvec3mult(X13->rhoxpi, X24->sig)*X13->S+
-	     cvec3mult(X13->sig, X24->rhoxpi)*X24->S)*
-       X13->T* X24->T* X13->R* X24->R;
+  for (i=0; i<3; i++) {
+    l = X->T* X->rhoxpi[i]*X->S* X->R;
+    s = X->T* 0.5*X->sig[i]* X->R;
 
-  ang[0] += 2*l2;
-  ang[1] += 2*s2;
-  ang[2] += 2*(l2 + s2 + 2*ls);
+    lsj[0+i] += l;
+    lsj[3+i] += s;
+    lsj[6+i] += l + s;
+  }
 }
 
+static const SeparableTerm sep_angmom[9] = {
+  {0, 0, 0, 2.0}, {0, 1, 1, 2.0}, {0, 2, 2, 2.0},
+  {1, 3, 3, 2.0}, {1, 4, 4, 2.0}, {1, 5, 5, 2.0},
+  {2, 6, 6, 2.0}, {2, 7, 7, 2.0}, {2, 8, 8, 2.0}
+};
+
+static const SeparableTerm sep_j2[3] = {
+  {0, 6, 6, 2.0}, {1, 7, 7, 2.0}, {2, 8, 8, 2.0}
+};
+
 static void ob_l(void* par,
 		 const Gaussian* G1, const Gaussian* G2, 
 		 const GaussianAux* X, complex double l[3])
@@ -105,24 +115,14 @@ static void ob_j2(void* par,
 }
 
 
-static void tb_j2(void* par,
-		  const Gaussian* G1, const Gaussian* G2, 
-		  const Gaussian* G3, const Gaussian* G4, 
-		  const GaussianAux* X13, const GaussianAux* X24, 
-		  complex double j2[3])
-{	
-  complex double l2, s2, ls;
-  int i;
-
-  for (i=0; i<3; i++) {
-    l2 = X13->rhoxpi[i]* X24->rhoxpi[i]* X13->Q* X24->Q;
-    s2 = 0.25*X13->sig[i]* X24->sig[i]* X13->T* X24->T* X13->R* X24->R;
-    ls = 0.25*(X13->rhoxpi[i]* X24->sig[i]* X13->S+
-	       X13->sig[i]* X24->rhoxpi[i]* X24->S)*
-      X13->T* X24->T* X13->R* X24->R;
+void initAngularMomentaoperators(OneBodyOperator* ob, SeparableOperator* tb)
+{
+  OneBodyOperator op_ob_angmom = {dim: 3, opt: 1, par: NULL, me: ob_angmom};
+  SeparableOperator op_tb_angmom = {dim: 3, nob: 9, opt: OPTTPROP, par: NULL, 
+				    me: sep_lsj, nterms: 9, terms: sep_angmom};
 
-    j2[i] += 2*(l2 + s2 + 2*ls);
-  }
+  *ob = op_ob_angmom;
+  *tb = op_tb_angmom;
 }
 
 
@@ -131,11 +131,12 @@ void calcAngularMomenta(const SlaterDet* Q, const SlaterDetAux* X,
 {
   double angone[3], angtwo[3];
   OneBodyOperator op_ob_angmom = {dim: 3, opt: 1, par: NULL, me: ob_angmom};
-  TwoBodyOperator op_tb_angmom = {dim: 3, opt: 1, par: NULL, me: tb_angmom};
+  SeparableOperator op_tb_angmom = {dim: 3, nob: 9, opt: OPTTPROP, par: NULL, 
+				    me: sep_lsj, nterms: 9, terms: sep_angmom};
 
 
   calcSlaterDetOBME(Q, X, &op_ob_angmom, angone);
-  calcSlaterDetTBME(Q, X, &op_tb_angmom, angtwo);
+  calcSlaterDetSepME(Q, X, &op_tb_angmom, angtwo);
 
   *l2 = angone[0] + angtwo[0];
   *s2 = angone[1] + angtwo[1];
@@ -150,11 +151,12 @@ void calcAngularMomentaod(const SlaterDet* Q, const SlaterDet* Qp,
 {
   complex double angone[3], angtwo[3];
   OneBodyOperator op_ob_angmom = {dim: 3, opt: 1, par: NULL, me: ob_angmom};
-  TwoBodyOperator op_tb_angmom = {dim: 3, opt: 1, par: NULL, me: tb_angmom};
+  SeparableOperator op_tb_angmom = {dim: 3, nob: 9, opt: OPTTPROP, par: NULL, 
+				    me: sep_lsj, nterms: 9, terms: sep_angmom};
 
 
   calcSlaterDetOBMEod(Q, Qp, X, &op_ob_angmom, angone);
-  calcSlaterDetTBMEod(Q, Qp, X, &op_tb_angmom, angtwo);
+  calcSlaterDetSepMEod(Q, Qp, X, &op_tb_angmom, angtwo);
 
   *l2 = angone[0] + angtwo[0];
   *s2 = angone[1] + angtwo[1];
@@ -202,10 +204,11 @@ void calcJ2(const SlaterDet* Q, const SlaterDetAux* X,
   double j2one[3], j2two[3];
   int i;
   OneBodyOperator op_ob_j2 = {dim: 3, opt: 1, par: NULL, me: ob_j2};
-  TwoBodyOperator op_tb_j2 = {dim: 3, opt: 1, par: NULL, me: tb_j2};
+  SeparableOperator op_tb_j2 = {dim: 3, nob: 9, opt: OPTTPROP, par: NULL, 
+				me: sep_lsj, nterms: 3, terms: sep_j2};
 
   calcSlaterDetOBME(Q, X, &op_ob_j2, j2one);
-  calcSlaterDetTBME(Q, X, &op_tb_j2, j2two);
+  calcSlaterDetSepME(Q, X, &op_tb_j2, j2two);
 
   for (i=0; i<3; i++)
     j2[i] = j2one[i] + j2two[i];
@@ -219,10 +222,11 @@ void calcJ2od(const SlaterDet* Q, const SlaterDet* Qp,
   complex double j2one[3], j2two[3];
   int i;
   OneBodyOperator op_ob_j2 = {dim: 3, opt: 1, par: NULL, me: ob_j2};
-  TwoBodyOperator op_tb_j2 = {dim: 3, opt: 1, par: NULL, me: tb_j2};
+  SeparableOperator op_tb_j2 = {dim: 3, nob: 9, opt: OPTTPROP, par: NULL, 
+				me: sep_lsj, nterms: 3, terms: sep_j2};
 
   calcSlaterDetOBMEod(Q, Qp, X, &op_ob_j2, j2one);
-  calcSlaterDetTBMEod(Q, Qp, X, &op_tb_j2, j2two);
+  calcSlaterDetSepMEod(Q, Qp, X, &op_tb_j2, j2two);
 
   for (i=0; i<3; i++)
     j2[i] = j2one[i] + j2two[i];
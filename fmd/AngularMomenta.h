@@ -16,6 +16,9 @@
 #include "SlaterDet.h"
 
 
+/// one- and two-body operators used by calcAngularMomenta
+void initAngularMomentaoperators(OneBodyOperator* ob, SeparableOperator* tb);
+
 /// calculate l2, s2 and j2
 void calcAngularMomenta(const SlaterDet* Q, const SlaterDetAux* X, 
 			double* l2, double* s2, double* j2);
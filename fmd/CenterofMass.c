@@ -9,6 +9,7 @@
 
 */
 
+#include <math.h>
 #include <complex.h>
 
 #include "Gaussian.h"
@@ -68,6 +69,38 @@ static void tb_tcm(SlaterDet* Q,
 
 
 
+// two-body part is separable: 2M P.P with the one-body operators
+// sqrt(M) p
+static void sep_tcm(const void* par,
+		    const Gaussian*G1, const Gaussian* G2, 
+		    const GaussianAux* X, complex double p[3])
+{
+  const SlaterDet* Q = par;
+  double sqrtM;
+  int i;
+  sqrtM = sqrt(0.5/(Q->Z*mproton+Q->N*mneutron));
+
+  for (i=0; i<3; i++)
+    p[i] += sqrtM* X->pi[i]* X->Q;
+}
+
+static const SeparableTerm sep_p2[3] = {
+  {0, 0, 0, 2.0}, {0, 1, 1, 2.0}, {0, 2, 2, 2.0}
+};
+
+
+void initTCMoperators(const SlaterDet* Q, 
+		      OneBodyOperator* ob, SeparableOperator* tb)
+{
+  OneBodyOperator op_ob_tcm = {dim: 1, opt: 1, par: Q, me: ob_tcm};
+  SeparableOperator op_tb_tcm = {dim: 1, nob: 3, opt: OPTTPROP, par: Q, 
+				 me: sep_tcm, nterms: 3, terms: sep_p2};
+
+  *ob = op_ob_tcm;
+  *tb = op_tb_tcm;
+}
+
+
 void calcCMPosition(const SlaterDet* Q, const SlaterDetAux* X, double xcm[3])
 {
   int i;
@@ -101,10 +134,11 @@ void calcTCM(const SlaterDet* Q, const SlaterDetAux* X, double* tcm)
   double tcmone, tcmtwo;
 
   OneBodyOperator op_ob_tcm = {dim: 1, opt: 1, par: Q, me: ob_tcm};
-  TwoBodyOperator op_tb_tcm = {dim: 1, opt: 1, par: Q, me: tb_tcm};
+  SeparableOperator op_tb_tcm = {dim: 1, nob: 3, opt: OPTTPROP, par: Q, 
+				 me: sep_tcm, nterms: 3, terms: sep_p2};
 
   calcSlaterDetOBME(Q, X, &op_ob_tcm, &tcmone);
-  calcSlaterDetTBME(Q, X, &op_tb_tcm, &tcmtwo);
+  calcSlaterDetSepME(Q, X, &op_tb_tcm, &tcmtwo);
 
   *tcm = tcmone+tcmtwo;
 }
@@ -116,10 +150,11 @@ void calcTCMod(const SlaterDet* Q, const SlaterDet* Qp,
   complex double tcmone, tcmtwo;
 
   OneBodyOperator op_ob_tcm = {dim: 1, opt: 1, par: Q, me: ob_tcm};
-  TwoBodyOperator op_tb_tcm = {dim: 1, opt: 1, par: Q, me: tb_tcm};
+  SeparableOperator op_tb_tcm = {dim: 1, nob: 3, opt: OPTTPROP, par: Q, 
+				 me: sep_tcm, nterms: 3, terms: sep_p2};
 
   calcSlaterDetOBMEod(Q, Qp, X, &op_ob_tcm, &tcmone);
-  calcSlaterDetTBMEod(Q, Qp, X, &op_tb_tcm, &tcmtwo);
+  calcSlaterDetSepMEod(Q, Qp, X, &op_tb_tcm, &tcmtwo);
 
   *tcm = tcmone+tcmtwo;
 }
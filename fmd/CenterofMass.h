@@ -16,6 +16,10 @@
 #include "SlaterDet.h"
 
 
+/// one- and two-body operators used by calcTCM
+void initTCMoperators(const SlaterDet* Q, 
+		      OneBodyOperator* ob, SeparableOperator* tb);
+
 void calcCMPosition(const SlaterDet* Q, const SlaterDetAux* X, 
 		    double xcm[3]);
 
@@ -89,36 +89,32 @@ static void ob_j2(const CMpara* par,
 }
 
 
-static void tb_j2(const CMpara* par,
-		  const Gaussian* G1, const Gaussian* G2, 
-		  const Gaussian* G3, const Gaussian* G4, 
-		  const GaussianAux* X13, const GaussianAux* X24, 
-		  complex double* j2)
-{	
-  double* Xcm = par->Xcm;
-  double* Vcm = par->Vcm;
-  complex double l2, s2, ls;
-  complex double rhoxpicm13[3], rhoxpicm24[3];
+// two-body part is separable: 2 J.J with the one-body operators 
+// J = Lcm + S
+static void sep_j2(const void* par,
+		   const Gaussian* G1, const Gaussian* G2, 
+		   const GaussianAux* X, complex double j[3])
+{
+  const CMpara* cm = par;
+  double* Xcm = cm->Xcm;
+  double* Vcm = cm->Vcm;
+  complex double rhocm[3], picm[3], rhoxpicm[3];
   int i;
 
   for (i=0; i<3; i++)
-    rhoxpicm13[i] = 
-      (X13->rho[(i+1)%3]-Xcm[(i+1)%3])*(X13->pi[(i+2)%3]-mass(G1->xi)*Vcm[(i+2)%3]) -
-      (X13->rho[(i+2)%3]-Xcm[(i+2)%3])*(X13->pi[(i+1)%3]-mass(G1->xi)*Vcm[(i+1)%3]);
+    rhocm[i] = X->rho[i]-Xcm[i];
   for (i=0; i<3; i++)
-    rhoxpicm24[i] = 
-      (X24->rho[(i+1)%3]-Xcm[(i+1)%3])*(X24->pi[(i+2)%3]-mass(G2->xi)*Vcm[(i+2)%3]) -
-      (X24->rho[(i+2)%3]-Xcm[(i+2)%3])*(X24->pi[(i+1)%3]-mass(G2->xi)*Vcm[(i+1)%3]);
-
-  l2 = cvec3mult(rhoxpicm13, rhoxpicm24)* X13->Q* X24->Q;
-  s2 = 0.25*cvec3mult(X13->sig, X24->sig)* X13->T* X24->T* X13->R* X24->R;
-  ls = 0.25*(cvec3mult(rhoxpicm13, X24->sig)*X13->S+
-	     cvec3mult(X13->sig, rhoxpicm24)*X24->S)*
-       X13->T* X24->T* X13->R* X24->R;
+    picm[i] = X->pi[i]-mass(G1->xi)*Vcm[i];
+  cvec3cross(rhocm, picm, rhoxpicm);
 
-  *j2 += 2*(l2 + s2 + 2*ls);
+  for (i=0; i<3; i++)
+    j[i] += X->T*(rhoxpicm[i]*X->S + 0.5*X->sig[i])* X->R;
 }
 
+static const SeparableTerm sep_jj[3] = {
+  {0, 0, 0, 2.0}, {0, 1, 1, 2.0}, {0, 2, 2, 2.0}
+};
+
 
 static void gob_j2(const CMpara* par,
 		   const Gaussian* G1, const Gaussian* G2, 
@@ -202,84 +198,51 @@ static void gob_j2(const CMpara* par,
 }
 
 
-static void gtb_j2(const CMpara* par,
-		   const Gaussian* G1, const Gaussian* G2, 
-		   const Gaussian* G3, const Gaussian* G4, 
-		   const GaussianAux* X13, const GaussianAux* X24,
-		   const gradGaussianAux* dX13,
-		   complex double* j2, gradGaussian* dj2)
+static void gsep_j2(const void* par,
+		    const Gaussian* G1, const Gaussian* G2, 
+		    const GaussianAux* X, const gradGaussianAux* dX,
+		    complex double j[3], gradGaussian dj[3])
 {
-  double* Xcm = par->Xcm;
-  double* Vcm = par->Vcm;
-  complex double rho13cm[3], rho24cm[3], pi13cm[3], pi24cm[3];
-  complex double rhoxpi13cm[3], rhoxpi24cm[3];	
-  complex double l2m, s2m, lsm;
-  gradScalar dl2m;
-  gradGaussian dlsm;
-  int i;
+  const CMpara* cm = par;
+  double* Xcm = cm->Xcm;
+  double* Vcm = cm->Vcm;
+  complex double rhocm[3], picm[3], rhoxpicm[3];
+  complex double drhoxpi[3], rhoxdpi[3], ek[3], ekxpi[3], rhoxek[3];
+  complex double jm;
+  int i,k;
 
   for (i=0; i<3; i++)
-    rho13cm[i] = X13->rho[i]-Xcm[i];
+    rhocm[i] = X->rho[i]-Xcm[i];
   for (i=0; i<3; i++)
-    pi13cm[i] = X13->pi[i]-mass(G1->xi)*Vcm[i];
-  cvec3cross(rho13cm, pi13cm, rhoxpi13cm);
+    picm[i] = X->pi[i]-mass(G1->xi)*Vcm[i];
+  cvec3cross(rhocm, picm, rhoxpicm);
 
-  for (i=0; i<3; i++)
-    rho24cm[i] = X24->rho[i]-Xcm[i];
-  for (i=0; i<3; i++)
-    pi24cm[i] = X24->pi[i]-mass(G2->xi)*Vcm[i];
-  cvec3cross(rho24cm, pi24cm, rhoxpi24cm);
-  
-  l2m = cvec3mult(rhoxpi13cm, rhoxpi24cm);
-  s2m = 0.25*cvec3mult(X13->sig, X24->sig);
-  lsm = 0.25*(cvec3mult(rhoxpi13cm, X24->sig)*X13->S+
-	      cvec3mult(X13->sig, rhoxpi24cm)*X24->S);
-  
-  *j2 += 2* X13->T*X24->T* (l2m*X13->S*X24->S + 2*lsm + s2m) *X13->R*X24->R;
-  
-  dl2m.a = 
-    cvec3mult(dX13->drho.a, rho24cm)*cvec3mult(pi13cm, pi24cm) +
-    cvec3mult(rho13cm, rho24cm)*cvec3mult(dX13->dpi.a, pi24cm) -
-    cvec3mult(dX13->drho.a, pi24cm)*cvec3mult(pi13cm, rho24cm) -
-    cvec3mult(rho13cm, pi24cm)*cvec3mult(dX13->dpi.a, rho24cm);
-  for (i=0; i<3; i++)
-    dl2m.b[i] =
-      dX13->drho.b*rho24cm[i]*cvec3mult(pi13cm, pi24cm) +
-      cvec3mult(rho13cm, rho24cm)*dX13->dpi.b*pi24cm[i] -
-      dX13->drho.b*pi24cm[i]*cvec3mult(pi13cm, rho24cm) -
-      cvec3mult(rho13cm, pi24cm)*dX13->dpi.b*rho24cm[i];
-      
-  for (i=0; i<2; i++)
-    dlsm.chi[i] = 0.25*( 
-      cvec3mult(rhoxpi13cm, X24->sig)*dX13->dS.chi[i]+
-      cvec3mult(dX13->dsig.chi[i], rhoxpi24cm)*X24->S);
-  dlsm.a =
-    0.25*cvec3spat(dX13->drho.a, pi13cm, X24->sig)*X13->S+
-    0.25*cvec3spat(rho13cm, dX13->dpi.a, X24->sig)*X13->S;
+  cvec3cross(dX->drho.a, picm, drhoxpi);
+  cvec3cross(rhocm, dX->dpi.a, rhoxdpi);
 
-  for (i=0; i<3; i++)
-    dlsm.b[i] = 0.25*
-      ((dX13->drho.b*pi13cm[(i+1)%3]-rho13cm[(i+1)%3]*dX13->dpi.b)*
-       X13->S* X24->sig[(i+2)%3] - 
-       (dX13->drho.b*pi13cm[(i+2)%3]-rho13cm[(i+2)%3]*dX13->dpi.b)*
-       X13->S* X24->sig[(i+1)%3]);	
-  
-  for (i=0; i<2; i++)
-    dj2->chi[i] += 2* X13->T*X24->T*
-      (l2m*dX13->dS.chi[i]*X24->S +
-       2*dlsm.chi[i] +
-       0.25*cvec3mult(dX13->dsig.chi[i], X24->sig))* X13->R* X24->R;
+  for (i=0; i<3; i++) {
+    jm = rhoxpicm[i]*X->S + 0.5*X->sig[i];
 
-  dj2->a += 2* X13->T*X24->T*
-    (dl2m.a* X13->S*X24->S* X13->R*X24->R +
-     2*dlsm.a* X13->R*X24->R +
-     (l2m*X13->S*X24->S + 2*lsm + s2m)*dX13->dR.a*X24->R);
+    j[i] += X->T* jm* X->R;
 
-  for (i=0; i<3; i++)
-    dj2->b[i] += 2* X13->T*X24->T*
-      (dl2m.b[i]* X13->S*X24->S* X13->R*X24->R +
-       2*dlsm.b[i]* X13->R*X24->R +
-       (l2m*X13->S*X24->S + 2*lsm + s2m)*dX13->dR.b[i]*X24->R);  
+    for (k=0; k<2; k++)
+      dj[i].chi[k] += X->T* (rhoxpicm[i]*dX->dS.chi[k] + 
+			     0.5*dX->dsig.chi[k][i])* X->R;
+    dj[i].a += X->T* ((drhoxpi[i] + rhoxdpi[i])*X->S* X->R + 
+		      jm* dX->dR.a);
+  }
+
+  for (k=0; k<3; k++) {
+    for (i=0; i<3; i++)
+      ek[i] = (i == k);
+    cvec3cross(ek, picm, ekxpi);
+    cvec3cross(rhocm, ek, rhoxek);
+
+    for (i=0; i<3; i++)
+      dj[i].b[k] += X->T* ((dX->drho.b*ekxpi[i] + dX->dpi.b*rhoxek[i])*
+			   X->S* X->R + 
+			   (rhoxpicm[i]*X->S + 0.5*X->sig[i])* dX->dR.b[k]);
+  }
 }
 
 
@@ -339,59 +302,51 @@ void gcmob_j2(const CMpara* par,
 } 
 
 
-void gcmtb_j2(const CMpara* par,
-	      const Gaussian* G1, const Gaussian* G2,
-	      const Gaussian* G3, const Gaussian* G4,
-	      const GaussianAux* X13, const GaussianAux* X24,
-	      gradCM* dCMj2)
+// derivatives of 2 J.J with respect to Xcm and Vcm, 
+// 4 dJ/dXcm.J and 4 dJ/dVcm.J
+static void gcmsep_j2(const void* par,
+		      const Gaussian* G1, const Gaussian* G2,
+		      const GaussianAux* X,
+		      complex double j[21])
 {
-  double* Xcm = par->Xcm;
-  double* Vcm = par->Vcm;
-  complex double rho13cm[3], rho24cm[3], pi13cm[3], pi24cm[3];
-  gradCM dl2m, dlsm;
-  int i;
+  const CMpara* cm = par;
+  double* Xcm = cm->Xcm;
+  double* Vcm = cm->Vcm;
+  complex double rhocm[3], picm[3], rhoxpicm[3];
+  complex double ek[3], ekxpi[3], rhoxek[3];
+  int i,k;
 
   for (i=0; i<3; i++)
-    rho13cm[i] = X13->rho[i]-Xcm[i];
+    rhocm[i] = X->rho[i]-Xcm[i];
   for (i=0; i<3; i++)
-    pi13cm[i] = X13->pi[i]-mass(G1->xi)*Vcm[i];
+    picm[i] = X->pi[i]-mass(G1->xi)*Vcm[i];
+  cvec3cross(rhocm, picm, rhoxpicm);
 
   for (i=0; i<3; i++)
-    rho24cm[i] = X24->rho[i]-Xcm[i];
-  for (i=0; i<3; i++)
-    pi24cm[i] = X24->pi[i]-mass(G2->xi)*Vcm[i];
+    j[i] += X->T*(rhoxpicm[i]*X->S + 0.5*X->sig[i])* X->R;
 
-  for (i=0; i<3; i++)
-    dl2m.X[i] = - (rho24cm[i]+rho13cm[i])*cvec3mult(pi13cm, pi24cm) +
-      pi24cm[i]*cvec3mult(pi13cm, rho24cm) +
-      cvec3mult(rho13cm, pi24cm)*pi13cm[i];
-  for (i=0; i<3; i++)
-    dl2m.V[i] = - cvec3mult(rho13cm, rho24cm)*
-      (mass(G1->xi)*pi24cm[i]+mass(G2->xi)*pi13cm[i]) +
-      mass(G2->xi)*rho13cm[i]*cvec3mult(pi13cm, rho24cm) +
-      cvec3mult(rho13cm, pi24cm)*mass(G1->xi)*rho24cm[i];
-      
-  for (i=0; i<3; i++)
-    dlsm.X[i] = 
-      -0.25*(pi13cm[(i+1)%3]*X13->S*X24->sig[(i+2)%3] -
-	     pi13cm[(i+2)%3]*X13->S*X24->sig[(i+1)%3])
-      -0.25*(X13->sig[(i+2)%3]*pi24cm[(i+1)%3]*X24->S -
-	     X13->sig[(i+1)%3]*pi24cm[(i+2)%3]*X24->S);
-  for (i=0; i<3; i++)
-    dlsm.V[i] = 
-      0.25*mass(G1->xi)*(rho13cm[(i+1)%3]*X13->S*X24->sig[(i+2)%3] -
-			 rho13cm[(i+2)%3]*X13->S*X24->sig[(i+1)%3]) +
-      0.25*mass(G2->xi)*(X13->sig[(i+2)%3]*rho24cm[(i+1)%3]*X24->S -
-			 X13->sig[(i+1)%3]*rho24cm[(i+2)%3]*X24->S);
+  for (k=0; k<3; k++) {
+    for (i=0; i<3; i++)
+      ek[i] = (i == k);
+    cvec3cross(ek, picm, ekxpi);
+    cvec3cross(rhocm, ek, rhoxek);
 
-  for (i=0; i<3; i++)
-    dCMj2->X[i] += 2*X13->T*X24->T* 
-      (dl2m.X[i]* X13->S*X24->S + 2*dlsm.X[i])* X13->R* X24->R;
-  for (i=0; i<3; i++)
-    dCMj2->V[i] += 2*X13->T*X24->T* 
-      (dl2m.V[i]* X13->S*X24->S + 2*dlsm.V[i])* X13->R* X24->R;
+    for (i=0; i<3; i++) {
+      j[3+3*k+i] += -ekxpi[i]* X->Q;
+      j[12+3*k+i] += -mass(G1->xi)*rhoxek[i]* X->Q;
+    }
+  }
 }
 
+static const SeparableTerm gcmsep_jj[18] = {
+  {0, 3, 0, 4.0}, {0, 4, 1, 4.0}, {0, 5, 2, 4.0},
+  {1, 6, 0, 4.0}, {1, 7, 1, 4.0}, {1, 8, 2, 4.0},
+  {2, 9, 0, 4.0}, {2, 10, 1, 4.0}, {2, 11, 2, 4.0},
+  {3, 12, 0, 4.0}, {3, 13, 1, 4.0}, {3, 14, 2, 4.0},
+  {4, 15, 0, 4.0}, {4, 16, 1, 4.0}, {4, 17, 2, 4.0},
+  {5, 18, 0, 4.0}, {5, 19, 1, 4.0}, {5, 20, 2, 4.0}
+};
+
 
 void calcConstraintJ2(const SlaterDet* Q, const SlaterDetAux* X, 
 		      double* j2)
@@ -403,10 +358,11 @@ void calcConstraintJ2(const SlaterDet* Q, const SlaterDetAux* X,
   calcCMVelocity(Q, X, para.Vcm);
   
   OneBodyOperator op_ob_j2 = {dim: 1, opt: 1, par: &para, me: ob_j2};
-  TwoBodyOperator op_tb_j2 = {dim: 1, opt: 1, par: &para, me: tb_j2};
+  SeparableOperator op_tb_j2 = {dim: 1, nob: 3, opt: OPTTPROP, par: &para, 
+				me: sep_j2, nterms: 3, terms: sep_jj};
 
   calcSlaterDetOBME(Q, X, &op_ob_j2, &j2one);
-  calcSlaterDetTBME(Q, X, &op_tb_j2, &j2two);
+  calcSlaterDetSepME(Q, X, &op_tb_j2, &j2two);
 
   *j2 = j2one + j2two;
 }
@@ -424,18 +380,20 @@ void calcgradConstraintJ2(const SlaterDet* Q, const SlaterDetAux* X,
   calcCMVelocity(Q, X, para.Vcm);
 
   gradOneBodyOperator gop_ob_j2 = {opt: 1, par: &para, me: gob_j2};
-  gradTwoBodyOperator gop_tb_j2 = {opt: 1, par: &para, me: gtb_j2};
+  gradSeparableOperator gop_tb_j2 = {nob: 3, opt: OPTTPROP, par: &para, 
+				     me: gsep_j2, nterms: 3, terms: sep_jj};
 
   calcgradSlaterDetOBME(Q, X, dX, &gop_ob_j2, dj2);
-  calcgradSlaterDetTBME(Q, X, dX, &gop_tb_j2, dj2);
+  calcgradSlaterDetSepME(Q, X, dX, &gop_tb_j2, dj2);
 
   j2 = dj2->val;
 
   OneBodyOperator gcmop_ob_j2 = {dim: 6, opt: 1, par: &para, me: gcmob_j2};
-  TwoBodyOperator gcmop_tb_j2 = {dim: 6, opt: 1, par: &para, me: gcmtb_j2};
+  SeparableOperator gcmop_tb_j2 = {dim: 6, nob: 21, opt: OPTTPROP, par: &para,
+				   me: gcmsep_j2, nterms: 18, terms: gcmsep_jj};
 
   calcgradCMSlaterDetOBME(Q, X, dX, &gcmop_ob_j2, dj2);
-  calcgradCMSlaterDetTBME(Q, X, dX, &gcmop_tb_j2, dj2);
+  calcgradCMSlaterDetSepME(Q, X, dX, &gcmop_tb_j2, dj2);
 
   dj2->val = j2;
 }
@@ -451,10 +409,11 @@ void calcConstraintJ2od(const SlaterDet* Q, const SlaterDet* Qp,
   complex double j2one, j2two;
 
   OneBodyOperator op_ob_j2 = {dim: 1, opt: 1, par: &para, me: ob_j2};
-  TwoBodyOperator op_tb_j2 = {dim: 1, opt: 1, par: &para, me: tb_j2};
+  SeparableOperator op_tb_j2 = {dim: 1, nob: 3, opt: OPTTPROP, par: &para, 
+				me: sep_j2, nterms: 3, terms: sep_jj};
 
   calcSlaterDetOBMEod(Q, Qp, X, &op_ob_j2, &j2one);
-  calcSlaterDetTBMEod(Q, Qp, X, &op_tb_j2, &j2two);
+  calcSlaterDetSepMEod(Q, Qp, X, &op_tb_j2, &j2two);
 
   *j2 = j2one + j2two;
 }
@@ -469,10 +428,11 @@ void calcgradConstraintJ2od(const SlaterDet* Q, const SlaterDet* Qp,
   CMpara para = { {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0} };
 
   gradOneBodyOperator gop_ob_j2 = {opt: 1, par: &para, me: gob_j2};
-  gradTwoBodyOperator gop_tb_j2 = {opt: 1, par: &para, me: gtb_j2};
+  gradSeparableOperator gop_tb_j2 = {nob: 3, opt: OPTTPROP, par: &para, 
+				     me: gsep_j2, nterms: 3, terms: sep_jj};
 
   calcgradSlaterDetOBMEod(Q, Qp, X, dX, &gop_ob_j2, dj2);
-  calcgradSlaterDetTBMEod(Q, Qp, X, dX, &gop_tb_j2, dj2);
+  calcgradSlaterDetSepMEod(Q, Qp, X, dX, &gop_tb_j2, dj2);
 }
 
 
@@ -87,35 +87,30 @@ static void ob_ns2(void* par,
 }
 
 
-static void tb_s2(void* par,
-		  const Gaussian* G1, const Gaussian* G2, 
-		  const Gaussian* G3, const Gaussian* G4, 
-		  const GaussianAux* X13, const GaussianAux* X24, 
-		  complex double* s2)
-{	
-  *s2 += 2*0.25*cvec3mult(X13->sig, X24->sig)* X13->T* X24->T* X13->R* X24->R;
-}
+// two-body parts are separable: 2 S.S with the one-body operators S
+// of all nucleons, or only of protons or neutrons if par points to xi
 
-static void tb_ps2(void* par,
-                   const Gaussian* G1, const Gaussian* G2, 
-                   const Gaussian* G3, const Gaussian* G4, 
-                   const GaussianAux* X13, const GaussianAux* X24, 
-                   complex double* s2)
-{	
-  if (G1->xi == +1 && G2->xi == +1)
-    *s2 += 2*0.25*cvec3mult(X13->sig, X24->sig)* X13->T* X24->T* X13->R* X24->R;
-}
+static const int protons = +1;
+static const int neutrons = -1;
 
-static void tb_ns2(void* par,
-                   const Gaussian* G1, const Gaussian* G2, 
-                   const Gaussian* G3, const Gaussian* G4, 
-                   const GaussianAux* X13, const GaussianAux* X24, 
-                   complex double* s2)
-{	
-  if (G1->xi == -1 && G2->xi == -1)
-    *s2 += 2*0.25*cvec3mult(X13->sig, X24->sig)* X13->T* X24->T* X13->R* X24->R;
+static void sep_s2(const void* par,
+		   const Gaussian* G1, const Gaussian* G2, 
+		   const GaussianAux* X, complex double s[3])
+{
+  const int* xi = par;
+  int i;
+
+  if (xi && G1->xi != *xi)
+    return;
+
+  for (i=0; i<3; i++)
+    s[i] += X->T* 0.5*X->sig[i]* X->R;
 }
 
+static const SeparableTerm sep_ss[3] = {
+  {0, 0, 0, 2.0}, {0, 1, 1, 2.0}, {0, 2, 2, 2.0}
+};
+
 
 static void gob_s2(void* par,
 		   const Gaussian* G1, const Gaussian* G2, 
@@ -185,79 +180,27 @@ static void gob_ns2(void* par,
 }
 
 
-static void gtb_s2(void* par,
-		   const Gaussian* G1, const Gaussian* G2, 
-		   const Gaussian* G3, const Gaussian* G4, 
-		   const GaussianAux* X13, const GaussianAux* X24,
-		   const gradGaussianAux* dX13,
-		   complex double* s2, gradGaussian* ds2)
-{	
-  complex double s2m;
-  int i;
-
-  s2m = 0.25*cvec3mult(X13->sig, X24->sig);
-  
-  *s2 += 2* X13->T*X24->T* s2m *X13->R*X24->R;
-  
-  for (i=0; i<2; i++)
-    ds2->chi[i] += 2* X13->T*X24->T*
-       0.25*cvec3mult(dX13->dsig.chi[i], X24->sig)* X13->R* X24->R;
-
-  ds2->a += 2* X13->T*X24->T* s2m* dX13->dR.a*X24->R;
-
-  for (i=0; i<3; i++)
-    ds2->b[i] += 2* X13->T*X24->T* s2m* dX13->dR.b[i]*X24->R;  
-}
+static void gsep_s2(const void* par,
+		    const Gaussian* G1, const Gaussian* G2, 
+		    const GaussianAux* X, const gradGaussianAux* dX,
+		    complex double s[3], gradGaussian ds[3])
+{
+  const int* xi = par;
+  int i,k;
 
-static void gtb_ps2(void* par,
-                    const Gaussian* G1, const Gaussian* G2, 
-                    const Gaussian* G3, const Gaussian* G4, 
-                    const GaussianAux* X13, const GaussianAux* X24,
-                    const gradGaussianAux* dX13,
-                    complex double* s2, gradGaussian* ds2)
-{	
-  complex double s2m;
-  int i;
+  if (xi && G1->xi != *xi)
+    return;
 
-  if (G1->xi == +1 && G2->xi == +1) {
-    s2m = 0.25*cvec3mult(X13->sig, X24->sig);
-  
-    *s2 += 2* X13->T*X24->T* s2m *X13->R*X24->R;
-  
-    for (i=0; i<2; i++)
-      ds2->chi[i] += 2* X13->T*X24->T*
-        0.25*cvec3mult(dX13->dsig.chi[i], X24->sig)* X13->R* X24->R;
+  for (i=0; i<3; i++) {
+    s[i] += X->T* 0.5*X->sig[i]* X->R;
 
-    ds2->a += 2* X13->T*X24->T* s2m* dX13->dR.a*X24->R;
+    for (k=0; k<2; k++)
+      ds[i].chi[k] += X->T* 0.5*dX->dsig.chi[k][i]* X->R;
 
-    for (i=0; i<3; i++)
-      ds2->b[i] += 2* X13->T*X24->T* s2m* dX13->dR.b[i]*X24->R;  
-  }
-}
+    ds[i].a += X->T* 0.5*X->sig[i]* dX->dR.a;
 
-static void gtb_ns2(void* par,
-                    const Gaussian* G1, const Gaussian* G2, 
-                    const Gaussian* G3, const Gaussian* G4, 
-                    const GaussianAux* X13, const GaussianAux* X24,
-                    const gradGaussianAux* dX13,
-                    complex double* s2, gradGaussian* ds2)
-{	
-  complex double s2m;
-  int i;
-
-  if (G1->xi == -1 && G2->xi == -1) {
-    s2m = 0.25*cvec3mult(X13->sig, X24->sig);
-  
-    *s2 += 2* X13->T*X24->T* s2m *X13->R*X24->R;
-  
-    for (i=0; i<2; i++)
-      ds2->chi[i] += 2* X13->T*X24->T*
-        0.25*cvec3mult(dX13->dsig.chi[i], X24->sig)* X13->R* X24->R;
-
-    ds2->a += 2* X13->T*X24->T* s2m* dX13->dR.a*X24->R;
-
-    for (i=0; i<3; i++)
-      ds2->b[i] += 2* X13->T*X24->T* s2m* dX13->dR.b[i]*X24->R;  
+    for (k=0; k<3; k++)
+      ds[i].b[k] += X->T* 0.5*X->sig[i]* dX->dR.b[k];
   }
 }
 
@@ -267,11 +210,12 @@ void calcConstraintS2(const SlaterDet* Q, const SlaterDetAux* X,
 {
   double s2one, s2two;
   OneBodyOperator op_ob_s2 = {dim: 1, opt: 1, par: NULL, me: ob_s2};
-  TwoBodyOperator op_tb_s2 = {dim: 1, opt: 1, par: NULL, me: tb_s2};
+  SeparableOperator op_tb_s2 = {dim: 1, nob: 3, opt: OPTTPROP, par: NULL,
+				me: sep_s2, nterms: 3, terms: sep_ss};
 
 
   calcSlaterDetOBME(Q, X, &op_ob_s2, &s2one);
-  calcSlaterDetTBME(Q, X, &op_tb_s2, &s2two);
+  calcSlaterDetSepME(Q, X, &op_tb_s2, &s2two);
 
   *s2 = s2one + s2two;
 }
@@ -281,11 +225,12 @@ void calcConstraintPS2(const SlaterDet* Q, const SlaterDetAux* X,
 {
   double s2one, s2two;
   OneBodyOperator op_ob_s2 = {dim: 1, opt: 1, par: NULL, me: ob_ps2};
-  TwoBodyOperator op_tb_s2 = {dim: 1, opt: 1, par: NULL, me: tb_ps2};
+  SeparableOperator op_tb_s2 = {dim: 1, nob: 3, opt: OPTTPROP, par: &protons,
+				me: sep_s2, nterms: 3, terms: sep_ss};
 
 
   calcSlaterDetOBME(Q, X, &op_ob_s2, &s2one);
-  calcSlaterDetTBME(Q, X, &op_tb_s2, &s2two);
+  calcSlaterDetSepME(Q, X, &op_tb_s2, &s2two);
 
   *s2 = s2one + s2two;
 }
@@ -295,11 +240,12 @@ void calcConstraintNS2(const SlaterDet* Q, const SlaterDetAux* X,
 {
   double s2one, s2two;
   OneBodyOperator op_ob_s2 = {dim: 1, opt: 1, par: NULL, me: ob_ns2};
-  TwoBodyOperator op_tb_s2 = {dim: 1, opt: 1, par: NULL, me: tb_ns2};
+  SeparableOperator op_tb_s2 = {dim: 1, nob: 3, opt: OPTTPROP, par: &neutrons,
+				me: sep_s2, nterms: 3, terms: sep_ss};
 
 
   calcSlaterDetOBME(Q, X, &op_ob_s2, &s2one);
-  calcSlaterDetTBME(Q, X, &op_tb_s2, &s2two);
+  calcSlaterDetSepME(Q, X, &op_tb_s2, &s2two);
 
   *s2 = s2one + s2two;
 }
@@ -310,11 +256,12 @@ void calcgradConstraintS2(const SlaterDet* Q, const SlaterDetAux* X,
 			  gradSlaterDet* ds2)
 {
   gradOneBodyOperator gop_ob_s2 = {opt: 1, par: NULL, me: gob_s2};
-  gradTwoBodyOperator gop_tb_s2 = {opt: 1, par: NULL, me: gtb_s2};
+  gradSeparableOperator gop_tb_s2 = {nob: 3, opt: OPTTPROP, par: NULL,
+				     me: gsep_s2, nterms: 3, terms: sep_ss};
 
 
   calcgradSlaterDetOBME(Q, X, dX, &gop_ob_s2, ds2);
-  calcgradSlaterDetTBME(Q, X, dX, &gop_tb_s2, ds2);
+  calcgradSlaterDetSepME(Q, X, dX, &gop_tb_s2, ds2);
 }
 
 void calcgradConstraintPS2(const SlaterDet* Q, const SlaterDetAux* X, 
@@ -322,11 +269,12 @@ void calcgradConstraintPS2(const SlaterDet* Q, const SlaterDetAux* X,
                            gradSlaterDet* ds2)
 {
   gradOneBodyOperator gop_ob_s2 = {opt: 1, par: NULL, me: gob_ps2};
-  gradTwoBodyOperator gop_tb_s2 = {opt: 1, par: NULL, me: gtb_ps2};
+  gradSeparableOperator gop_tb_s2 = {nob: 3, opt: OPTTPROP, par: &protons,
+				     me: gsep_s2, nterms: 3, terms: sep_ss};
 
 
   calcgradSlaterDetOBME(Q, X, dX, &gop_ob_s2, ds2);
-  calcgradSlaterDetTBME(Q, X, dX, &gop_tb_s2, ds2);
+  calcgradSlaterDetSepME(Q, X, dX, &gop_tb_s2, ds2);
 }
 
 void calcgradConstraintNS2(const SlaterDet* Q, const SlaterDetAux* X, 
@@ -334,11 +282,12 @@ void calcgradConstraintNS2(const SlaterDet* Q, const SlaterDetAux* X,
                            gradSlaterDet* ds2)
 {
   gradOneBodyOperator gop_ob_s2 = {opt: 1, par: NULL, me: gob_ns2};
-  gradTwoBodyOperator gop_tb_s2 = {opt: 1, par: NULL, me: gtb_ns2};
+  gradSeparableOperator gop_tb_s2 = {nob: 3, opt: OPTTPROP, par: &neutrons,
+				     me: gsep_s2, nterms: 3, terms: sep_ss};
 
 
   calcgradSlaterDetOBME(Q, X, dX, &gop_ob_s2, ds2);
-  calcgradSlaterDetTBME(Q, X, dX, &gop_tb_s2, ds2);
+  calcgradSlaterDetSepME(Q, X, dX, &gop_tb_s2, ds2);
 }
 
 
@@ -348,11 +297,12 @@ void calcConstraintS2od(const SlaterDet* Q, const SlaterDet* Qp,
 {
   complex double s2one, s2two;
   OneBodyOperator op_ob_s2 = {dim: 1, opt: 1, par: NULL, me: ob_s2};
-  TwoBodyOperator op_tb_s2 = {dim: 1, opt: 1, par: NULL, me: tb_s2};
+  SeparableOperator op_tb_s2 = {dim: 1, nob: 3, opt: OPTTPROP, par: NULL,
+				me: sep_s2, nterms: 3, terms: sep_ss};
 
 
   calcSlaterDetOBMEod(Q, Qp, X, &op_ob_s2, &s2one);
-  calcSlaterDetTBMEod(Q, Qp, X, &op_tb_s2, &s2two);
+  calcSlaterDetSepMEod(Q, Qp, X, &op_tb_s2, &s2two);
 
   *s2 = s2one + s2two;
 }
@@ -365,11 +315,12 @@ void calcgradConstraintS2od(const SlaterDet* Q, const SlaterDet* Qp,
 			    gradSlaterDet* ds2)
 {
   gradOneBodyOperator gop_ob_s2 = {opt: 1, par: NULL, me: gob_s2};
-  gradTwoBodyOperator gop_tb_s2 = {opt: 1, par: NULL, me: gtb_s2};
+  gradSeparableOperator gop_tb_s2 = {nob: 3, opt: OPTTPROP, par: NULL,
+				     me: gsep_s2, nterms: 3, terms: sep_ss};
 
 
   calcgradSlaterDetOBMEod(Q, Qp, X, dX, &gop_ob_s2, ds2);
-  calcgradSlaterDetTBMEod(Q, Qp, X, dX, &gop_tb_s2, ds2);
+  calcgradSlaterDetSepMEod(Q, Qp, X, dX, &gop_tb_s2, ds2);
 }
 
 
@@ -82,41 +82,31 @@ static void ob_nt2(void* par,
     *t2 += 0.75*X->Q;
 }
 
-static void tb_t2(void* par,
-		  const Gaussian* G1, const Gaussian* G2, 
-		  const Gaussian* G3, const Gaussian* G4, 
-		  const GaussianAux* X13, const GaussianAux* X24, 
-		  complex double* t2)
-{	
-  *t2 += 0.5*(((1-G1->xi*G3->xi)*(1-G2->xi*G4->xi))/4+
-	   (G1->xi*G4->xi+G2->xi*G3->xi)/2)* 
-    X13->S* X24->S* X13->R* X24->R;
-}
+// two-body parts are separable: 2 t.t = 2 t3 t3 + t+ t- + t- t+,
+// if par points to xi only t3 of protons or neutrons contributes
 
-static void tb_pt2(void* par,
-                   const Gaussian* G1, const Gaussian* G2, 
-                   const Gaussian* G3, const Gaussian* G4, 
-                   const GaussianAux* X13, const GaussianAux* X24, 
-                   complex double* t2)
-{	
-  if (G1->xi == +1 && G2->xi == +1)
-    *t2 += 0.5*(((1-G1->xi*G3->xi)*(1-G2->xi*G4->xi))/4+
-                (G1->xi*G4->xi+G2->xi*G3->xi)/2)* 
-      X13->S* X24->S* X13->R* X24->R;
-}
+static const int protons = +1;
+static const int neutrons = -1;
 
-static void tb_nt2(void* par,
-                   const Gaussian* G1, const Gaussian* G2, 
-                   const Gaussian* G3, const Gaussian* G4, 
-                   const GaussianAux* X13, const GaussianAux* X24, 
-                   complex double* t2)
-{	
-  if (G1->xi == -1 && G2->xi == -1)
-    *t2 += 0.5*(((1-G1->xi*G3->xi)*(1-G2->xi*G4->xi))/4+
-                (G1->xi*G4->xi+G2->xi*G3->xi)/2)* 
-      X13->S* X24->S* X13->R* X24->R;
+static void sep_t2(const void* par,
+		   const Gaussian* G1, const Gaussian* G2, 
+		   const GaussianAux* X, complex double t[3])
+{
+  const int* xi = par;
+  if (xi && G1->xi != *xi)
+    return;
+
+  t[0] += 0.5*G1->xi* X->Q;
+  if (G1->xi == +1 && G2->xi == -1)
+    t[1] += X->S* X->R;
+  if (G1->xi == -1 && G2->xi == +1)
+    t[2] += X->S* X->R;
 }
 
+static const SeparableTerm sep_tt[2] = {
+  {0, 0, 0, 2.0}, {0, 1, 2, 2.0}
+};
+
 
 static void gob_t2(void* par,
 		   const Gaussian* G1, const Gaussian* G2, 
@@ -186,94 +176,47 @@ static void gob_nt2(void* par,
 }
 
 
-static void gtb_t2(void* par,
-		   const Gaussian* G1, const Gaussian* G2, 
-		   const Gaussian* G3, const Gaussian* G4, 
-		   const GaussianAux* X13, const GaussianAux* X24,
-		   const gradGaussianAux* dX13,
-		   complex double* t2, gradGaussian* dt2)
-{	
-  complex double t2m;
-  int i;
+static void gsep_t2(const void* par,
+		    const Gaussian* G1, const Gaussian* G2, 
+		    const GaussianAux* X, const gradGaussianAux* dX,
+		    complex double t[3], gradGaussian dt[3])
+{
+  const int* xi = par;
+  complex double tm;
+  int c,i;
+
+  if (xi && G1->xi != *xi)
+    return;
+
+  if (X->T) {
+    c = 0; tm = 0.5*G1->xi* X->T;
+  } else if (G1->xi == +1) {
+    c = 1; tm = 1.0;
+  } else {
+    c = 2; tm = 1.0;
+  }
 
-  t2m = 0.25*(((1-G1->xi*G3->xi)*(1-G2->xi*G4->xi))/4+
-	      (G1->xi*G4->xi+G2->xi*G3->xi)/2);
+  t[c] += tm* X->S* X->R;
 
-  *t2 += 2* t2m* X13->S*X24->S* X13->R*X24->R;
-  
   for (i=0; i<2; i++)
-    dt2->chi[i] += 2* t2m* dX13->dS.chi[i]*X24->S* X13->R*X24->R;
-
-  dt2->a += 2* t2m* X13->S*X24->S* dX13->dR.a*X24->R;
-
+    dt[c].chi[i] += tm* dX->dS.chi[i]* X->R;
+  dt[c].a += tm* X->S* dX->dR.a;
   for (i=0; i<3; i++)
-    dt2->b[i] += 2* t2m* X13->S*X24->S* dX13->dR.b[i]*X24->R;
-}
-
-static void gtb_pt2(void* par,
-                    const Gaussian* G1, const Gaussian* G2, 
-                    const Gaussian* G3, const Gaussian* G4, 
-                    const GaussianAux* X13, const GaussianAux* X24,
-                    const gradGaussianAux* dX13,
-                    complex double* t2, gradGaussian* dt2)
-{	
-  complex double t2m;
-  int i;
-
-  if (G1->xi == +1 && G2->xi == +1) {
-
-    t2m = 0.25*(((1-G1->xi*G3->xi)*(1-G2->xi*G4->xi))/4+
-                (G1->xi*G4->xi+G2->xi*G3->xi)/2); 
-    
-    *t2 += 2* t2m* X13->S*X24->S* X13->R*X24->R;
-  
-    for (i=0; i<2; i++)
-      dt2->chi[i] += 2* t2m* dX13->dS.chi[i]*X24->S* X13->R*X24->R;
-
-    dt2->a += 2* t2m* X13->S*X24->S* dX13->dR.a*X24->R;
-  
-    for (i=0; i<3; i++)
-      dt2->b[i] += 2* t2m* X13->S*X24->S* dX13->dR.b[i]*X24->R;
-  }
+    dt[c].b[i] += tm* X->S* dX->dR.b[i];
 }
 
-static void gtb_nt2(void* par,
-                    const Gaussian* G1, const Gaussian* G2, 
-                    const Gaussian* G3, const Gaussian* G4, 
-                    const GaussianAux* X13, const GaussianAux* X24,
-                    const gradGaussianAux* dX13,
-                    complex double* t2, gradGaussian* dt2)
-{	
-  complex double t2m;
-  int i;
-
-  if (G1->xi == -1 && G2->xi == -1) {
-
-    t2m = 0.25*(((1-G1->xi*G3->xi)*(1-G2->xi*G4->xi))/4+
-                (G1->xi*G4->xi+G2->xi*G3->xi)/2); 
-    
-    *t2 += 2* t2m* X13->S*X24->S* X13->R*X24->R;
-  
-    for (i=0; i<2; i++)
-      dt2->chi[i] += 2* t2m* dX13->dS.chi[i]*X24->S* X13->R*X24->R;
-
-    dt2->a += 2* t2m* X13->S*X24->S* dX13->dR.a*X24->R;
-  
-    for (i=0; i<3; i++)
-      dt2->b[i] += 2* t2m* X13->S*X24->S* dX13->dR.b[i]*X24->R;
-  }
-}
 
 void calcConstraintT2(const SlaterDet* Q, const SlaterDetAux* X, 
 		      double* t2)
 {
   double t2one, t2two;
   OneBodyOperator op_ob_t2 = {dim: 1, opt: 1, par: NULL, me: ob_t2};
-  TwoBodyOperator op_tb_t2 = {dim: 1, opt: 0, par: NULL, me: tb_t2};
+  SeparableOperator op_tb_t2 = {dim: 1, nob: 3, opt: 0, par: NULL,
+				me: sep_t2, nterms: 2, terms: sep_tt};
 
 
   calcSlaterDetOBME(Q, X, &op_ob_t2, &t2one);
-  calcSlaterDetTBME(Q, X, &op_tb_t2, &t2two);
+  calcSlaterDetSepME(Q, X, &op_tb_t2, &t2two);
 
   *t2 = t2one + t2two;
 }
@@ -283,11 +226,12 @@ void calcConstraintPT2(const SlaterDet* Q, const SlaterDetAux* X,
 {
   double t2one, t2two;
   OneBodyOperator op_ob_t2 = {dim: 1, opt: 1, par: NULL, me: ob_pt2};
-  TwoBodyOperator op_tb_t2 = {dim: 1, opt: 0, par: NULL, me: tb_pt2};
+  SeparableOperator op_tb_t2 = {dim: 1, nob: 3, opt: OPTTPROP, par: &protons,
+				me: sep_t2, nterms: 1, terms: sep_tt};
 
 
   calcSlaterDetOBME(Q, X, &op_ob_t2, &t2one);
-  calcSlaterDetTBME(Q, X, &op_tb_t2, &t2two);
+  calcSlaterDetSepME(Q, X, &op_tb_t2, &t2two);
 
   *t2 = t2one + t2two;
 }
@@ -297,11 +241,12 @@ void calcConstraintNT2(const SlaterDet* Q, const SlaterDetAux* X,
 {
   double t2one, t2two;
   OneBodyOperator op_ob_t2 = {dim: 1, opt: 1, par: NULL, me: ob_nt2};
-  TwoBodyOperator op_tb_t2 = {dim: 1, opt: 0, par: NULL, me: tb_nt2};
+  SeparableOperator op_tb_t2 = {dim: 1, nob: 3, opt: OPTTPROP, par: &neutrons,
+				me: sep_t2, nterms: 1, terms: sep_tt};
 
 
   calcSlaterDetOBME(Q, X, &op_ob_t2, &t2one);
-  calcSlaterDetTBME(Q, X, &op_tb_t2, &t2two);
+  calcSlaterDetSepME(Q, X, &op_tb_t2, &t2two);
 
   *t2 = t2one + t2two;
 }
@@ -313,11 +258,12 @@ void calcgradConstraintT2(const SlaterDet* Q, const SlaterDetAux* X,
 			  gradSlaterDet* dt2)
 {
   gradOneBodyOperator gop_ob_t2 = {opt: 1, par: NULL, me: gob_t2};
-  gradTwoBodyOperator gop_tb_t2 = {opt: 0, par: NULL, me: gtb_t2};
+  gradSeparableOperator gop_tb_t2 = {nob: 3, opt: 0, par: NULL,
+				     me: gsep_t2, nterms: 2, terms: sep_tt};
 
 
   calcgradSlaterDetOBME(Q, X, dX, &gop_ob_t2, dt2);
-  calcgradSlaterDetTBME(Q, X, dX, &gop_tb_t2, dt2);
+  calcgradSlaterDetSepME(Q, X, dX, &gop_tb_t2, dt2);
 }
 
 void calcgradConstraintPT2(const SlaterDet* Q, const SlaterDetAux* X, 
@@ -325,11 +271,12 @@ void calcgradConstraintPT2(const SlaterDet* Q, const SlaterDetAux* X,
                            gradSlaterDet* dt2)
 {
   gradOneBodyOperator gop_ob_t2 = {opt: 1, par: NULL, me: gob_pt2};
-  gradTwoBodyOperator gop_tb_t2 = {opt: 0, par: NULL, me: gtb_pt2};
+  gradSeparableOperator gop_tb_t2 = {nob: 3, opt: OPTTPROP, par: &protons,
+				     me: gsep_t2, nterms: 1, terms: sep_tt};
 
 
   calcgradSlaterDetOBME(Q, X, dX, &gop_ob_t2, dt2);
-  calcgradSlaterDetTBME(Q, X, dX, &gop_tb_t2, dt2);
+  calcgradSlaterDetSepME(Q, X, dX, &gop_tb_t2, dt2);
 }
 
 void calcgradConstraintNT2(const SlaterDet* Q, const SlaterDetAux* X, 
@@ -337,11 +284,12 @@ void calcgradConstraintNT2(const SlaterDet* Q, const SlaterDetAux* X,
                            gradSlaterDet* dt2)
 {
   gradOneBodyOperator gop_ob_t2 = {opt: 1, par: NULL, me: gob_nt2};
-  gradTwoBodyOperator gop_tb_t2 = {opt: 0, par: NULL, me: gtb_nt2};
+  gradSeparableOperator gop_tb_t2 = {nob: 3, opt: OPTTPROP, par: &neutrons,
+				     me: gsep_t2, nterms: 1, terms: sep_tt};
 
 
   calcgradSlaterDetOBME(Q, X, dX, &gop_ob_t2, dt2);
-  calcgradSlaterDetTBME(Q, X, dX, &gop_tb_t2, dt2);
+  calcgradSlaterDetSepME(Q, X, dX, &gop_tb_t2, dt2);
 }
 
 
@@ -351,11 +299,12 @@ void calcConstraintT2od(const SlaterDet* Q, const SlaterDet* Qp,
 {
   complex double t2one, t2two;
   OneBodyOperator op_ob_t2 = {dim: 1, opt: 1, par: NULL, me: ob_t2};
-  TwoBodyOperator op_tb_t2 = {dim: 1, opt: 0, par: NULL, me: tb_t2};
+  SeparableOperator op_tb_t2 = {dim: 1, nob: 3, opt: 0, par: NULL,
+				me: sep_t2, nterms: 2, terms: sep_tt};
 
 
   calcSlaterDetOBMEod(Q, Qp, X, &op_ob_t2, &t2one);
-  calcSlaterDetTBMEod(Q, Qp, X, &op_tb_t2, &t2two);
+  calcSlaterDetSepMEod(Q, Qp, X, &op_tb_t2, &t2two);
 
   *t2 = t2one + t2two;
 }
@@ -369,11 +318,12 @@ void calcgradConstraintT2od(const SlaterDet* Q, const SlaterDet* Qp,
 			    gradSlaterDet* dt2)
 {
   gradOneBodyOperator gop_ob_t2 = {opt: 1, par: NULL, me: gob_t2};
-  gradTwoBodyOperator gop_tb_t2 = {opt: 0, par: NULL, me: gtb_t2};
+  gradSeparableOperator gop_tb_t2 = {nob: 3, opt: 0, par: NULL,
+				     me: gsep_t2, nterms: 2, terms: sep_tt};
 
 
   calcgradSlaterDetOBMEod(Q, Qp, X, dX, &gop_ob_t2, dt2);
-  calcgradSlaterDetTBMEod(Q, Qp, X, dX, &gop_tb_t2, dt2);
+  calcgradSlaterDetSepMEod(Q, Qp, X, dX, &gop_tb_t2, dt2);
 }
 
 
@@ -0,0 +1,323 @@
+/**
+
+  \file DensityGrids.c
+
+  one-body densities in coordinate and momentum space on grids
+
+  the product of Gaussians G1^* G2 factorizes in x, y and z, on
+  cartesian grids it is the outer product of one-dimensional tables,
+  along the rays of radial grids it is a single one-dimensional table.
+  The tables exp(c0 + c1 i + c2 i^2) are calculated by recursion.
+  Gaussian pairs are weighted with the density matrix, the work on
+  the grid is done once per Gaussian pair.
+
+
+*/
+
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+
+#include "Gaussian.h"
+#include "SlaterDet.h"
+
+#include "DensityGrids.h"
+
+#include "numerics/cmath.h"
+#include "numerics/zcw.h"
+
+
+#define TINY 1e-200
+
+
+void initDensityGridplane(DensityGrid* grid, int space, int channels,
+			  int v, int n, double range)
+{
+  int c;
+
+  grid->space = space;
+  grid->channels = channels;
+  grid->radial = 0;
+  grid->izcw = 0;
+
+  for (c=0; c<3; c++) {
+    grid->n[c] = (c == v) ? 1 : n;
+    grid->x0[c] = (c == v) ? 0.0 : -range;
+    grid->dx[c] = (c == v) ? 0.0 : 2*range/(n-1);
+  }
+}
+
+
+void initDensityGrid3d(DensityGrid* grid, int space, int channels,
+		       int n, double range)
+{
+  int c;
+
+  grid->space = space;
+  grid->channels = channels;
+  grid->radial = 0;
+  grid->izcw = 0;
+
+  for (c=0; c<3; c++) {
+    grid->n[c] = n;
+    grid->x0[c] = -range;
+    grid->dx[c] = 2*range/(n-1);
+  }
+}
+
+
+void initDensityGridradial(DensityGrid* grid, int space, int channels,
+			   int izcw, int n, double range)
+{
+  grid->space = space;
+  grid->channels = channels;
+  grid->radial = 1;
+  grid->izcw = izcw;
+
+  grid->n[0] = n; grid->n[1] = 1; grid->n[2] = 1;
+  grid->x0[0] = 0.0; grid->x0[1] = 0.0; grid->x0[2] = 0.0;
+  grid->dx[0] = range/(n-1); grid->dx[1] = 0.0; grid->dx[2] = 0.0;
+}
+
+
+int DensityGridsize(const DensityGrid* grid)
+{
+  return grid->channels*grid->n[0]*grid->n[1]*grid->n[2];
+}
+
+
+// t[i] = exp(c0 + c1 i + c2 i^2), recursion is restarted where
+// the table becomes tiny
+static void expquadratic(complex double c0, complex double c1,
+			 complex double c2, int n, complex double* t)
+{
+  complex double s, v;
+  int i;
+
+  t[0] = cexp(c0);
+  s = cexp(c1+c2);
+  v = cexp(2*c2);
+
+  for (i=1; i<n; i++) {
+    if (fabs(creal(t[i-1]))+fabs(cimag(t[i-1])) > TINY)
+      t[i] = t[i-1]*s;
+    else
+      t[i] = cexp(c0 + c1*i + c2*i*i);
+    s *= v;
+  }
+}
+
+
+// G1^* G2 = pre exp(sum_c alpha x_c^2 + beta_c x_c + gamma_c)
+static void Gaussianproduct(int space,
+			    const Gaussian* G1, const Gaussian* G2,
+			    complex double* alpha, complex double beta[3],
+			    complex double gamma[3], complex double* pre)
+{
+  int c;
+
+  if (space == DENSCOORDINATE) {
+    *alpha = -0.5*(1.0/conj(G1->a) + 1.0/G2->a);
+    for (c=0; c<3; c++) {
+      beta[c] = conj(G1->b[c])/conj(G1->a) + G2->b[c]/G2->a;
+      gamma[c] = -0.5*(csqr(conj(G1->b[c]))/conj(G1->a) +
+		       csqr(G2->b[c])/G2->a);
+    }
+    *pre = 1.0;
+  } else {
+    *alpha = -0.5*(conj(G1->a) + G2->a);
+    for (c=0; c<3; c++) {
+      beta[c] = I*(conj(G1->b[c]) - G2->b[c]);
+      gamma[c] = 0.0;
+    }
+    *pre = cpow32(conj(G1->a)*G2->a);
+  }
+}
+
+
+// add w G1^* G2 on the grid to the complex densities cdens or
+// the real part to rdens
+static void addGaussianproduct(const DensityGrid* grid,
+			       const Gaussian* G1, const Gaussian* G2,
+			       complex double w,
+			       complex double* cdens, double* rdens)
+{
+  int points = DensityGridsize(grid)/grid->channels;
+  int n0=grid->n[0], n1=grid->n[1], n2=grid->n[2];
+  complex double alpha, beta[3], gamma[3], pre;
+  int i,j,k,c;
+
+  Gaussianproduct(grid->space, G1, G2, &alpha, beta, gamma, &pre);
+  w *= pre;
+
+  // proton or neutron channel
+  int off = -1;
+  if (grid->channels == 3)
+    off = (G1->xi == +1 ? 1 : 2)*points;
+
+  if (grid->radial) {
+    int nzcw = nangles2(grid->izcw);
+    double dr = grid->dx[0];
+    double alph, bet, e[3];
+    complex double t[n0], sum[n0];
+
+    for (i=0; i<n0; i++)
+      sum[i] = 0.0;
+
+    for (j=0; j<nzcw; j++) {
+      getangles2(grid->izcw, j, &alph, &bet);
+      e[0] = cos(alph)*sin(bet);
+      e[1] = sin(alph)*sin(bet);
+      e[2] = cos(bet);
+
+      expquadratic(gamma[0]+gamma[1]+gamma[2],
+		   (e[0]*beta[0]+e[1]*beta[1]+e[2]*beta[2])*dr,
+		   alpha*dr*dr, n0, t);
+      for (i=0; i<n0; i++)
+	sum[i] += t[i];
+    }
+
+    w /= nzcw;
+    for (i=0; i<n0; i++) {
+      if (cdens) {
+	cdens[i] += w*sum[i];
+	if (off >= 0) cdens[i+off] += w*sum[i];
+      } else {
+	rdens[i] += creal(w*sum[i]);
+	if (off >= 0) rdens[i+off] += creal(w*sum[i]);
+      }
+    }
+  } else {
+    complex double t0[n0], t1[n1], t2[n2];
+    complex double* t[3] = { t0, t1, t2 };
+    complex double f, v;
+    double x0, dx;
+    int idx;
+
+    for (c=0; c<3; c++) {
+      x0 = grid->x0[c]; dx = grid->dx[c];
+      expquadratic(alpha*x0*x0 + beta[c]*x0 + gamma[c],
+		   (2*alpha*x0 + beta[c])*dx, alpha*dx*dx, grid->n[c], t[c]);
+    }
+
+    for (k=0; k<n2; k++)
+      for (j=0; j<n1; j++) {
+	f = w*t1[j]*t2[k];
+	idx = j*n0+k*n0*n1;
+	if (cdens) {
+	  for (i=0; i<n0; i++) {
+	    v = f*t0[i];
+	    cdens[idx+i] += v;
+	    if (off >= 0) cdens[idx+i+off] += v;
+	  }
+	} else {
+	  for (i=0; i<n0; i++) {
+	    v = f*t0[i];
+	    rdens[idx+i] += creal(v);
+	    if (off >= 0) rdens[idx+i+off] += creal(v);
+	  }
+	}
+      }
+  }
+}
+
+
+void calcDensityGrid(const DensityGrid* grid,
+		     const SlaterDet* Q, const SlaterDetAux* X,
+		     double* dens)
+{
+  int A=Q->A; int ngauss=Q->ngauss;
+  int* idx=Q->idx; int* ng=Q->ng;
+  Gaussian* G=Q->G;
+  GaussianAux* Gaux=X->Gaux;
+  complex double* o=X->o;
+  GaussianAux* Xkl;
+
+  int size = DensityGridsize(grid);
+  int i,k,l,ki,li;
+  complex double w;
+
+  for (i=0; i<size; i++)
+    dens[i] = 0.0;
+
+  // the density is real, the contributions from k,l and l,k are
+  // complex conjugate
+  for (l=0; l<A; l++)
+    for (k=0; k<=l; k++)
+      if (Gaux[idx[k]+idx[l]*ngauss].T) {
+	w = (k < l ? 2.0 : 1.0)*o[l+k*A];
+
+	for (li=0; li<ng[l]; li++)
+	  for (ki=0; ki<ng[k]; ki++) {
+	    Xkl = &Gaux[(idx[k]+ki)+(idx[l]+li)*ngauss];
+	    addGaussianproduct(grid, &G[idx[k]+ki], &G[idx[l]+li],
+			       w*Xkl->T*Xkl->S, NULL, dens);
+	  }
+      }
+}
+
+
+void calcDensityGridod(const DensityGrid* grid,
+		       const SlaterDet* Q, const SlaterDet* Qp,
+		       const SlaterDetAux* X,
+		       complex double* dens)
+{
+  int A=Q->A; int ngauss=Q->ngauss;
+  int* idx=Q->idx; int* idxp=Qp->idx;
+  int* ng=Q->ng; int* ngp=Qp->ng;
+  Gaussian* G=Q->G; Gaussian* Gp=Qp->G;
+  GaussianAux* Gaux=X->Gaux;
+  complex double* o=X->o;
+  complex double ovl=X->ovlap;
+  GaussianAux* Xkl;
+
+  int size = DensityGridsize(grid);
+  int i,k,l,ki,li;
+  complex double w;
+
+  for (i=0; i<size; i++)
+    dens[i] = 0.0;
+
+  for (l=0; l<A; l++)
+    for (k=0; k<A; k++)
+      if (Gaux[idx[k]+idxp[l]*ngauss].T) {
+	w = o[l+k*A]*ovl;
+
+	for (li=0; li<ngp[l]; li++)
+	  for (ki=0; ki<ng[k]; ki++) {
+	    Xkl = &Gaux[(idx[k]+ki)+(idxp[l]+li)*ngauss];
+	    addGaussianproduct(grid, &G[idx[k]+ki], &Gp[idxp[l]+li],
+			       w*Xkl->T*Xkl->S, dens, NULL);
+	  }
+      }
+}
+
+
+void calcDensityGridHF(const DensityGrid* grid,
+		       const SlaterDet* Q, const SlaterDetAux* X,
+		       void* mes)
+{
+  int A=Q->A; int ngauss=Q->ngauss;
+  int* idx=Q->idx; int* ng=Q->ng;
+  Gaussian* G=Q->G;
+  GaussianAux* Gaux=X->Gaux;
+  GaussianAux* Xkl;
+
+  int size = DensityGridsize(grid);
+  complex double (*dens)[size] = mes;
+  int i,k,l,ki,li;
+
+  for (l=0; l<A; l++)
+    for (k=0; k<A; k++) {
+      for (i=0; i<size; i++)
+	dens[k+l*A][i] = 0.0;
+
+      if (Gaux[idx[k]+idx[l]*ngauss].T)
+	for (li=0; li<ng[l]; li++)
+	  for (ki=0; ki<ng[k]; ki++) {
+	    Xkl = &Gaux[(idx[k]+ki)+(idx[l]+li)*ngauss];
+	    addGaussianproduct(grid, &G[idx[k]+ki], &G[idx[l]+li],
+			       Xkl->T*Xkl->S, dens[k+l*A], NULL);
+	  }
+    }
+}
@@ -0,0 +1,72 @@
+/**
+
+  \file DensityGrids.h
+
+  one-body densities in coordinate and momentum space on grids,
+  the Gaussian products factorize in x, y and z
+
+
+*/
+
+
+#ifndef _DENSITYGRIDS_H
+#define _DENSITYGRIDS_H
+
+#include <complex.h>
+
+#include "SlaterDet.h"
+
+
+#define DENSCOORDINATE 0
+#define DENSMOMENTUM 1
+
+
+/// grid for one-body densities, points x0[c]+i*dx[c] with i<n[c]
+/// in each direction c or for radial grids points r=i*dx[0] with i<n[0]
+/// averaged over the zcw angles izcw.
+/// densities for all nucleons and with 3 channels also for protons
+/// and neutrons are stored as dens[i+j*n[0]+k*n[0]*n[1]+channel*points]
+typedef struct {
+  int space;
+  int channels;
+  int radial;
+  int izcw;
+  int n[3];
+  double x0[3];
+  double dx[3];
+} DensityGrid;
+
+
+/// n x n grid in [-range,range] in the plane through the origin
+/// perpendicular to direction v
+void initDensityGridplane(DensityGrid* grid, int space, int channels,
+			  int v, int n, double range);
+
+/// n x n x n grid in [-range,range]
+void initDensityGrid3d(DensityGrid* grid, int space, int channels,
+		       int n, double range);
+
+/// n radial points in [0,range] averaged over zcw angles izcw
+void initDensityGridradial(DensityGrid* grid, int space, int channels,
+			   int izcw, int n, double range);
+
+/// number of grid points times channels
+int DensityGridsize(const DensityGrid* grid);
+
+/// densities for SlaterDet Q, dens will be overwritten
+void calcDensityGrid(const DensityGrid* grid,
+		     const SlaterDet* Q, const SlaterDetAux* X,
+		     double* dens);
+
+/// off-diagonal densities <Q|rho|Qp>, dens will be overwritten
+void calcDensityGridod(const DensityGrid* grid,
+		       const SlaterDet* Q, const SlaterDet* Qp,
+		       const SlaterDetAux* X,
+		       complex double* dens);
+
+/// single-particle densities mes[k+l*A][DensityGridsize]
+void calcDensityGridHF(const DensityGrid* grid,
+		       const SlaterDet* Q, const SlaterDetAux* X,
+		       void* mes);
+
+#endif
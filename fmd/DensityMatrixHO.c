@@ -4,6 +4,14 @@
 
    calculate density matrix in harmonic oscillator basis
 
+   the HO amplitudes of the Gaussians are summed up for every nucleon,
+   the density matrix is then given by two matrix products
+   rho = ovlap Amp^H . o^T . Amp'
+
+   in projection the amplitudes of the rotated states are obtained
+   from the amplitudes of the unrotated state by rotating them
+   with D^j_mm' in every (n,l,j) orbit
+
 
    (c) 2006 Thomas Neff
 
@@ -11,55 +19,237 @@
 
 
 #include <stdlib.h>
+#include <string.h>
 #include <complex.h>
 
 #include "SlaterDet.h"
 #include "HOBasis.h"
 #include "DensityMatrixHO.h"
 
+#include "numerics/lapack.h"
+#include "numerics/wignerd.h"
+#include "numerics/rotationmatrices.h"
+
+
+// HO amplitudes amp[k+i*A] of nucleon k in HO state i,
+// the Gaussians are kept to recognize the SlaterDet again
+typedef struct {
+  int A;
+  int ngauss;
+  int nmax;
+  int dim;
+  double omega;
+  int* ng;
+  Gaussian* G;
+  complex double* amp;
+} HOAmplitudes;
+
 
 // workspace
 
-complex double ampg1[4*HODIMMAX];
-complex double ampg2[4*HODIMMAX];
+// in projection Q is the same for all integration points
+// and Qp is followed by its parity image,
+// ampQr belongs to the unrotated Qp
+static HOAmplitudes ampQ, ampQp, ampQr;
+
+static complex double* amphw = NULL;
+static int amphwsize = 0;
+
+static double* djtab = NULL;
+static int djtabjmax = 0;
+
+// every thread needs its own workspace in parallel projection loops
+#ifdef _OPENMP
+#pragma omp threadprivate(ampQ, ampQp, ampQr, amphw, amphwsize, djtab, djtabjmax)
+#endif
 
 
-// we are recacalculating the amplitudes for the single-particle
-// states again and again !
+// +1 if amplitudes belong to Q, -1 if they belong to parity image of Q
+static int cmpHOAmplitudes(const HOAmplitudes* C,
+			   const DensityMatrixHOPar* par, const SlaterDet* Q)
+{
+  if (C->amp == NULL ||
+      C->A != Q->A || C->ngauss != Q->ngauss ||
+      C->nmax != par->nmax || C->dim != par->dim || C->omega != par->omega)
+    return 0;
+
+  if (memcmp(C->ng, Q->ng, Q->A*sizeof(int)))
+    return 0;
+
+  int same=1, inverted=1;
+  const Gaussian *G, *Gc;
+  int i,c;
+
+  for (i=0; i<Q->ngauss; i++) {
+    G = &Q->G[i]; Gc = &C->G[i];
+
+    if (G->xi != Gc->xi || G->a != Gc->a ||
+	G->chi[0] != Gc->chi[0] || G->chi[1] != Gc->chi[1])
+      return 0;
+
+    for (c=0; c<3; c++) {
+      if (G->b[c] != Gc->b[c]) same = 0;
+      if (G->b[c] != -Gc->b[c]) inverted = 0;
+    }
+    if (!same && !inverted)
+      return 0;
+  }
+
+  return same ? +1 : -1;
+}
 
-// not ease to solve in present framework, let's hope that it's
-// fast enough like it is
 
-static void ob_densmatho(DensityMatrixHOPar* par,
-			 const Gaussian* G1, const Gaussian* G2,
-			 const GaussianAux* X, complex double* rho)
+static void allocHOAmplitudes(const DensityMatrixHOPar* par,
+			      const SlaterDet* Q, HOAmplitudes* C)
 {
-  int nmax = par->nmax;
-  double omega = par->omega;
-  int dim = par->dim;
-
-  amplitudesHOGaussian(G1, nmax, omega, ampg1);
-  amplitudesHOGaussian(G2, nmax, omega, ampg2);
-  
-  int i,j;
-  for (j=0; j<dim; j++)
-   for (i=0; i<dim; i++)
-     rho[i+j*dim] += conj(ampg1[i])*ampg2[j];
+  int A=Q->A; int ngauss=Q->ngauss;
+  int dim=par->dim;
+
+  if (C->A != A || C->ngauss != ngauss || C->dim != dim) {
+    C->ng = realloc(C->ng, A*sizeof(int));
+    C->G = realloc(C->G, ngauss*sizeof(Gaussian));
+    C->amp = realloc(C->amp, A*dim*sizeof(complex double));
+  }
+  C->A = A; C->ngauss = ngauss;
+  C->nmax = par->nmax; C->dim = dim; C->omega = par->omega;
+  memcpy(C->ng, Q->ng, A*sizeof(int));
+  memcpy(C->G, Q->G, ngauss*sizeof(Gaussian));
 }
-  
+
+
+static void calcHOAmplitudes(const DensityMatrixHOPar* par,
+			     const SlaterDet* Q, HOAmplitudes* C)
+{
+  int A=Q->A; int ngauss=Q->ngauss;
+  int dim=par->dim;
+  int i,k,ki;
+
+  int cmp = cmpHOAmplitudes(C, par, Q);
+
+  if (cmp == +1)
+    return;
+
+  // HO states have parity (-1)^l
+  if (cmp == -1) {
+    for (i=0; i<dim; i++)
+      if (ljtotwol(getHOspstate(i)->lj) % 4)
+	for (k=0; k<A; k++)
+	  C->amp[k+i*A] *= -1;
+
+    memcpy(C->G, Q->G, ngauss*sizeof(Gaussian));
+    return;
+  }
+
+  allocHOAmplitudes(par, Q, C);
+
+  complex double ampg[dim];
+
+  for (i=0; i<A*dim; i++)
+    C->amp[i] = 0.0;
+
+  for (k=0; k<A; k++)
+    for (ki=0; ki<Q->ng[k]; ki++) {
+      amplitudesHOGaussian(&Q->G[Q->idx[k]+ki], par->nmax, par->omega, ampg);
+      for (i=0; i<dim; i++)
+	C->amp[k+i*A] += ampg[i];
+    }
+}
+
+
+void rotateDensityMatrixHO(const DensityMatrixHOPar* par, const SlaterDet* Qp,
+			   double alpha, double beta, double gamma)
+{
+  int A=Qp->A;
+  int dim=par->dim;
+  int jmax=2*par->nmax+3;
+  int i,k,m,mp,twoj;
+
+  calcHOAmplitudes(par, Qp, &ampQr);
+
+  // Gaussians rotated exactly as in rotateSlaterDet identify
+  // the amplitudes when Qp rotated is passed to calcHOAmplitudes
+  allocHOAmplitudes(par, Qp, &ampQp);
+
+  double euler[3] = { alpha, beta, gamma };
+  complex double R2[2][2];
+  double R3[3][3];
+  rotatemat2(euler, R2);
+  rotatemat3(euler, R3);
+  for (i=0; i<Qp->ngauss; i++)
+    rotateGaussian(&ampQp.G[i], R3, R2);
+
+  if (djtabjmax < jmax) {
+    djtabjmax = jmax;
+    djtab = realloc(djtab, idxdj(jmax)*sizeof(double));
+  }
+  djmktable(jmax, beta, djtab);
+
+  complex double ea[jmax], eg[jmax];
+  for (m=0; m<jmax; m++) {
+    ea[m] = cexp(-0.5*I*m*alpha);
+    eg[m] = cexp(-0.5*I*m*gamma);
+  }
+
+  // amp'(j,m) = sum_m' D^j_mm' amp(j,m') in every orbit
+  const complex double* amp;
+  const double* d;
+  complex double Dj[jmax][jmax], val;
+
+  for (i=0; i<dim; i+=twoj+1) {
+    twoj = ljtotwoj(getHOspstate(i)->lj);
+    d = djtab+idxdj(twoj);
+    for (mp=0; mp<=twoj; mp++)
+      for (m=0; m<=twoj; m++)
+	Dj[mp][m] = (2*m-twoj < 0 ? conj(ea[twoj-2*m]) : ea[2*m-twoj])*
+	  (2*mp-twoj < 0 ? conj(eg[twoj-2*mp]) : eg[2*mp-twoj])*
+	  d[m+mp*(twoj+1)];
+
+    for (m=0; m<=twoj; m++)
+      for (k=0; k<A; k++) {
+	amp = ampQr.amp+k+i*A;
+	val = 0.0;
+	for (mp=0; mp<=twoj; mp++)
+	  val += Dj[mp][m]*amp[mp*A];
+	ampQp.amp[k+(i+m)*A] = val;
+      }
+  }
+}
+
+
+// amphw = Amp^H o^T
+static void calcHOAmplitudesO(const DensityMatrixHOPar* par,
+			      const SlaterDet* Q, const SlaterDet* Qp,
+			      const SlaterDetAux* X)
+{
+  int A=Q->A;
+  int dim=par->dim;
+
+  calcHOAmplitudes(par, Q, &ampQ);
+  calcHOAmplitudes(par, Qp, &ampQp);
+
+  if (amphwsize < A*dim) {
+    amphwsize = A*dim;
+    amphw = realloc(amphw, amphwsize*sizeof(complex double));
+  }
+
+  char transa='C', transb='T';
+  complex double one=1.0, zero=0.0;
+
+  FORTRAN(zgemm)(&transa, &transb, &dim, &A, &A,
+		 &one, ampQ.amp, &A, X->o, &A,
+		 &zero, amphw, &dim);
+}
+
 
 // density matrix needs not be real ?
-void calcDensityMatrixHO(const DensityMatrixHOPar* par, 
+void calcDensityMatrixHO(const DensityMatrixHOPar* par,
 			 const SlaterDet* Q, const SlaterDetAux* X,
 			 complex double* rho)
 {
   int d = par->dim;
 
-  OneBodyOperator op_ob_densmatho = { dim: d*d, opt: 0, par: par, 
-				      me: ob_densmatho };
-
   calcSlaterDetAuxod(Q, Q, X);
-  calcSlaterDetOBMEod(Q, Q, X, &op_ob_densmatho, rho);
+  calcDensityMatrixHOod(par, Q, Q, X, rho);
 
   int i;
   for (i=0; i<d*d; i++)
@@ -67,79 +257,42 @@ void calcDensityMatrixHO(const DensityMatrixHOPar* par,
 }
 
 
-/*
 void calcDensityMatrixHOod(const DensityMatrixHOPar* par,
 			   const SlaterDet* Q, const SlaterDet* Qp,
 			   const SlaterDetAux* X,
 			   complex double* rho)
 {
-  int d = par->dim;
-
-  OneBodyOperator op_ob_densmatho = { dim: d*d, opt: 0, par: par, 
-				      me: ob_densmatho };
-
-  calcSlaterDetOBMEod(Q, Qp, X, &op_ob_densmatho, rho);
-}
-*/
+  int A=Q->A;
+  int dim=par->dim;
 
+  calcHOAmplitudesO(par, Q, Qp, X);
 
- 
-// workspace
+  char trans='N';
+  complex double ovl=X->ovlap, zero=0.0;
 
-int ngwork = 0;
-complex double *ampgwork;
-complex double *ampgpwork;
+  FORTRAN(zgemm)(&trans, &trans, &dim, &dim, &A,
+		 &ovl, amphw, &dim, ampQp.amp, &A,
+		 &zero, rho, &dim);
+}
 
 
-void calcDensityMatrixHOod(const DensityMatrixHOPar* par,
-			   const SlaterDet* Q, const SlaterDet* Qp, 
-			   const SlaterDetAux* X,
-			   complex double* rho)
+void calcDensityMatrixHOdiagod(const DensityMatrixHOPar* par,
+			       const SlaterDet* Q, const SlaterDet* Qp,
+			       const SlaterDetAux* X,
+			       complex double* rhodiag)
 {
-  int A=Q->A; 
-  int ngauss=Q->ngauss; int ngaussp=Qp->ngauss;
-  int* idx=Q->idx; int* idxp=Qp->idx; 
-  int* ng=Q->ng; int* ngp=Qp->ng;
-  Gaussian* G=Q->G; Gaussian* Gp=Qp->G;
-  GaussianAux* Gaux=X->Gaux;
-  complex double* o=X->o;
-  complex double ovl = X->ovlap;
-
-  int nmax = par->nmax;
-  double omega = par->omega;
-  int dim = par->dim;
-
-  if (ngwork != Q->A*MAXNG) {
-    ngwork = Q->A*MAXNG;
-    ampgwork = malloc(ngwork*dim*sizeof(complex double));
-    ampgpwork = malloc(ngwork*dim*sizeof(complex double));
+  int A=Q->A;
+  int dim=par->dim;
+  complex double* ampp;
+  int i,l;
+
+  calcHOAmplitudesO(par, Q, Qp, X);
+
+  for (i=0; i<dim; i++) {
+    ampp = ampQp.amp+i*A;
+    rhodiag[i] = 0.0;
+    for (l=0; l<A; l++)
+      rhodiag[i] += amphw[i+l*dim]*ampp[l];
+    rhodiag[i] *= X->ovlap;
   }
-
-  complex double (*ampg)[dim] = ampgwork;
-  complex double (*ampgp)[dim] = ampgpwork;
-
-  int i;
-  for (i=0; i<ngauss; i++)
-    amplitudesHOGaussian(&G[i], nmax, omega, ampg[i]);
-  for (i=0; i<ngaussp; i++)
-    amplitudesHOGaussian(&Gp[i], nmax, omega, ampgp[i]);
-
-  int k,l, ki,li, ik,il;
-
-  for (i=0; i<dim*dim; i++)
-    rho[i] = 0.0;
-
-  for (l=0; l<A; l++)
-    for (k=0; k<A; k++) {
-
-      for (li=0; li<ngp[l]; li++)
-	for (ki=0; ki<ng[k]; ki++)
-	  
-	  for (il=0; il<dim; il++)
-	    for (ik=0; ik<dim; ik++)
-	      rho[ik+il*dim] += 
-		conj(ampg[idx[k]+ki][ik])* ampgp[idx[l]+li][il]*
-		o[l+k*A]*ovl;
-
-    }		
-}	
+}
@@ -26,13 +26,26 @@ typedef struct {
 } DensityMatrixHOPar;
 
 
+/// density matrix rho[i+j*dim] = <Q|a^+_i a_j|Q>/<Q|Q>
 void calcDensityMatrixHO(const DensityMatrixHOPar* par, 
 			 const SlaterDet* Q, const SlaterDetAux* X,
 			 complex double* rho);
 
+/// off-diagonal density matrix rho[i+j*dim] = <Q|a^+_i a_j|Qp>
 void calcDensityMatrixHOod(const DensityMatrixHOPar* par,
 			   const SlaterDet* Q, const SlaterDet* Qp,
 			   const SlaterDetAux* X,
 			   complex double* rho);
 
+/// next density matrix is calculated with Qp rotated by alpha, beta, gamma,
+/// its HO amplitudes are obtained by rotating the amplitudes of Qp
+void rotateDensityMatrixHO(const DensityMatrixHOPar* par, const SlaterDet* Qp,
+			   double alpha, double beta, double gamma);
+
+/// diagonal elements rhodiag[i] = <Q|a^+_i a_i|Qp> only
+void calcDensityMatrixHOdiagod(const DensityMatrixHOPar* par,
+			       const SlaterDet* Q, const SlaterDet* Qp,
+			       const SlaterDetAux* X,
+			       complex double* rhodiag);
+
 #endif
@@ -74,6 +74,9 @@ void initOpFormfactors(FormfactorPara* par)
     OpMultipoleFormfactor[i].par = par;
     OpMultipoleFormfactor[i].me = NULL;
   }
+
+  // only the monopole can be projected on its own
+  OpMultipoleFormfactor[0].me = calcMonopoleFormfactorod;
 }
 
 
@@ -81,6 +84,11 @@ void initOpFormfactors(FormfactorPara* par)
 static SlaterDet* Qboost;
 static SlaterDetAux* Xboost;
 
+// recoil boosts happen inside parallel projection loops
+#ifdef _OPENMP
+#pragma omp threadprivate(Qboost, Xboost)
+#endif
+
 static void ob_formfactorq(double q[3],
 			   const Gaussian* G1, const Gaussian* G2,
 			   const GaussianAux* X, complex double ffactor[2])
@@ -130,10 +138,11 @@ void calcFormfactorod(double q[3], int recoil,
 int il[NMULTIPOLES] = {0, 1, 4, 9};
 int diml[NMULTIPOLES] = {1, 3, 5, 7};
 
-void calcMultipoleFormfactorsod(FormfactorPara* par,
-				const SlaterDet* Q, const SlaterDet* Qp,
-				const SlaterDetAux* X,
-				complex double* ffactor)
+// multipoles l < nl
+static void multipoleformfactorsod(const FormfactorPara* par, int nl,
+				   const SlaterDet* Q, const SlaterDet* Qp,
+				   const SlaterDetAux* X,
+				   complex double* ffactor)
 {
   double qmax = par->qmax;
   int ialpha, nalpha = par->nalpha;
@@ -145,7 +154,7 @@ void calcMultipoleFormfactorsod(FormfactorPara* par,
   double q, k[3];
   complex double ff[2];
 
-  for (l=0; l<NMULTIPOLES; l++)
+  for (l=0; l<nl; l++)
     for (t=0; t<2; t++)
       for (i=0; i<npoints; i++)
 	for (m=0; m<diml[l]; m++)
@@ -170,7 +179,7 @@ void calcMultipoleFormfactorsod(FormfactorPara* par,
 	k[2] = q*cos(beta);
 
 	calcFormfactorod(k, recoil, Q, Qp, X, ff);
-	for (l=0; l<NMULTIPOLES; l++)
+	for (l=0; l<nl; l++)
 	  for (t=0; t<2; t++)
 	    for (m=-l; m<=l; m++)
 	      ffactor[m+l + i*diml[l] + t*diml[l]*npoints + il[l]*2*npoints] += 
@@ -180,6 +189,24 @@ void calcMultipoleFormfactorsod(FormfactorPara* par,
 }
 
 
+void calcMultipoleFormfactorsod(FormfactorPara* par,
+				const SlaterDet* Q, const SlaterDet* Qp,
+				const SlaterDetAux* X,
+				complex double* ffactor)
+{
+  multipoleformfactorsod(par, NMULTIPOLES, Q, Qp, X, ffactor);
+}
+
+
+void calcMonopoleFormfactorod(void* par,
+			      const SlaterDet* Q, const SlaterDet* Qp,
+			      const SlaterDetAux* X,
+			      complex double* ffactor)
+{
+  multipoleformfactorsod(par, 1, Q, Qp, X, ffactor);
+}
+
+
 // outpout routines
 
 // Formfactors are saved as F(q) and not as |F(q)|^2 !
@@ -45,6 +45,12 @@ void calcMultipoleFormfactorsod(FormfactorPara* par,
 				const SlaterDetAux* X,
 				complex double* ffactor);
 
+/// monopole formfactor only, as OpMultipoleFormfactor[0]
+void calcMonopoleFormfactorod(void* par,
+			      const SlaterDet* Q, const SlaterDet* Qp,
+			      const SlaterDetAux* X,
+			      complex double* ffactor);
+
 
 void writeChargeFormfactors(FILE* fp,
 			    const Projection* P,
@@ -11,10 +11,12 @@
 
 #include "Gaussian.h"
 
+#include <stdlib.h>
 #include <math.h>
 #include <complex.h>
 
 #include "misc/physics.h"
+#include "misc/utils.h"
 #include "numerics/cmath.h"
 #include "numerics/rotationmatrices.h"
 
@@ -117,3 +119,362 @@ void calcGaussianAux(const Gaussian* G1, const Gaussian* G2, GaussianAux* X)
   X->R = cpow32(2*M_PI*X->alpha)*cexp(0.5*X->pi2/X->lambda);
   X->Q = X->T*X->S*X->R;
 }
+
+
+// swapping the Gaussians conjugates all auxiliaries
+void hermGaussianAux(const GaussianAux* X, GaussianAux* Xh)
+{
+  int i;
+
+  for (i=0; i<3; i++) {
+    Xh->sig[i] = conj(X->sig[i]);
+    Xh->rho[i] = conj(X->rho[i]);
+    Xh->pi[i] = conj(X->pi[i]);
+    Xh->rhoxpi[i] = conj(X->rhoxpi[i]);
+  }
+  Xh->lambda = conj(X->lambda);
+  Xh->alpha = conj(X->alpha);
+  Xh->rho2 = conj(X->rho2);
+  Xh->pi2 = conj(X->pi2);
+  Xh->rhopi = conj(X->rhopi);
+  Xh->T = X->T;
+  Xh->S = conj(X->S);
+  Xh->R = conj(X->R);
+  Xh->Q = conj(X->Q);
+}
+
+
+void allocateGaussianSoA(GaussianSoA* G, int n)
+{
+  double* buf = malloc(14*n*sizeof(double));
+  int i;
+
+  G->n = n;
+  G->xi = malloc(n*sizeof(int));
+  for (i=0; i<2; i++) {
+    G->chire[i] = buf; buf += n;
+    G->chiim[i] = buf; buf += n;
+  }
+  G->are = buf; buf += n;
+  G->aim = buf; buf += n;
+  for (i=0; i<3; i++) {
+    G->bre[i] = buf; buf += n;
+    G->bim[i] = buf; buf += n;
+  }
+}
+
+
+void freeGaussianSoA(GaussianSoA* G)
+{
+  free(G->xi);
+  free(G->chire[0]);
+}
+
+
+void GaussiantoSoA(const Gaussian* G, int n, GaussianSoA* GS)
+{
+  int j, i;
+
+  GS->n = n;
+  for (j=0; j<n; j++) {
+    GS->xi[j] = G[j].xi;
+    for (i=0; i<2; i++) {
+      GS->chire[i][j] = creal(G[j].chi[i]);
+      GS->chiim[i][j] = cimag(G[j].chi[i]);
+    }
+    GS->are[j] = creal(G[j].a);
+    GS->aim[j] = cimag(G[j].a);
+    for (i=0; i<3; i++) {
+      GS->bre[i][j] = creal(G[j].b[i]);
+      GS->bim[i][j] = cimag(G[j].b[i]);
+    }
+  }
+}
+
+
+// Gaussians are processed in chunks of NLANES
+#define NLANES 256
+
+// same as calcGaussianAux, written without library calls for
+// complex functions so that the loop over Gaussians vectorizes
+void calcGaussianAuxrow(const GaussianSoA* G1, const Gaussian* G2, 
+			GaussianAux* X)
+{
+  complex double a2 = G2->a;
+  const complex double* chi2 = G2->chi;
+  const complex double* b2 = G2->b;
+  int xi2 = G2->xi;
+
+  double pre[NLANES], pim[NLANES], ere[NLANES], eim[NLANES];
+  complex double a1, chi1[2], b1[3], p;
+  GaussianAux* Xi;
+  int i0, n, j;
+
+  for (i0=0; i0<G1->n; i0+=NLANES) {
+    n = min(NLANES, G1->n-i0);
+
+#pragma omp simd private(a1, chi1, b1, p, Xi)
+    for (j=0; j<n; j++) {
+      Xi = &X[i0+j];
+
+      // conjugated parameters of G1, inner loops unrolled for vectorizer
+      chi1[0] = G1->chire[0][i0+j] - I*G1->chiim[0][i0+j];
+      chi1[1] = G1->chire[1][i0+j] - I*G1->chiim[1][i0+j];
+      a1 = G1->are[i0+j] - I*G1->aim[i0+j];
+      b1[0] = G1->bre[0][i0+j] - I*G1->bim[0][i0+j];
+      b1[1] = G1->bre[1][i0+j] - I*G1->bim[1][i0+j];
+      b1[2] = G1->bre[2][i0+j] - I*G1->bim[2][i0+j];
+
+      Xi->sig[0] = chi1[0]*chi2[1] + chi1[1]*chi2[0];
+      Xi->sig[1] = I*(chi1[1]*chi2[0] - chi1[0]*chi2[1]);
+      Xi->sig[2] = chi1[0]*chi2[0] - chi1[1]*chi2[1];
+
+      Xi->lambda = 1.0/(a1+a2);
+      Xi->alpha = a1*a2*Xi->lambda;
+      Xi->rho[0] = Xi->lambda*(a2*b1[0]+a1*b2[0]);
+      Xi->rho[1] = Xi->lambda*(a2*b1[1]+a1*b2[1]);
+      Xi->rho[2] = Xi->lambda*(a2*b1[2]+a1*b2[2]);
+      Xi->rho2 = cvec3sqr(Xi->rho);
+      Xi->pi[0] = Xi->lambda*I*(b1[0] - b2[0]);
+      Xi->pi[1] = Xi->lambda*I*(b1[1] - b2[1]);
+      Xi->pi[2] = Xi->lambda*I*(b1[2] - b2[2]);
+      Xi->pi2 = cvec3sqr(Xi->pi);
+      Xi->rhopi = cvec3mult(Xi->rho, Xi->pi);
+      cvec3cross(Xi->rho, Xi->pi, Xi->rhoxpi);
+
+      Xi->T = (1+G1->xi[i0+j]*xi2)/2;
+      Xi->S = chi1[0]*chi2[0] + chi1[1]*chi2[1];
+
+      p = cpow32v(2*M_PI*Xi->alpha);
+      pre[j] = creal(p); pim[j] = cimag(p);
+      p = 0.5*Xi->pi2*(a1+a2);
+      ere[j] = creal(p); eim[j] = cimag(p);
+    }
+
+    cexpv(n, ere, eim);
+
+    for (j=0; j<n; j++) {
+      Xi = &X[i0+j];
+      Xi->R = (pre[j]+I*pim[j])*(ere[j]+I*eim[j]);
+      Xi->Q = Xi->T*Xi->S*Xi->R;
+    }
+  }
+}
+
+
+void calcGaussianAuxinvrow(const GaussianSoA* G1, const Gaussian* G2,
+			   GaussianAuxinv* Y)
+{
+  complex double a2 = G2->a;
+  complex double a1;
+  int j;
+
+#pragma omp simd private(a1)
+  for (j=0; j<G1->n; j++) {
+    a1 = G1->are[j] - I*G1->aim[j];
+    Y[j].lambda = 1.0/(a1+a2);
+    Y[j].alpha = a1*a2*Y[j].lambda;
+    Y[j].R0 = cpow32v(2*M_PI*Y[j].alpha);
+  }
+}
+
+
+// only the quantities depending on the positions and spins have
+// to be calculated, no complex power needed
+void calcGaussianAuxrowinv(const GaussianSoA* G1, const Gaussian* G2, 
+			   const GaussianAuxinv* Y, GaussianAux* X)
+{
+  complex double a2 = G2->a;
+  const complex double* chi2 = G2->chi;
+  const complex double* b2 = G2->b;
+  int xi2 = G2->xi;
+
+  double ere[NLANES], eim[NLANES];
+  complex double a1, chi1[2], b1[3], p;
+  GaussianAux* Xi;
+  int i0, n, j;
+
+  for (i0=0; i0<G1->n; i0+=NLANES) {
+    n = min(NLANES, G1->n-i0);
+
+#pragma omp simd private(a1, chi1, b1, p, Xi)
+    for (j=0; j<n; j++) {
+      Xi = &X[i0+j];
+
+      chi1[0] = G1->chire[0][i0+j] - I*G1->chiim[0][i0+j];
+      chi1[1] = G1->chire[1][i0+j] - I*G1->chiim[1][i0+j];
+      a1 = G1->are[i0+j] - I*G1->aim[i0+j];
+      b1[0] = G1->bre[0][i0+j] - I*G1->bim[0][i0+j];
+      b1[1] = G1->bre[1][i0+j] - I*G1->bim[1][i0+j];
+      b1[2] = G1->bre[2][i0+j] - I*G1->bim[2][i0+j];
+
+      Xi->sig[0] = chi1[0]*chi2[1] + chi1[1]*chi2[0];
+      Xi->sig[1] = I*(chi1[1]*chi2[0] - chi1[0]*chi2[1]);
+      Xi->sig[2] = chi1[0]*chi2[0] - chi1[1]*chi2[1];
+
+      Xi->lambda = Y[i0+j].lambda;
+      Xi->alpha = Y[i0+j].alpha;
+      Xi->rho[0] = Xi->lambda*(a2*b1[0]+a1*b2[0]);
+      Xi->rho[1] = Xi->lambda*(a2*b1[1]+a1*b2[1]);
+      Xi->rho[2] = Xi->lambda*(a2*b1[2]+a1*b2[2]);
+      Xi->rho2 = cvec3sqr(Xi->rho);
+      Xi->pi[0] = Xi->lambda*I*(b1[0] - b2[0]);
+      Xi->pi[1] = Xi->lambda*I*(b1[1] - b2[1]);
+      Xi->pi[2] = Xi->lambda*I*(b1[2] - b2[2]);
+      Xi->pi2 = cvec3sqr(Xi->pi);
+      Xi->rhopi = cvec3mult(Xi->rho, Xi->pi);
+      cvec3cross(Xi->rho, Xi->pi, Xi->rhoxpi);
+
+      Xi->T = (1+G1->xi[i0+j]*xi2)/2;
+      Xi->S = chi1[0]*chi2[0] + chi1[1]*chi2[1];
+
+      p = 0.5*Xi->pi2*(a1+a2);
+      ere[j] = creal(p); eim[j] = cimag(p);
+    }
+
+    cexpv(n, ere, eim);
+
+    for (j=0; j<n; j++) {
+      Xi = &X[i0+j];
+      Xi->R = Y[i0+j].R0*(ere[j]+I*eim[j]);
+      Xi->Q = Xi->T*Xi->S*Xi->R;
+    }
+  }
+}
+
+
+// b of G2 changes sign under parity, spin, width and isospin dependent
+// parts are shared, exponentials for both parities in one call
+void calcGaussianAuxrowinvparity(const GaussianSoA* G1, const Gaussian* G2, 
+				 const GaussianAuxinv* Y, 
+				 GaussianAux* X, GaussianAux* Xp)
+{
+  complex double a2 = G2->a;
+  const complex double* chi2 = G2->chi;
+  const complex double* b2 = G2->b;
+  int xi2 = G2->xi;
+
+  double ere[2*NLANES], eim[2*NLANES];
+  complex double a1, chi1[2], b1[3], ab1[3], ab2[3], p;
+  GaussianAux *Xi, *Xpi;
+  int i0, n, j;
+
+  for (i0=0; i0<G1->n; i0+=NLANES) {
+    n = min(NLANES, G1->n-i0);
+
+#pragma omp simd private(a1, chi1, b1, ab1, ab2, p, Xi, Xpi)
+    for (j=0; j<n; j++) {
+      Xi = &X[i0+j]; Xpi = &Xp[i0+j];
+
+      chi1[0] = G1->chire[0][i0+j] - I*G1->chiim[0][i0+j];
+      chi1[1] = G1->chire[1][i0+j] - I*G1->chiim[1][i0+j];
+      a1 = G1->are[i0+j] - I*G1->aim[i0+j];
+      b1[0] = G1->bre[0][i0+j] - I*G1->bim[0][i0+j];
+      b1[1] = G1->bre[1][i0+j] - I*G1->bim[1][i0+j];
+      b1[2] = G1->bre[2][i0+j] - I*G1->bim[2][i0+j];
+
+      Xi->sig[0] = Xpi->sig[0] = chi1[0]*chi2[1] + chi1[1]*chi2[0];
+      Xi->sig[1] = Xpi->sig[1] = I*(chi1[1]*chi2[0] - chi1[0]*chi2[1]);
+      Xi->sig[2] = Xpi->sig[2] = chi1[0]*chi2[0] - chi1[1]*chi2[1];
+
+      Xi->lambda = Xpi->lambda = Y[i0+j].lambda;
+      Xi->alpha = Xpi->alpha = Y[i0+j].alpha;
+
+      ab1[0] = a2*b1[0]; ab1[1] = a2*b1[1]; ab1[2] = a2*b1[2];
+      ab2[0] = a1*b2[0]; ab2[1] = a1*b2[1]; ab2[2] = a1*b2[2];
+
+      Xi->rho[0] = Xi->lambda*(ab1[0]+ab2[0]);
+      Xi->rho[1] = Xi->lambda*(ab1[1]+ab2[1]);
+      Xi->rho[2] = Xi->lambda*(ab1[2]+ab2[2]);
+      Xi->rho2 = cvec3sqr(Xi->rho);
+      Xi->pi[0] = Xi->lambda*I*(b1[0] - b2[0]);
+      Xi->pi[1] = Xi->lambda*I*(b1[1] - b2[1]);
+      Xi->pi[2] = Xi->lambda*I*(b1[2] - b2[2]);
+      Xi->pi2 = cvec3sqr(Xi->pi);
+      Xi->rhopi = cvec3mult(Xi->rho, Xi->pi);
+      cvec3cross(Xi->rho, Xi->pi, Xi->rhoxpi);
+
+      Xpi->rho[0] = Xpi->lambda*(ab1[0]-ab2[0]);
+      Xpi->rho[1] = Xpi->lambda*(ab1[1]-ab2[1]);
+      Xpi->rho[2] = Xpi->lambda*(ab1[2]-ab2[2]);
+      Xpi->rho2 = cvec3sqr(Xpi->rho);
+      Xpi->pi[0] = Xpi->lambda*I*(b1[0] + b2[0]);
+      Xpi->pi[1] = Xpi->lambda*I*(b1[1] + b2[1]);
+      Xpi->pi[2] = Xpi->lambda*I*(b1[2] + b2[2]);
+      Xpi->pi2 = cvec3sqr(Xpi->pi);
+      Xpi->rhopi = cvec3mult(Xpi->rho, Xpi->pi);
+      cvec3cross(Xpi->rho, Xpi->pi, Xpi->rhoxpi);
+
+      Xi->T = Xpi->T = (1+G1->xi[i0+j]*xi2)/2;
+      Xi->S = Xpi->S = chi1[0]*chi2[0] + chi1[1]*chi2[1];
+
+      p = 0.5*Xi->pi2*(a1+a2);
+      ere[j] = creal(p); eim[j] = cimag(p);
+      p = 0.5*Xpi->pi2*(a1+a2);
+      ere[n+j] = creal(p); eim[n+j] = cimag(p);
+    }
+
+    cexpv(2*n, ere, eim);
+
+    for (j=0; j<n; j++) {
+      Xi = &X[i0+j]; Xpi = &Xp[i0+j];
+      Xi->R = Y[i0+j].R0*(ere[j]+I*eim[j]);
+      Xi->Q = Xi->T*Xi->S*Xi->R;
+      Xpi->R = Y[i0+j].R0*(ere[n+j]+I*eim[n+j]);
+      Xpi->Q = Xpi->T*Xpi->S*Xpi->R;
+    }
+  }
+}
+
+
+void allocateGaussianAuxSoA(GaussianAuxSoA* XS, int n)
+{
+  double* buf = malloc(18*n*sizeof(double));
+  int i;
+
+  XS->n = n;
+  XS->xi2 = malloc(3*n*sizeof(int));
+  XS->xi4 = XS->xi2+n;
+  XS->T = XS->xi2+2*n;
+  XS->Sre = buf; buf += n;
+  XS->Sim = buf; buf += n;
+  XS->Rre = buf; buf += n;
+  XS->Rim = buf; buf += n;
+  for (i=0; i<3; i++) {
+    XS->sigre[i] = buf; buf += n;
+    XS->sigim[i] = buf; buf += n;
+  }
+  XS->alphare = buf; buf += n;
+  XS->alphaim = buf; buf += n;
+  for (i=0; i<3; i++) {
+    XS->rhore[i] = buf; buf += n;
+    XS->rhoim[i] = buf; buf += n;
+  }
+}
+
+
+void freeGaussianAuxSoA(GaussianAuxSoA* XS)
+{
+  free(XS->xi2);
+  free(XS->Sre);
+}
+
+
+void GaussianAuxtoSoA(const Gaussian* G2, const Gaussian* G4,
+		      const GaussianAux* X, GaussianAuxSoA* XS, int j)
+{
+  int i;
+
+  XS->xi2[j] = G2->xi;
+  XS->xi4[j] = G4->xi;
+  XS->T[j] = X->T;
+  XS->Sre[j] = creal(X->S); XS->Sim[j] = cimag(X->S);
+  XS->Rre[j] = creal(X->R); XS->Rim[j] = cimag(X->R);
+  for (i=0; i<3; i++) {
+    XS->sigre[i][j] = creal(X->sig[i]); XS->sigim[i][j] = cimag(X->sig[i]);
+  }
+  XS->alphare[j] = creal(X->alpha); XS->alphaim[j] = cimag(X->alpha);
+  for (i=0; i<3; i++) {
+    XS->rhore[i][j] = creal(X->rho[i]); XS->rhoim[i][j] = cimag(X->rho[i]);
+  }
+}
@@ -24,6 +24,20 @@ typedef struct {
 } Gaussian;
 
 
+/// Set of Gaussians as structure of arrays, real and imaginary parts
+/// stored separately, used in vectorized loops over Gaussians
+typedef struct {
+  int n;			///< number of Gaussians
+  int* xi;
+  double* chire[2];
+  double* chiim[2];
+  double* are;
+  double* aim;
+  double* bre[3];
+  double* bim[3];
+} GaussianSoA;
+
+
 /// Auxiliary quantities for matrix elements with Gaussians.
 /// Definitions as given in the diploma thesis
 typedef struct {
@@ -43,6 +57,35 @@ typedef struct {
 } GaussianAux;
 
 
+/// Auxiliary quantities of a pair of Gaussians depending only on 
+/// the widths, invariant under translations, rotations and parity
+typedef struct {
+  complex double lambda;
+  complex double alpha;
+  complex double R0;		///< (2 pi alpha)^3/2
+} GaussianAuxinv;
+
+
+/// Auxiliary quantities needed for central and Coulomb potentials
+/// for a set of Gaussian pairs (2,4) as structure of arrays
+typedef struct {
+  int n;			///< number of pairs
+  int* xi2;			///< isospin of Gaussian 2
+  int* xi4;			///< isospin of Gaussian 4
+  int* T;
+  double* Sre;
+  double* Sim;
+  double* Rre;
+  double* Rim;
+  double* sigre[3];
+  double* sigim[3];
+  double* alphare;
+  double* alphaim;
+  double* rhore[3];
+  double* rhoim[3];
+} GaussianAuxSoA;
+
+
 /// One-body operator.
 /// generic definition of an operator that calculates matrix elements
 /// with Gaussian one-body states. matrix elements will be added to 
@@ -58,11 +101,20 @@ typedef struct {
 } OneBodyOperator;
 
 
+/// Options for two-body operators.
+/// OPTTPROP: matrix element is proportional to the isospin overlaps T,
+/// OPTCHARGE: matrix element vanishes unless the isospins of (G1,G2)
+/// are those of (G3,G4) or (G4,G3)
+#define OPTTPROP 1
+#define OPTCHARGE 2
+
+
 /// Two-body operator.
 /// generic definition of an operator that calculates matrix elements
 /// with Gaussian one-body states. matrix elements will be added to 
 /// val[dim]. If the matrix element is proportional to the isospin
-/// overlap T opt should be set to true.
+/// overlap T opt should be set to true (OPTTPROP), charge conserving 
+/// operators can set OPTCHARGE to skip isospin forbidden quadruples.
 typedef struct {
   int dim;
   int opt;
@@ -72,12 +124,65 @@ typedef struct {
 	     const Gaussian* G3, const Gaussian* G4,
 	     const GaussianAux* X13, const GaussianAux* X24,
 	     complex double val[]);
+  /// optional vectorized version: adds the matrix elements for the pairs 
+  /// (G2,G4) in X24 weighted with w = (wre, wim) summed over all pairs
+  void (*melanes)(void* parameters,
+		  const Gaussian* G1, const Gaussian* G3,
+		  const GaussianAux* X13, const GaussianAuxSoA* X24,
+		  const double* wre, const double* wim,
+		  complex double val[]);
 } TwoBodyOperator;
 
 
 /// calculate auxiliary quantities for two Gaussians
 void calcGaussianAux(const Gaussian* ga, const Gaussian* gb, GaussianAux* aux);
 
+/// auxiliary quantities for gb, ga from the auxiliaries for ga, gb
+void hermGaussianAux(const GaussianAux* aux, GaussianAux* auxh);
+
+
+/// allocate memory for n Gaussians in SoA
+void allocateGaussianSoA(GaussianSoA* G, int n);
+
+/// free memory used by G
+void freeGaussianSoA(GaussianSoA* G);
+
+/// copy n Gaussians G into GS
+void GaussiantoSoA(const Gaussian* G, int n, GaussianSoA* GS);
+
+/// calculate auxiliary quantities aux[i] for Gaussians ga[i] and gb
+/// for all Gaussians in ga, vectorized
+void calcGaussianAuxrow(const GaussianSoA* ga, const Gaussian* gb, 
+			GaussianAux* aux);
+
+
+/// calculate invariant auxiliaries Y[i] for Gaussians ga[i] and gb
+void calcGaussianAuxinvrow(const GaussianSoA* ga, const Gaussian* gb,
+			   GaussianAuxinv* Y);
+
+/// same as calcGaussianAuxrow with the invariant auxiliaries Y[i]
+/// of ga[i] and gb already calculated
+void calcGaussianAuxrowinv(const GaussianSoA* ga, const Gaussian* gb, 
+			   const GaussianAuxinv* Y, GaussianAux* aux);
+
+
+/// same as calcGaussianAuxrowinv, calculates in addition auxp[i] for
+/// Gaussians ga[i] and gb inverted, sharing the parity independent parts
+void calcGaussianAuxrowinvparity(const GaussianSoA* ga, const Gaussian* gb, 
+				 const GaussianAuxinv* Y, 
+				 GaussianAux* aux, GaussianAux* auxp);
+
+
+/// allocate memory for n pairs in XS
+void allocateGaussianAuxSoA(GaussianAuxSoA* XS, int n);
+
+/// free memory used by XS
+void freeGaussianAuxSoA(GaussianAuxSoA* XS);
+
+/// store auxiliaries X for Gaussians G2, G4 as pair i in XS
+void GaussianAuxtoSoA(const Gaussian* G2, const Gaussian* G4,
+		      const GaussianAux* X, GaussianAuxSoA* XS, int i);
+
 
 /// move Gaussian by d
 void moveGaussian(Gaussian* g, double d[3]);
@@ -16,14 +16,10 @@
 #include <fmd/Gaussian.h>
 
 
-// implemented for basis up to Nmax = HONMAX 
+// default basis cut off, the basis itself is not limited
 
 #define HONMAX 8
 
-// dim(harmonic oscillator)
-
-#define HODIMMAX (HONMAX+1)*(HONMAX+2)*(HONMAX+3)/6
-
 
 // harmonic oscillator single-particle states
 
@@ -35,6 +31,7 @@ typedef struct {
 } HOSPState;
 
 
+/// basis up to shell nmax, can be called again with other nmax
 void initHOBasis(int nmax);
 
 int dimHOBasis(int nmax);
@@ -350,3 +350,17 @@ int readInteractionfromFile(Interaction* P, char* fname)
   return 0;
 }
 
+
+int Interactionfeatures(const Interaction* P)
+{
+  return ((P->spinorbit ? FEATSPINORBIT : 0) |
+	  (P->tensor ? FEATTENSOR : 0) |
+	  (P->momentump2 ? FEATMOMENTUMP2 : 0) |
+	  (P->momentumpr2 ? FEATMOMENTUMPR2 : 0) |
+	  (P->l2 ? FEATL2 : 0) |
+	  (P->l2ls ? FEATL2LS : 0) |
+	  (P->tll ? FEATTLL : 0) |
+	  (P->tpp ? FEATTPP : 0) |
+	  (P->l2tpp ? FEATL2TPP : 0) |
+	  (P->prtrp ? FEATPRTRP : 0));
+}
@@ -70,7 +70,32 @@ typedef struct {
 } Interaction;
 
 
+/// features of an interaction as bitmask,
+/// used to select specialized potential kernels
+#define FEATSPINORBIT	0x001
+#define FEATTENSOR	0x002
+#define FEATMOMENTUMP2	0x004
+#define FEATMOMENTUMPR2	0x008
+#define FEATL2		0x010
+#define FEATL2LS	0x020
+#define FEATTLL		0x040
+#define FEATTPP		0x080
+#define FEATL2TPP	0x100
+#define FEATPRTRP	0x200
+#define FEATALL		0x3ff
+
+/// feature sets of the specialized potential kernels
+#define KERNELCENTRAL	0			///< central and Coulomb (Volkov)
+#define KERNELCENTRALLS	(FEATSPINORBIT)		///< with spin-orbit
+#define KERNELTENSOR	(FEATSPINORBIT | FEATTENSOR | FEATMOMENTUMP2 | \
+			 FEATL2 | FEATTLL | FEATPRTRP)	///< UCOM/SRG
+#define KERNELALL	FEATALL
+
+
 int readInteractionfromFile(Interaction* pot, char* filename);
 
+/// features used by interaction P
+int Interactionfeatures(const Interaction* P);
+
 #endif
 
@@ -34,15 +34,31 @@ static void ob_isospin(void* par,
 }
 
 
-static void tb_isospin(void* par,
-		       const Gaussian* G1, const Gaussian* G2, 
-		       const Gaussian* G3, const Gaussian* G4, 
-		       const GaussianAux* X13, const GaussianAux* X24, 
-		       complex double* t2)
-{	
-  *t2 += 0.5*(((1-G1->xi*G3->xi)*(1-G2->xi*G4->xi))/4+
-	      (G1->xi*G4->xi+G2->xi*G3->xi)/2)*
-         X13->S* X24->S* X13->R* X24->R;
+// two-body part is separable: 2 t.t = 2 t3 t3 + t+ t- + t- t+
+static void sep_isospin(const void* par,
+			const Gaussian* G1, const Gaussian* G2, 
+			const GaussianAux* X, complex double t[3])
+{
+  t[0] += (G1->xi == +1 ? 0.5 : -0.5)* X->Q;
+  if (G1->xi == +1 && G2->xi == -1)
+    t[1] += X->S* X->R;
+  if (G1->xi == -1 && G2->xi == +1)
+    t[2] += X->S* X->R;
+}
+
+static const SeparableTerm sep_t2[2] = {
+  {0, 0, 0, 2.0}, {0, 1, 2, 2.0}
+};
+
+
+void initIsospinoperators(OneBodyOperator* ob, SeparableOperator* tb)
+{
+  OneBodyOperator op_ob_isospin = {dim: 1, opt: 1, par: NULL, me: ob_isospin};
+  SeparableOperator op_tb_isospin = {dim: 1, nob: 3, opt: 0, par: NULL,
+				     me: sep_isospin, nterms: 2, terms: sep_t2};
+
+  *ob = op_ob_isospin;
+  *tb = op_tb_isospin;
 }
 
 
@@ -51,11 +67,12 @@ void calcIsospin(const SlaterDet* Q, const SlaterDetAux* X,
 {
   double isoone, isotwo;
   OneBodyOperator op_ob_isospin = {dim: 1, opt: 1, par: NULL, me: ob_isospin};
-  TwoBodyOperator op_tb_isospin = {dim: 1, opt: 0, par: NULL, me: tb_isospin};
+  SeparableOperator op_tb_isospin = {dim: 1, nob: 3, opt: 0, par: NULL,
+				     me: sep_isospin, nterms: 2, terms: sep_t2};
 
 
   calcSlaterDetOBME(Q, X, &op_ob_isospin, &isoone);
-  calcSlaterDetTBME(Q, X, &op_tb_isospin, &isotwo);
+  calcSlaterDetSepME(Q, X, &op_tb_isospin, &isotwo);
 
   *t2 = isoone+isotwo;
 }
@@ -67,10 +84,11 @@ void calcIsospinod(const SlaterDet* Q, const SlaterDet* Qp,
 {
   complex double isoone, isotwo;
   OneBodyOperator op_ob_isospin = {dim: 1, opt: 1, par: NULL, me: ob_isospin};
-  TwoBodyOperator op_tb_isospin = {dim: 1, opt: 0, par: NULL, me: tb_isospin};
+  SeparableOperator op_tb_isospin = {dim: 1, nob: 3, opt: 0, par: NULL,
+				     me: sep_isospin, nterms: 2, terms: sep_t2};
 
   calcSlaterDetOBMEod(Q, Qp, X, &op_ob_isospin, &isoone);
-  calcSlaterDetTBMEod(Q, Qp, X, &op_tb_isospin, &isotwo);
+  calcSlaterDetSepMEod(Q, Qp, X, &op_tb_isospin, &isotwo);
 
   *t2 = isoone+isotwo;
 }
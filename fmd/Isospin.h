@@ -16,6 +16,9 @@
 #include "SlaterDet.h"
 
 
+/// one- and two-body operators used by calcIsospin
+void initIsospinoperators(OneBodyOperator* ob, SeparableOperator* tb);
+
 void calcIsospin(const SlaterDet* Q, const SlaterDetAux* X, 
 		 double* t2);
 
@@ -0,0 +1,486 @@
+/**
+
+  \file MEDatabase.c
+
+  indexed append-only database for projected matrix elements
+
+  file layout: header with operator and projection, followed by
+  records of fixed size, every record starts with the key
+  (md5a, md5b, Sa, Sb) and the angular grid of adaptive integration,
+  followed by the dim used matrix elements of every m, k for all p, j
+  in the idxpij, idxjmk layout used in memory
+
+  records are only appended while holding an exclusive lock on the
+  file, readers hold a shared lock, so that several processes
+  can share the same database
+
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+#include "SlaterDet.h"
+#include "Projection.h"
+#include "Symmetry.h"
+#include "MEDatabase.h"
+
+#include "misc/utils.h"
+
+
+#define SQR(x) ((x)*(x))
+
+#define MEDBMAGIC "FMDMEDB"
+#define MEDBVERSION 3
+
+typedef struct {
+  char magic[8];
+  int version;
+  int jmax, odd;
+  int rank, dim, size;
+  char opname[80];
+  char projection[PROJSTRLEN];
+  long int n;			///< number of complex doubles per record
+} medbheader;
+
+typedef struct {
+  char md5a[33], md5b[33];
+  Symmetry Sa, Sb;
+} medbkey;
+
+typedef struct {
+  medbkey key;
+  int grid[3];			///< projectedMBMEinfo grid
+} medbrecord;
+
+typedef struct {
+  char fname[255];
+  int fd;
+  long int n;			///< number of complex doubles per record
+  long int nrec;		///< number of records indexed
+  long int maxrec;
+  medbkey* key;
+  long int nhash;
+  long int* hash;		///< record number or -1
+} medb;
+
+
+#define MAXMEDB 16
+
+static medb db[MAXMEDB];
+static int ndb = 0;
+
+static int usedb = 0;
+
+
+void useMEDatabase(int flag)
+{
+  usedb = flag;
+}
+
+
+int usingMEDatabase(void)
+{
+  return usedb;
+}
+
+
+// remember md5 sums of many-body files, rehash only if file changed,
+// files replaced by rename have a new inode
+
+#define MAXMD5 1024
+
+static struct {
+  char fname[255];
+  struct timespec mtime;
+  dev_t dev;
+  ino_t ino;
+  off_t size;
+  char md5[33];
+} md5cache[MAXMD5];
+static int nmd5 = 0;
+
+static const char* cachedmd5hash(const char* fname)
+{
+  struct stat st;
+  int i;
+
+  // names not fitting into the cache are not cached
+  if (stat(fname, &st) || strlen(fname) >= sizeof(md5cache[0].fname))
+    return md5hash(fname);
+
+  for (i=0; i<nmd5; i++)
+    if (!strcmp(md5cache[i].fname, fname) &&
+	md5cache[i].mtime.tv_sec == st.st_mtim.tv_sec &&
+	md5cache[i].mtime.tv_nsec == st.st_mtim.tv_nsec &&
+	md5cache[i].dev == st.st_dev && md5cache[i].ino == st.st_ino &&
+	md5cache[i].size == st.st_size)
+      return md5cache[i].md5;
+
+  // new file or file was modified
+  for (i=0; i<nmd5; i++)
+    if (!strcmp(md5cache[i].fname, fname))
+      break;
+  if (i == MAXMD5)
+    i = 0;
+  if (i == nmd5)
+    nmd5++;
+
+  char* md5 = md5hash(fname);
+  strcpy(md5cache[i].fname, fname);
+  md5cache[i].mtime = st.st_mtim;
+  md5cache[i].dev = st.st_dev;
+  md5cache[i].ino = st.st_ino;
+  md5cache[i].size = st.st_size;
+  strncpy(md5cache[i].md5, md5, 33);
+  free(md5);
+
+  return md5cache[i].md5;
+}
+
+
+static unsigned long int hashkey(const medbkey* k)
+{
+  // FNV-1a
+  unsigned long int h = 2166136261u;
+  int i;
+  for (i=0; i<32; i++) {
+    h ^= (unsigned char) k->md5a[i]; h *= 16777619u;
+    h ^= (unsigned char) k->md5b[i]; h *= 16777619u;
+  }
+  h ^= k->Sa; h *= 16777619u;
+  h ^= k->Sb; h *= 16777619u;
+
+  return h;
+}
+
+
+static int equalkey(const medbkey* k, const medbkey* l)
+{
+  return (!strncmp(k->md5a, l->md5a, 32) && !strncmp(k->md5b, l->md5b, 32) &&
+	  k->Sa == l->Sa && k->Sb == l->Sb);
+}
+
+
+static long int findkey(const medb* d, const medbkey* k)
+{
+  if (!d->nhash)
+    return -1;
+
+  long int h = hashkey(k) % d->nhash;
+  while (d->hash[h] >= 0) {
+    if (equalkey(&d->key[d->hash[h]], k))
+      return d->hash[h];
+    h = (h+1) % d->nhash;
+  }
+
+  return -1;
+}
+
+
+static void rehash(medb* d, long int nhash)
+{
+  long int i, h;
+
+  free(d->hash);
+  d->nhash = nhash;
+  d->hash = malloc(nhash*sizeof(long int));
+  for (h=0; h<nhash; h++)
+    d->hash[h] = -1;
+
+  for (i=0; i<d->nrec; i++) {
+    h = hashkey(&d->key[i]) % d->nhash;
+    while (d->hash[h] >= 0)
+      h = (h+1) % d->nhash;
+    d->hash[h] = i;
+  }
+}
+
+
+// add key as record nrec to index
+static void addkey(medb* d, const medbkey* k)
+{
+  if (d->nrec == d->maxrec) {
+    d->maxrec = (d->maxrec ? 2*d->maxrec : 256);
+    d->key = realloc(d->key, d->maxrec*sizeof(medbkey));
+  }
+  d->key[d->nrec] = *k;
+  d->nrec++;
+
+  // keep hash table at most half filled
+  if (2*d->nrec > d->nhash)
+    rehash(d, 4*d->nrec);
+  else {
+    long int h = hashkey(k) % d->nhash;
+    while (d->hash[h] >= 0)
+      h = (h+1) % d->nhash;
+    d->hash[h] = d->nrec-1;
+  }
+}
+
+
+static off_t recordsize(const medb* d)
+{
+  return sizeof(medbrecord)+d->n*sizeof(complex double);
+}
+
+
+static off_t recordoffset(const medb* d, long int i)
+{
+  return sizeof(medbheader)+i*recordsize(d);
+}
+
+
+// index records appended by other processes, caller has to hold lock
+// incomplete records at the end of the file are ignored
+static void scanMEdb(medb* d)
+{
+  struct stat st;
+  medbkey k;
+  long int i, nrec;
+
+  if (fstat(d->fd, &st))
+    return;
+
+  nrec = (st.st_size-sizeof(medbheader))/recordsize(d);
+  for (i=d->nrec; i<nrec; i++) {
+    if (pread(d->fd, &k, sizeof(medbkey), recordoffset(d, i)) != sizeof(medbkey))
+      break;
+    addkey(d, &k);
+  }
+}
+
+
+// operator name and projection identify the database,
+// they are never truncated
+static int initheader(medbheader* h,
+		      const Projection* P, const ManyBodyOperator* Op)
+{
+  int p, j;
+
+  if (strlen(Op->name) >= sizeof(h->opname)) {
+    fprintf(stderr, "... operator name %s too long for database header\n",
+	    Op->name);
+    return -1;
+  }
+
+  char* projstr = ProjectiontoStr(P);
+
+  memset(h, 0, sizeof(medbheader));
+  memcpy(h->magic, MEDBMAGIC, 8);
+  h->version = MEDBVERSION;
+  h->jmax = P->jmax; h->odd = P->odd;
+  h->rank = Op->rank; h->dim = Op->dim; h->size = Op->size;
+  strcpy(h->opname, Op->name);
+  strcpy(h->projection, projstr);
+  free(projstr);
+  h->n = 0;
+  for (p=0; p<=1; p++)
+    for (j=P->odd; j<P->jmax; j=j+2)
+      h->n += SQR(j+1)*(Op->rank+1)*Op->dim;
+
+  return 0;
+}
+
+
+static medb* openMEdb(const Projection* P, const ManyBodyOperator* Op,
+		      int create)
+{
+  char fname[255];
+  int i;
+
+  medbheader h, fh;
+  if (initheader(&h, P, Op))
+    return NULL;
+
+  if (snprintf(fname, 255, "ME/%s--%s.medb", Op->name, h.projection) >= 255) {
+    fprintf(stderr, "... database name for %s too long\n", Op->name);
+    return NULL;
+  }
+
+  for (i=0; i<ndb; i++)
+    if (!strcmp(db[i].fname, fname))
+      return &db[i];
+
+  if (ndb == MAXMEDB) {
+    fprintf(stderr, "... too many matrix element databases open\n");
+    return NULL;
+  }
+
+  int fd = open(fname, O_RDWR | (create ? O_CREAT : 0), 0644);
+  if (fd < 0) {
+    if (create)
+      fprintf(stderr, "... couldn't open database %s\n", fname);
+    return NULL;
+  }
+
+  // first process creates header
+  flock(fd, LOCK_EX);
+  if (pread(fd, &fh, sizeof(medbheader), 0) != sizeof(medbheader)) {
+    if (pwrite(fd, &h, sizeof(medbheader), 0) != sizeof(medbheader)) {
+      fprintf(stderr, "... couldn't write header of database %s\n", fname);
+      flock(fd, LOCK_UN);
+      close(fd);
+      return NULL;
+    }
+    fh = h;
+  }
+  flock(fd, LOCK_UN);
+
+  if (memcmp(&fh, &h, sizeof(medbheader))) {
+    fprintf(stderr, "... database %s does not match %s matrix elements\n",
+	    fname, Op->name);
+    close(fd);
+    return NULL;
+  }
+
+  medb* d = &db[ndb++];
+  strcpy(d->fname, fname);
+  d->fd = fd;
+  d->n = h.n;
+  d->nrec = 0;
+  d->maxrec = 0;
+  d->key = NULL;
+  d->nhash = 0;
+  d->hash = NULL;
+
+  return d;
+}
+
+
+static void initkey(medbkey* k, const char* mbfilea, const char* mbfileb,
+		    Symmetry Sa, Symmetry Sb)
+{
+  memset(k, 0, sizeof(medbkey));
+  strncpy(k->md5a, cachedmd5hash(mbfilea), 32);
+  strncpy(k->md5b, cachedmd5hash(mbfileb), 32);
+  k->Sa = Sa;
+  k->Sb = Sb;
+}
+
+
+int readprojectedMBMEfromDatabase(const char* mbfilea, const char* mbfileb,
+				  const Projection* P,
+				  const ManyBodyOperator* Op,
+				  Symmetry Sa, Symmetry Sb,
+				  void* me)
+{
+  complex double** mbme = me;
+  int jmax = P->jmax;
+  int rowsize = (Op->rank+1)*Op->dim;
+  int stride = (Op->rank+1)*Op->size;
+  int p, j, mk;
+
+  medb* d = openMEdb(P, Op, 0);
+  if (!d)
+    return -1;
+
+  medbkey k;
+  initkey(&k, mbfilea, mbfileb, Sa, Sb);
+
+  flock(d->fd, LOCK_SH);
+
+  long int i = findkey(d, &k);
+  if (i < 0) {
+    scanMEdb(d);
+    i = findkey(d, &k);
+  }
+
+  int res = -1;
+  char* buf = NULL;
+  if (i >= 0) {
+    buf = malloc(recordsize(d));
+    if (pread(d->fd, buf, recordsize(d), recordoffset(d, i)) == recordsize(d))
+      res = 0;
+  }
+
+  flock(d->fd, LOCK_UN);
+
+  if (!res) {
+    const medbrecord* rec = (const medbrecord*) buf;
+    const complex double* val = (const complex double*) (buf+sizeof(medbrecord));
+    for (p=0; p<=1; p++)
+      for (j=P->odd; j<jmax; j=j+2)
+	for (mk=0; mk<SQR(j+1); mk++) {
+	  memcpy(mbme[idxpij(jmax,p,j)]+mk*stride, val,
+		 rowsize*sizeof(complex double));
+	  val += rowsize;
+	}
+
+    projectedMBMEinfo* info = getprojectedMBMEinfo(P, me);
+    if (info)
+      memcpy(info->grid, rec->grid, sizeof(info->grid));
+  }
+  free(buf);
+
+  if (!res)
+    fprintf(stderr, "... reading matrix elements from database %s\n", d->fname);
+
+  return res;
+}
+
+
+int writeprojectedMBMEtoDatabase(const char* mbfilea, const char* mbfileb,
+				 const Projection* P,
+				 const ManyBodyOperator* Op,
+				 Symmetry Sa, Symmetry Sb,
+				 const void* me)
+{
+  complex double* const* mbme = (complex double* const*) me;
+  int jmax = P->jmax;
+  int rowsize = (Op->rank+1)*Op->dim;
+  int stride = (Op->rank+1)*Op->size;
+  int p, j, mk;
+
+  ensuredir("ME");
+
+  medb* d = openMEdb(P, Op, 1);
+  if (!d)
+    return -1;
+
+  medbkey k;
+  initkey(&k, mbfilea, mbfileb, Sa, Sb);
+
+  // assemble record before taking the lock
+  char* buf = malloc(recordsize(d));
+  medbrecord* rec = (medbrecord*) buf;
+  complex double* val = (complex double*) (buf+sizeof(medbrecord));
+  memset(rec, 0, sizeof(medbrecord));
+  rec->key = k;
+  const projectedMBMEinfo* info = getprojectedMBMEinfo(P, me);
+  if (info)
+    memcpy(rec->grid, info->grid, sizeof(rec->grid));
+  for (p=0; p<=1; p++)
+    for (j=P->odd; j<jmax; j=j+2)
+      for (mk=0; mk<SQR(j+1); mk++) {
+	memcpy(val, mbme[idxpij(jmax,p,j)]+mk*stride,
+	       rowsize*sizeof(complex double));
+	val += rowsize;
+      }
+
+  flock(d->fd, LOCK_EX);
+
+  // another process might have added the same matrix elements
+  scanMEdb(d);
+
+  int res = 0;
+  if (findkey(d, &k) < 0) {
+    if (pwrite(d->fd, buf, recordsize(d), recordoffset(d, d->nrec)) == recordsize(d))
+      addkey(d, &k);
+    else {
+      fprintf(stderr, "couldn't write to database %s\n", d->fname);
+      res = -1;
+    }
+  }
+
+  flock(d->fd, LOCK_UN);
+  free(buf);
+
+  return res;
+}
@@ -0,0 +1,39 @@
+/**
+
+  \file MEDatabase.h
+
+  indexed append-only database for projected matrix elements,
+  one file per operator and projection, shared between processes
+
+
+*/
+
+
+#ifndef _MEDATABASE_H
+#define _MEDATABASE_H
+
+#include "Projection.h"
+#include "Symmetry.h"
+
+
+/// store and look up projected matrix elements in database (flag=1)
+void useMEDatabase(int flag);
+
+/// are matrix elements stored in database ?
+int usingMEDatabase(void);
+
+/// read projected matrix elements from database, returns 0 if found
+int readprojectedMBMEfromDatabase(const char* mbfilea, const char* mbfileb,
+				  const Projection* P,
+				  const ManyBodyOperator* Op,
+				  Symmetry Sa, Symmetry Sb,
+				  void* mbme);
+
+/// append projected matrix elements to database
+int writeprojectedMBMEtoDatabase(const char* mbfilea, const char* mbfileb,
+				 const Projection* P,
+				 const ManyBodyOperator* Op,
+				 Symmetry Sa, Symmetry Sb,
+				 const void* mbme);
+
+#endif
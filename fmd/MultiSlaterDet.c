@@ -324,13 +324,9 @@ void calcprojectedMultiMBME(const Projection* P, const ManyBodyOperator* Op,
   int NA = MBA->N; int NB = MBB->N;
   int IA, IB;
 
-  SlaterDet Q, Qp, Qpp;
+  SlaterDet Q, Qp;
   allocateSlaterDet(&Q, MBA->A);
   allocateSlaterDet(&Qp, MBB->A);
-  allocateSlaterDet(&Qpp, MBB->A);
-
-  SlaterDetAux X;
-  allocateSlaterDetAux(&X, MAX(MBA->A, MBB->A));
 
   Symmetry S, Sp;
   int axialsym;
@@ -393,13 +389,18 @@ void calcprojectedMultiMBME(const Projection* P, const ManyBodyOperator* Op,
           dminarray(kappaB, nB), dmaxarray(kappaB, nB));
 
 
+  // for hermitian operators and identical MultiSlaterDets only pairs
+  // iA <= iB are integrated, the contribution of pair iB, iA follows
+  // from <Qp|Op P^j_mk|Q> = <Q|Op P^j_km|Qp>^*
+  int herm = (MBA == MBB && usingHermiticity(Op));
+
   int c=0; 
-  int cmax=nA*nB; 
+  int cmax= herm ? nA*(nA+1)/2 : nA*nB; 
 
   for (iB=0; iB<nB; iB++) {
     MBB->get(MBB, iB, &Qp);
 
-    for (iA=0; iA<nA; iA++) {
+    for (iA=0; iA<(herm ? iB+1 : nA); iA++) {
       MBA->get(MBA, iA, &Q);
 
       // progress indicator
@@ -425,21 +426,50 @@ void calcprojectedMultiMBME(const Projection* P, const ManyBodyOperator* Op,
       double angkappa = dmin(kappaA[iA], kappaB[iB]);
       _initangintegration(P, angkappa, S, Sp, &angpara);
       int nang = angpara.n;
+      const angDtable* Dtab = getangDtable(&angpara, jmax);
+
+      // integration points are distributed over the threads,
+      // each thread works on its own copy of Qp and accumulates
+      // into private matrix elements
+      int nrot = ncm*nang;
+
+#ifdef _OPENMP
+#pragma omp parallel private(l, r, p, j, m, k, IA, IB)
+#endif
+      {
+	SlaterDet Qpp;
+	SlaterDetAux X;
+	allocateSlaterDet(&Qpp, MBB->A);
+	allocateSlaterDetAux(&X, MAX(MBA->A, MBB->A));
+
+	complex double (**pval[NA*NB])[(rank+1)*size];
+	for (IB=0; IB<NB; IB++)
+	  for (IA=0; IA<NA; IA++) {
+	    pval[IA+IB*NA] = initprojectedMBME(P, Op);
+	    for (p=0; p<=1; p++)
+	      for (j=odd; j<jmax; j=j+2)
+		for (k=0; k<SQR(j+1); k++)
+		  for (l=0; l<(rank+1)*size; l++)
+		    pval[IA+IB*NA][idxpij(jmax,p,j)][k][l] = 0.0;
+	  }
 
-      int icm; 
-      double xcm[3]; double weightcm;
+	int irot, icm; 
+	double xcm[3]; double weightcm;
 
-      int iang;
-      double alpha, beta, gamma; double weightang;
+	int iang;
+	double alpha, beta, gamma; double weightang;
 
-      complex double sval[(rank+1)*size];
-      double weight;
-      int ip;
+	complex double sval[(rank+1)*size];
+	double weight;
+	int ip;
 
-      for (icm=0; icm<ncm; icm++) {
-	getcmintegrationpoint(icm, &cmpara, xcm, &weightcm);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+	for (irot=0; irot<nrot; irot++) {
+	  icm = irot/nang; iang = irot%nang;
 
-	for (iang=0; iang<nang; iang++) {
+	  getcmintegrationpoint(icm, &cmpara, xcm, &weightcm);
 	  getangintegrationpoint(iang, &angpara, &alpha, &beta, &gamma, &weightang);
 	  // weight = 1.0/(2*norm*normp)*weightcm*weightang;
           weight = 0.5*weightcm*weightang;
@@ -456,14 +486,16 @@ void calcprojectedMultiMBME(const Projection* P, const ManyBodyOperator* Op,
 	      calcSlaterDetAuxod(&Q, &Qpp, &X);
 	    Op->me(Op->par, &Q, &Qpp, &X, sval);
 
-	    complex double w, wA, wB;
+	    complex double w, wA, wB, wh, whA, whB;
 	    Symmetry SA, SB;
 	    for (IB=0; IB<NB; IB++) {
 	      SB = MBB->symmetry(MBB, IB);
 	      wB = MBB->weight(MBB, IB, iB);
+	      whB = MBB->weight(MBB, IB, iA);
 	      for (IA=0; IA<NA; IA++) {
 		SA = MBA->symmetry(MBA, IA);
 		wA = MBA->weight(MBA, IA, iA);
+		whA = MBA->weight(MBA, IA, iB);
 		for (p=0; p<=1; p++)
 		  for (j=odd; j<jmax; j=j+2)
 		    for (k=-j; k<=j; k=k+2)
@@ -472,10 +504,18 @@ void calcprojectedMultiMBME(const Projection* P, const ManyBodyOperator* Op,
 			    SymmetryAllowed(SB, p, j, k)) {
 			  w = conj(wA)*wB*	 
 			    weight * (p && ip%2 ? -1 : 1)*
-			    (j+1)/(8*SQR(M_PI))*Djmkstar(j,m,k,alpha,beta,gamma);
+			    (j+1)/(8*SQR(M_PI))*angDstar(Dtab,iang,j,m,k);
 			  for (l=0; l<dim; l++)
 			    for (r=0; r<=rank; r++)
-			      val[IA+IB*NA][idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] += w*sval[r+l*(rank+1)];
+			      pval[IA+IB*NA][idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] += w*sval[r+l*(rank+1)];
+			  if (herm && iA != iB) {
+			    wh = conj(whA)*whB*
+			      weight * (p && ip%2 ? -1 : 1)*
+			      (j+1)/(8*SQR(M_PI))*conj(angDstar(Dtab,iang,j,k,m));
+			    for (l=0; l<dim; l++)
+			      for (r=0; r<=rank; r++)
+				pval[IA+IB*NA][idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] += wh*conj(sval[r+l*(rank+1)]);
+			  }
 		    }	
 		  }
 	      }
@@ -484,7 +524,26 @@ void calcprojectedMultiMBME(const Projection* P, const ManyBodyOperator* Op,
 
 	}
 
-      }	
+	// collect the contributions of all threads
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+	for (IB=0; IB<NB; IB++)
+	  for (IA=0; IA<NA; IA++)
+	    for (p=0; p<=1; p++)
+	      for (j=odd; j<jmax; j=j+2)
+		for (k=0; k<SQR(j+1); k++)
+		  for (l=0; l<dim; l++)
+		    for (r=0; r<=rank; r++)
+		      val[IA+IB*NA][idxpij(jmax,p,j)][k][r+l*(rank+1)] += 
+			pval[IA+IB*NA][idxpij(jmax,p,j)][k][r+l*(rank+1)];
+
+	for (IB=0; IB<NB; IB++)
+	  for (IA=0; IA<NA; IA++)
+	    freeprojectedMBME(P, pval[IA+IB*NA]);
+	freeSlaterDetAux(&X);
+	freeSlaterDet(&Qpp);
+      }
 
       freeAngintegration(&angpara);
       freecmintegration(&cmpara);
@@ -120,24 +120,140 @@ void fprintObservables(FILE *fp,
 
 
 
+// the potential, Tcm, r2, l2/s2/j2 and t2 are evaluated in a single
+// traversal of the Gaussian pairs, the separable two-body parts
+// from one combined set of one-body transition matrices
+
+// offsets in the combined vector
+#define OBSTCM 0
+#define OBSR2 1
+#define OBSANG 4
+#define OBST2 7
+#define OBSDIM 8
+
+// offsets of the one-body operators in the combined separable operator
+#define SEPTCM 0
+#define SEPR2 3
+#define SEPANG 12
+#define SEPT2 21
+#define SEPDIM 24
+
+typedef struct {
+  OneBodyOperator tcm, r2, ang, t2;
+} obobservablespara;
+
+typedef struct {
+  SeparableOperator tcm, r2, ang, t2;
+} sepobservablespara;
+
+
+static void ob_observables(void* par,
+			   const Gaussian* G1, const Gaussian* G2, 
+			   const GaussianAux* X, 
+			   complex double val[])
+{
+  obobservablespara* P = par;
+
+  P->tcm.me(P->tcm.par, G1, G2, X, val+OBSTCM);
+  P->r2.me(P->r2.par, G1, G2, X, val+OBSR2);
+  P->ang.me(P->ang.par, G1, G2, X, val+OBSANG);
+  P->t2.me(P->t2.par, G1, G2, X, val+OBST2);
+}
+
+
+static void sep_observables(const void* par,
+			    const Gaussian* G1, const Gaussian* G2, 
+			    const GaussianAux* X, 
+			    complex double val[])
+{
+  const sepobservablespara* P = par;
+
+  // these are proportional to the isospin overlap
+  if (X->T) {
+    P->tcm.me(P->tcm.par, G1, G2, X, val+SEPTCM);
+    P->r2.me(P->r2.par, G1, G2, X, val+SEPR2);
+    P->ang.me(P->ang.par, G1, G2, X, val+SEPANG);
+  }
+  P->t2.me(P->t2.par, G1, G2, X, val+SEPT2);
+}
+
+
+// copy terms of op shifted to val[i+obs] and one-body operators a+sep
+static int addseparableterms(const SeparableOperator* op, int obs, int sep,
+			     SeparableTerm* terms)
+{
+  int t;
+
+  for (t=0; t<op->nterms; t++) {
+    terms[t].i = op->terms[t].i+obs;
+    terms[t].a = op->terms[t].a+sep;
+    terms[t].b = op->terms[t].b+sep;
+    terms[t].w = op->terms[t].w;
+  }
+
+  return op->nterms;
+}
+
+
 void calcObservablesod(const Interaction* Int,
 		       const SlaterDet* Q, const SlaterDet* Qp,
 		       const SlaterDetAux* X, 
 		       Observablesod* obs)
 {
+  obobservablespara obpar;
+  sepobservablespara seppar;
+
+  initTCMoperators(Q, &obpar.tcm, &seppar.tcm);
+  initRadii2operators(Q, &obpar.r2, &seppar.r2);
+  initAngularMomentaoperators(&obpar.ang, &seppar.ang);
+  initIsospinoperators(&obpar.t2, &seppar.t2);
+
+  SeparableTerm terms[seppar.tcm.nterms+seppar.r2.nterms+
+		      seppar.ang.nterms+seppar.t2.nterms];
+  int nterms = 0;
+
+  nterms += addseparableterms(&seppar.tcm, OBSTCM, SEPTCM, terms+nterms);
+  nterms += addseparableterms(&seppar.r2, OBSR2, SEPR2, terms+nterms);
+  nterms += addseparableterms(&seppar.ang, OBSANG, SEPANG, terms+nterms);
+  nterms += addseparableterms(&seppar.t2, OBST2, SEPT2, terms+nterms);
+
+  OneBodyOperator op_ob_obs = {dim: OBSDIM, opt: 1, par: &obpar, 
+			       me: ob_observables};
+  SeparableOperator op_sep_obs = {dim: OBSDIM, nob: SEPDIM, opt: 0, 
+				  par: &seppar, me: sep_observables,
+				  nterms: nterms, terms: terms};
+
+  TwoBodyOperator op_tb_pot;
+  initPotentialoperator(Int, &op_tb_pot);
+
+  complex double obsone[OBSDIM], obstwo[OBSDIM];
+  int i;
+
+  calcSlaterDetMEodrho(Q, Qp, X, &op_ob_obs, &op_sep_obs, &op_tb_pot,
+		       obsone, obstwo, obs->v);
+
+  for (i=0; i<OBSDIM; i++)
+    obstwo[i] += obsone[i];
+
   obs->n = X->ovlap;
 
   calcTod(Q, Qp, X, &obs->t);
-  calcTCMod(Q, Qp, X, &obs->tcm);
-  calcPotentialod(Int, Q, Qp, X, obs->v);
+  obs->tcm = obstwo[OBSTCM];
+  obs->v[0] = 0.0;
+  for (i=1; i<Int->n; i++)
+    obs->v[0] += obs->v[i];
 
   if (Int->cm) obs->t -= obs->tcm;
   obs->h = obs->t + obs->v[0];
 
-  calcRadii2od(Q, Qp, X, &obs->r2m, &obs->r2p, &obs->r2n);
-  calcAngularMomentaod(Q, Qp, X, &obs->l2, &obs->s2, &obs->j2);
+  obs->r2m = obstwo[OBSR2+0];
+  obs->r2p = obstwo[OBSR2+1];
+  obs->r2n = obstwo[OBSR2+2];
+  obs->l2 = obstwo[OBSANG+0];
+  obs->s2 = obstwo[OBSANG+1];
+  obs->j2 = obstwo[OBSANG+2];
   calcParityod(Q, Qp, X, &obs->pi);
-  calcIsospinod(Q, Qp, X, &obs->t2);
+  obs->t2 = obstwo[OBST2];
 }
 
 
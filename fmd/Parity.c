@@ -21,6 +21,11 @@
 static SlaterDet Qpp;
 static SlaterDetAux Xpp;
 
+// every thread needs its own workspace in parallel projection loops
+#ifdef _OPENMP
+#pragma omp threadprivate(Qpp, Xpp)
+#endif
+
 
 void ob_parity(void* par,
 	       const Gaussian* G1, const Gaussian* G2,
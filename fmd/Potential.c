@@ -32,16 +32,33 @@
 #include "Interaction.h"
 #include "Potential.h"
 
+#include "misc/utils.h"
+#include "misc/profile.h"
 #include "numerics/cmath.h"
 #include "numerics/coulomb.h"
 
 
-static void tb_pot(Interaction* P,
+// generic two-body potential kernel, inlined into the specialized
+// kernels below with features known at compile time
+static inline __attribute__((always_inline))
+void tb_pot_kernel(const int features, Interaction* P,
 		   const Gaussian* G1, const Gaussian* G2, 
 		   const Gaussian* G3, const Gaussian* G4, 
 		   const GaussianAux* X13, const GaussianAux* X24, 
 		   complex double v[])
 {	
+  // interaction terms, compile-time constants in the specialized kernels
+  const int spinorbit = (features & FEATSPINORBIT) && P->spinorbit;
+  const int tensor = (features & FEATTENSOR) && P->tensor;
+  const int momentump2 = (features & FEATMOMENTUMP2) && P->momentump2;
+  const int momentumpr2 = (features & FEATMOMENTUMPR2) && P->momentumpr2;
+  const int l2 = (features & FEATL2) && P->l2;
+  const int l2ls = (features & FEATL2LS) && P->l2ls;
+  const int tll = (features & FEATTLL) && P->tll;
+  const int tpp = (features & FEATTPP) && P->tpp;
+  const int l2tpp = (features & FEATL2TPP) && P->l2tpp;
+  const int prtrp = (features & FEATPRTRP) && P->prtrp;
+
   int TT, tautau;
 
   TT = X13->T * X24->T;
@@ -52,11 +69,15 @@ static void tb_pot(Interaction* P,
   complex double SS, RR;
   complex double lambda, alpha, psi;
   complex double rho[3], rho2, pi[3], pi2, sigsig;
-  complex double rhoxpi[3], S[3];
+  complex double rhoxpi[3] = {0}, S[3];
   complex double L2, LS, S12, beta, theta, rhopi;
   complex double S12pipi, S12ll, S12rhopi;
   
   int i;
+
+  // terms only needed for some interactions
+  psi = pi2 = L2 = LS = S12 = beta = theta = rhopi = 0.0;
+  S12pipi = S12ll = S12rhopi = 0.0;
   
   SS = X13->S * X24->S; RR = X13->R * X24->R;
   lambda = X13->lambda + X24->lambda;
@@ -68,18 +89,18 @@ static void tb_pot(Interaction* P,
 
   sigsig = cvec3mult(X13->sig, X24->sig);
 
-  if (P->l2 || P->spinorbit || P->l2ls || P->tll || P->tpp || P->l2tpp){
+  if (l2 || spinorbit || l2ls || tll || tpp || l2tpp){
     cvec3cross(rho, pi, rhoxpi);
     L2 = cvec3sqr(rhoxpi);
   }
   
-  if (P->spinorbit || P->l2ls) {
+  if (spinorbit || l2ls) {
     for (i=0; i<3; i++)
       S[i] = 0.5*(X13->sig[i]*X24->S+X13->S*X24->sig[i]);
     LS = cvec3mult(rhoxpi, S);
   }
 
-  if (P->momentump2 || P->momentumpr2 || P->l2 || P->l2ls || P->tll || P->tpp || P->prtrp || P->l2tpp) {
+  if (momentump2 || momentumpr2 || l2 || l2ls || tll || tpp || prtrp || l2tpp) {
     beta = I*((conj(G1->a) - G3->a)*X13->lambda + (conj(G2->a) - G4->a)*X24->lambda);
     theta = (conj(G1->a)*X13->lambda + conj(G2->a)*X24->lambda)*
             (G3->a*X13->lambda + G4->a*X24->lambda);
@@ -88,16 +109,16 @@ static void tb_pot(Interaction* P,
     rhopi = cvec3mult(rho, pi);
   }
 
-  if (P->tensor || P->tll || P->tpp || P->prtrp || P->l2tpp)
+  if (tensor || tll || tpp || prtrp || l2tpp)
     S12 = 3*cvec3mult(X13->sig, rho)*cvec3mult(X24->sig, rho) - sigsig*rho2;
 
-  if (P->tll || P->tpp || P->prtrp || P->l2tpp) {
+  if (tll || tpp || prtrp || l2tpp) {
     S12rhopi = 1.5*(cvec3mult(X13->sig, rho)*cvec3mult(X24->sig, pi) + cvec3mult(X13->sig, pi)*cvec3mult(X24->sig, rho))
 		  - sigsig * rhopi;
     S12pipi = 3*cvec3mult(X13->sig, pi)*cvec3mult(X24->sig, pi) - sigsig*pi2;
   }
 
-  if (P->tll || P->tpp || P->l2tpp) {
+  if (tll || tpp || l2tpp) {
     S12ll = 3*cvec3mult(X13->sig, rhoxpi)*cvec3mult(X24->sig, rhoxpi) - sigsig*L2;
   }
 
@@ -110,6 +131,9 @@ static void tb_pot(Interaction* P,
   complex double TPP, TRP, L2TPP;
   
   complex double l2tpppipi, l2tpprhopi, l2tpprr, l2tppll;
+
+  iakapi = kapakapi = thelakapi = Gi = 0.0;
+  PiPi = PiPiG = PirPir = LL = L2LS = TLL = TPP = TRP = L2TPP = 0.0;
   
   int pipidone=0, pipigdone=0, pirpirdone=0;
   int l2done=0, l2lsdone=0;
@@ -127,7 +151,7 @@ static void tb_pot(Interaction* P,
     if ((idx==0 || kappa != P->c[idx-1].kappa) && type != VC) {
       iakapi = 1/(alpha+kappa);
       kapakapi = kappa*iakapi;
-      if (P->l2 || P->l2ls || P->tll || P->tpp || P->prtrp || P->l2tpp)
+      if (l2 || l2ls || tll || tpp || prtrp || l2tpp)
         thelakapi = theta*iakapi + lambda*kapakapi;
 	
       Gi = cpow32(kapakapi)*cexp(-0.5*rho2*iakapi);
@@ -146,7 +170,7 @@ static void tb_pot(Interaction* P,
     // Calculation of non-overlap and non-Gaussian parts of the matrix elements
  
     // p2V
-    if (!pipidone && p2V <= type && type <= tsp2V) {
+    if (momentump2 && !pipidone && p2V <= type && type <= tsp2V) {
       PiPi = pi2-0.5*beta*iakapi*rhopi+
 	0.25*theta*csqr(iakapi)*rho2+
 	0.75*(lambda-theta*iakapi);
@@ -155,7 +179,7 @@ static void tb_pot(Interaction* P,
     }
 
     // Vp2
-    if (!pipigdone && Vp2 <= type && type <= tsVp2) {
+    if (momentump2 && !pipigdone && Vp2 <= type && type <= tsVp2) {
       PiPiG = pi2-0.5*beta*iakapi*rhopi+
 	(0.25*theta-0.5)*csqr(iakapi)*rho2+
 	0.75*lambda-(0.75*theta-1.5)*iakapi;
@@ -164,7 +188,7 @@ static void tb_pot(Interaction* P,
     }
         
     // pr2V
-    if (!pirpirdone && pr2V <= type && type <= tspr2V) {
+    if (momentumpr2 && !pirpirdone && pr2V <= type && type <= tspr2V) {
       PirPir = csqr(kapakapi)*(csqr(rhopi)-0.5*beta*iakapi*rhopi*rho2+
 			       0.25*theta*csqr(iakapi)*csqr(rho2))+
 	       alpha*kapakapi*(pi2-0.5*beta*iakapi*rhopi+
@@ -177,7 +201,7 @@ static void tb_pot(Interaction* P,
     }
 
     // Vl2
-    if (!l2done && Vl2 <= type && type <= tsVl2) {
+    if (l2 && !l2done && Vl2 <= type && type <= tsVl2) {
           LL = kapakapi*(kapakapi*L2 + 2*alpha*pi2 - beta*rhopi + 0.5*thelakapi*rho2
     	     - 1.5*psi);
       
@@ -186,7 +210,7 @@ static void tb_pot(Interaction* P,
 
 
     // Vl2ls
-    if (!l2lsdone && (type == Vl2ls || type == tVl2ls)) {
+    if (l2ls && !l2lsdone && (type == Vl2ls || type == tVl2ls)) {
       L2LS = LS*csqr(kapakapi)*(kapakapi*L2 + 4*alpha*pi2 - 2*beta*rhopi + thelakapi*rho2
       		    - 5*psi) + 2*LS*kapakapi;
       
@@ -194,7 +218,7 @@ static void tb_pot(Interaction* P,
     } 
 
     // VTll - S12(l,l)
-    if (!tlldone && (type == VTll || type == tVTll)) {
+    if (tll && !tlldone && (type == VTll || type == tVTll)) {
       TLL = csqr(kapakapi)*S12ll - alpha*kapakapi*S12pipi
       	    - 0.25*kapakapi*thelakapi*S12
 	    + 0.5*kapakapi*beta*S12rhopi;
@@ -203,7 +227,7 @@ static void tb_pot(Interaction* P,
     }
     
     // VTpp - S12(p,p)
-    if (!tppdone && (type == VTpp || type == tVTpp)) {
+    if (tpp && !tppdone && (type == VTpp || type == tVTpp)) {
       TPP = csqr(kapakapi)*(kapakapi*S12ll*(5*alpha + kapakapi*rho2)
       			    + S12pipi*(9*csqr(alpha) + 13*alpha*kapakapi*rho2 + 2*csqr(kapakapi*rho2))
 			    - S12rhopi*(4.5*alpha*beta + 16*alpha*kapakapi*rhopi + 2.5*beta*kapakapi*rho2
@@ -216,7 +240,7 @@ static void tb_pot(Interaction* P,
     
     // NOTE: 06/08/03 Added factor 0.5 which was implied by hermitizing the super operator basis ...
     // prVTrp (p_r v(r) +v(r) p_r) S12(r,p)
-    if (!trpdone && (type == prVTrp || type == tprVTrp)) {
+    if (prtrp && !trpdone && (type == prVTrp || type == tprVTrp)) {
       TRP = 0.5*csqr(kapakapi)*(S12pipi*2*alpha*(3*alpha + kapakapi*rho2)
       			    + S12*(1.5*theta - 2.625*kapakapi*csqr(beta) - 3
 			    	   + 0.5*csqr(kapakapi)*beta*iakapi*rho2*rhopi
@@ -231,7 +255,7 @@ static void tb_pot(Interaction* P,
     }
 
     // Vl2Tpp - {L2 S12(p,p)}_H
-    if (!l2tppdone && (type == Vl2Tpp || type == tVl2Tpp)) {
+    if (l2tpp && !l2tppdone && (type == Vl2Tpp || type == tVl2Tpp)) {
       l2tpppipi = 60*cpow(alpha, 3)*kapakapi*pi2 + 117*csqr(alpha*kapakapi)*pi2*rho2
       		   - 33*csqr(alpha*kapakapi*rhopi) 
       		   - 21*alpha*cpow(kapakapi,3)*rho2*csqr(rhopi) 
@@ -303,85 +327,85 @@ static void tb_pot(Interaction* P,
       v[ilabel] += gamma*tautau*sigsig*RR*Gi;
 
     // p2V Potentials
-    else if (type == p2V && TT)
+    else if (momentump2 && type == p2V && TT)
       v[ilabel] += gamma*TT*SS*RR*PiPi*Gi;
-    else if (type == sp2V && TT)
+    else if (momentump2 && type == sp2V && TT)
       v[ilabel] += gamma*TT*sigsig*RR*PiPi*Gi;
-    else if (type == tp2V && tautau)
+    else if (momentump2 && type == tp2V && tautau)
       v[ilabel] += gamma*tautau*SS*RR*PiPi*Gi;
-    else if (type == tsp2V && tautau)
+    else if (momentump2 && type == tsp2V && tautau)
       v[ilabel] += gamma*tautau*sigsig*RR*PiPi*Gi;
 
     // Vp2 Potentials
-    else if (type == Vp2 && TT)
+    else if (momentump2 && type == Vp2 && TT)
       v[ilabel] += gamma*TT*SS*RR*PiPiG*Gi;
-    else if (type == sVp2 && TT)
+    else if (momentump2 && type == sVp2 && TT)
       v[ilabel] += gamma*TT*sigsig*RR*PiPiG*Gi;
-    else if (type == tVp2 && tautau)
+    else if (momentump2 && type == tVp2 && tautau)
       v[ilabel] += gamma*tautau*SS*RR*PiPiG*Gi;
-    else if (type == tsVp2 && tautau)
+    else if (momentump2 && type == tsVp2 && tautau)
       v[ilabel] += gamma*tautau*sigsig*RR*PiPiG*Gi;
 
     // pr2 Potentials
-    else if (type == pr2V && TT)
+    else if (momentumpr2 && type == pr2V && TT)
       v[ilabel] += gamma*TT*SS*RR*PirPir*Gi;
-    else if (type == spr2V && TT)
+    else if (momentumpr2 && type == spr2V && TT)
       v[ilabel] += gamma*TT*sigsig*RR*PirPir*Gi;
-    else if (type == tpr2V && tautau)
+    else if (momentumpr2 && type == tpr2V && tautau)
       v[ilabel] += gamma*tautau*SS*RR*PirPir*Gi;
-    else if (type == tspr2V && tautau)
+    else if (momentumpr2 && type == tspr2V && tautau)
       v[ilabel] += gamma*tautau*sigsig*RR*PirPir*Gi;
 
     // l2 Potentials
-    else if (type == Vl2 && TT)
+    else if (l2 && type == Vl2 && TT)
       v[ilabel] += gamma*TT*SS*RR*Gi*LL;
-    else if (type == sVl2 && TT)
+    else if (l2 && type == sVl2 && TT)
       v[ilabel] += gamma*TT*sigsig*RR*Gi*LL;
-    else if (type == tVl2 && tautau)
+    else if (l2 && type == tVl2 && tautau)
       v[ilabel] += gamma*tautau*SS*RR*Gi*LL;
-    else if (type == tsVl2 && tautau)
+    else if (l2 && type == tsVl2 && tautau)
       v[ilabel] += gamma*tautau*sigsig*RR*Gi*LL;
 
     // Spin-Orbit Potentials
-    else if (type == Vls && TT)
+    else if (spinorbit && type == Vls && TT)
       v[ilabel] += gamma*TT*LS*kapakapi*RR*Gi;
-    else if (type == tVls && tautau)
+    else if (spinorbit && type == tVls && tautau)
       v[ilabel] += gamma*tautau*LS*kapakapi*RR*Gi;
 
     // l2ls Potentials
-    else if (type == Vl2ls && TT)
+    else if (l2ls && type == Vl2ls && TT)
       v[ilabel] += gamma*TT*RR*Gi*L2LS;
-    else if (type == tVl2ls && tautau)
+    else if (l2ls && type == tVl2ls && tautau)
       v[ilabel] += gamma*tautau*RR*Gi*L2LS;
 
     // Tensor Potentials
-    else if (type == VT && TT)
+    else if (tensor && type == VT && TT)
       v[ilabel] += gamma*TT*S12*csqr(kapakapi)*RR*Gi;
-    else if (type == tVT && tautau)
+    else if (tensor && type == tVT && tautau)
       v[ilabel] += gamma*tautau*S12*csqr(kapakapi)*RR*Gi;
 
     // S12(l,l) Potentials
-    else if (type == VTll && TT)
+    else if (tll && type == VTll && TT)
       v[ilabel] += gamma*TT*RR*Gi*TLL;
-    else if (type == tVTll && tautau)
+    else if (tll && type == tVTll && tautau)
       v[ilabel] += gamma*tautau*RR*Gi*TLL;
 
     // S12(p,p) Potentials
-    else if (type == VTpp && TT)
+    else if (tpp && type == VTpp && TT)
       v[ilabel] += gamma*TT*RR*Gi*TPP;
-    else if (type == tVTpp && tautau)
+    else if (tpp && type == tVTpp && tautau)
       v[ilabel] += gamma*tautau*RR*Gi*TPP;
 
     // {L2 S12(p,p)}_H Potentials
-    else if (type == Vl2Tpp && TT)
+    else if (l2tpp && type == Vl2Tpp && TT)
       v[ilabel] += gamma*TT*RR*Gi*L2TPP;
-    else if (type == tVl2Tpp && tautau)
+    else if (l2tpp && type == tVl2Tpp && tautau)
       v[ilabel] += gamma*tautau*RR*Gi*L2TPP;
     
     // (p_r v(r) + v(r) p_r) S12(r,p) 
-    else if (type == prVTrp && TT)
+    else if (prtrp && type == prVTrp && TT)
       v[ilabel] += gamma*TT*RR*Gi*TRP;
-    else if (type == tprVTrp && tautau)
+    else if (prtrp && type == tprVTrp && tautau)
       v[ilabel] += gamma*tautau*RR*Gi*TRP;
     
     // Coulomb Potential
@@ -391,17 +415,196 @@ static void tb_pot(Interaction* P,
 }
 
 
+// specialized kernels, terms not contained in the feature set
+// are removed by the compiler
+#define TB_POT(name, features)						\
+static void name(void* par,						\
+		 const Gaussian* G1, const Gaussian* G2,		\
+		 const Gaussian* G3, const Gaussian* G4,		\
+		 const GaussianAux* X13, const GaussianAux* X24,	\
+		 complex double v[])					\
+{									\
+  tb_pot_kernel(features, par, G1, G2, G3, G4, X13, X24, v);		\
+}
+
+TB_POT(tb_pot_central, KERNELCENTRAL)
+TB_POT(tb_pot_centralls, KERNELCENTRALLS)
+TB_POT(tb_pot_tensor, KERNELTENSOR)
+TB_POT(tb_pot, KERNELALL)
+
+
+// pairs (2,4) are processed in chunks of NLANES
+#define NLANES 256
+
+// central and Coulomb parts of tb_pot summed over all pairs (2,4) in X24
+// weighted with w, complex arithmetic is done without library calls so 
+// that the loops over pairs vectorize
+static void tb_pot_lanes(void* par,
+			 const Gaussian* G1, const Gaussian* G3,
+			 const GaussianAux* X13, const GaussianAuxSoA* X24,
+			 const double* wre, const double* wim,
+			 complex double v[])
+{
+  Interaction* P = par;
+
+  // prefactors w*{TT|tautau}*{SS|sigsig}*RR for V, sV, tV, tsV and VC
+  double fre[5][NLANES], fim[5][NLANES];
+  double alphare[NLANES], alphaim[NLANES], rho2re[NLANES], rho2im[NLANES];
+  double gre[NLANES], gim[NLANES], ere[NLANES], eim[NLANES];
+  double s0re, s0im, s1re, s1im, s2re, s2im, s3re, s3im;
+  complex double sum[4], sumC=0.0;
+
+  int xi1=G1->xi, xi3=G3->xi;
+  int xi2, xi4, TT, tautau;
+  complex double w, SS, RR, sigsig, alpha, rho2, a, b, iakapi, z, Gi;
+
+  InteractionType type;
+  double gamma, kappa, kappadone;
+  int j0, n, j, idx, ilabel, gidone, coulombdone;
+
+  for (j0=0; j0<X24->n; j0+=NLANES) {
+    n = min(NLANES, X24->n-j0);
+
+#pragma omp simd private(xi2, xi4, TT, tautau, w, SS, RR, sigsig, alpha, rho2, a, b)
+    for (j=0; j<n; j++) {
+      xi2 = X24->xi2[j0+j]; xi4 = X24->xi4[j0+j];
+      TT = X13->T * X24->T[j0+j];
+      tautau = ((1-xi1*xi3)*(1-xi2*xi4))/4+(xi1*xi4+xi2*xi3)/2;
+
+      w = wre[j0+j] + I*wim[j0+j];
+      SS = X13->S * (X24->Sre[j0+j] + I*X24->Sim[j0+j]);
+      RR = X13->R * (X24->Rre[j0+j] + I*X24->Rim[j0+j]);
+      sigsig = X13->sig[0]*(X24->sigre[0][j0+j] + I*X24->sigim[0][j0+j]) +
+	X13->sig[1]*(X24->sigre[1][j0+j] + I*X24->sigim[1][j0+j]) +
+	X13->sig[2]*(X24->sigre[2][j0+j] + I*X24->sigim[2][j0+j]);
+
+      alpha = X13->alpha + X24->alphare[j0+j] + I*X24->alphaim[j0+j];
+      rho2 = csqr(X13->rho[0] - (X24->rhore[0][j0+j] + I*X24->rhoim[0][j0+j])) +
+	csqr(X13->rho[1] - (X24->rhore[1][j0+j] + I*X24->rhoim[1][j0+j])) +
+	csqr(X13->rho[2] - (X24->rhore[2][j0+j] + I*X24->rhoim[2][j0+j]));
+      alphare[j] = creal(alpha); alphaim[j] = cimag(alpha);
+      rho2re[j] = creal(rho2); rho2im[j] = cimag(rho2);
+
+      a = w*SS*RR; b = w*sigsig*RR;
+      fre[V][j] = TT*creal(a); fim[V][j] = TT*cimag(a);
+      fre[sV][j] = TT*creal(b); fim[sV][j] = TT*cimag(b);
+      fre[tV][j] = tautau*creal(a); fim[tV][j] = tautau*cimag(a);
+      fre[tsV][j] = tautau*creal(b); fim[tsV][j] = tautau*cimag(b);
+      fre[4][j] = (xi1 == 1 && xi2 == 1) ? fre[V][j] : 0.0;
+      fim[4][j] = (xi1 == 1 && xi2 == 1) ? fim[V][j] : 0.0;
+    }
+
+    gidone = 0; coulombdone = 0; kappadone = 0.0;
+
+    for (idx=0; idx<P->ncomponents; idx++) {
+
+      type = P->c[idx].type;
+      gamma = P->c[idx].gamma;
+      kappa = P->c[idx].kappa;
+      ilabel = P->c[idx].ilabel;
+
+      // Coulomb Potential
+      if (type == VC) {
+	if (!coulombdone) {
+#pragma omp simd private(alpha, z)
+	  for (j=0; j<n; j++) {
+	    alpha = alphare[j] + I*alphaim[j];
+	    z = 1.0/csqrtv(2*alpha);
+	    gre[j] = creal(z); gim[j] = cimag(z);
+	    z = 0.5*(rho2re[j] + I*rho2im[j])/alpha;
+	    ere[j] = creal(z); eim[j] = cimag(z);
+	  }
+	  zcoulombv(n, ere, eim);
+
+	  s0re = s0im = 0.0;
+#pragma omp simd private(z) reduction(+:s0re,s0im)
+	  for (j=0; j<n; j++) {
+	    z = (fre[4][j] + I*fim[4][j])*(gre[j] + I*gim[j])*(ere[j] + I*eim[j]);
+	    s0re += creal(z); s0im += cimag(z);
+	  }
+	  sumC = s0re + I*s0im;
+	  coulombdone = 1;
+	}
+	v[ilabel] += gamma*sumC;
+	continue;
+      }
+
+      // Central Potentials, Gaussian integrals for all four types at once
+      if (!gidone || kappa != kappadone) {
+#pragma omp simd private(iakapi, z)
+	for (j=0; j<n; j++) {
+	  iakapi = 1.0/(alphare[j] + I*alphaim[j] + kappa);
+	  z = cpow32v(kappa*iakapi);
+	  gre[j] = creal(z); gim[j] = cimag(z);
+	  z = -0.5*(rho2re[j] + I*rho2im[j])*iakapi;
+	  ere[j] = creal(z); eim[j] = cimag(z);
+	}
+	cexpv(n, ere, eim);
+
+	s0re = s0im = s1re = s1im = s2re = s2im = s3re = s3im = 0.0;
+#pragma omp simd private(Gi, z) reduction(+:s0re,s0im,s1re,s1im,s2re,s2im,s3re,s3im)
+	for (j=0; j<n; j++) {
+	  Gi = (gre[j] + I*gim[j])*(ere[j] + I*eim[j]);
+	  z = (fre[V][j] + I*fim[V][j])*Gi; s0re += creal(z); s0im += cimag(z);
+	  z = (fre[sV][j] + I*fim[sV][j])*Gi; s1re += creal(z); s1im += cimag(z);
+	  z = (fre[tV][j] + I*fim[tV][j])*Gi; s2re += creal(z); s2im += cimag(z);
+	  z = (fre[tsV][j] + I*fim[tsV][j])*Gi; s3re += creal(z); s3im += cimag(z);
+	}
+	sum[V] = s0re + I*s0im; sum[sV] = s1re + I*s1im;
+	sum[tV] = s2re + I*s2im; sum[tsV] = s3re + I*s3im;
+
+	gidone = 1; kappadone = kappa;
+      }
+      v[ilabel] += gamma*sum[type];
+    }
+  }
+}
+
+
+// two-body operator with the kernel specialized on the features of P,
+// dispatched once per matrix element
+static void inittb_pot(const Interaction* P, TwoBodyOperator* op)
+{
+  int features = Interactionfeatures(P);
+
+  op->dim = P->n;
+  op->opt = OPTCHARGE;
+  op->par = (Interaction*) P;
+  op->melanes = NULL;
+
+  if (!(features & ~KERNELCENTRAL)) {
+    op->me = tb_pot_central;
+    op->melanes = tb_pot_lanes;
+  }
+  else if (!(features & ~KERNELCENTRALLS))
+    op->me = tb_pot_centralls;
+  else if (!(features & ~KERNELTENSOR))
+    op->me = tb_pot_tensor;
+  else
+    op->me = tb_pot;
+}
+
+
+void initPotentialoperator(const Interaction* P, TwoBodyOperator* op)
+{
+  inittb_pot(P, op);
+}
+
+
 void calcPotential(const Interaction *P,
 		   const SlaterDet* Q, const SlaterDetAux* X, double v[])
 {
+  PROFILEBEGIN("calcPotential")
   int i;
-  TwoBodyOperator op_tb_pot = {dim: P->n, opt: 0, par: P, me: tb_pot};
+  TwoBodyOperator op_tb_pot;
+  inittb_pot(P, &op_tb_pot);
 
-  calcSlaterDetTBME(Q, X, &op_tb_pot, v);
+  calcSlaterDetTBMErho(Q, X, &op_tb_pot, v);
   
   v[0] = 0.0;
   for (i=1; i<P->n; i++)
     v[0] += v[i];
+  PROFILEEND
 }
 
 
@@ -410,7 +613,8 @@ void calcPotentialrowcol(const Interaction* P,
 			 int k, int l)
 {
   int i;
-  TwoBodyOperator op_tb_pot = {dim: P->n, opt: 0, par: P, me: tb_pot};
+  TwoBodyOperator op_tb_pot;
+  inittb_pot(P, &op_tb_pot);
 
   calcSlaterDetTBMErowcol(Q, X, &op_tb_pot, v, k, l);
   
@@ -425,14 +629,17 @@ void calcPotentialod(const Interaction *P,
 		     const SlaterDetAux* X, 
 		     complex double v[])
 {
+  PROFILEBEGIN("calcPotentialod")
   int i;
-  TwoBodyOperator op_tb_pot = {dim: P->n, opt: 0, par: P, me: tb_pot};
+  TwoBodyOperator op_tb_pot;
+  inittb_pot(P, &op_tb_pot);
 
-  calcSlaterDetTBMEod(Q, Qp, X, &op_tb_pot, v);
+  calcSlaterDetTBMEodrho(Q, Qp, X, &op_tb_pot, v);
 
   v[0] = 0.0;
   for (i=1; i<P->n; i++)
     v[0] += v[i];
+  PROFILEEND
 }
 
 
@@ -442,7 +649,8 @@ void calcPotentialodrowcol(const Interaction* P,
 			   int k, int l)
 {
   int i;
-  TwoBodyOperator op_tb_pot = {dim: P->n, opt: 0, par: P, me: tb_pot};
+  TwoBodyOperator op_tb_pot;
+  inittb_pot(P, &op_tb_pot);
 
   calcSlaterDetTBMEodrowcol(Q, Qp, X, &op_tb_pot, v, k, l);
   
@@ -456,7 +664,8 @@ void calcPotentialsHF(const Interaction* Int,
 		      const SlaterDet* Q, const SlaterDetAux* X,
 		      void* mes)
 {
-  TwoBodyOperator op_tb_pot = {dim: Int->n, opt: 0, par: Int, me: tb_pot};
+  TwoBodyOperator op_tb_pot;
+  inittb_pot(Int, &op_tb_pot);
   calcSlaterDetTBHFMEs(Q, X, &op_tb_pot, mes);
 
   int A=Q->A;
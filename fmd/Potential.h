@@ -20,6 +20,9 @@
 #include "Interaction.h"
 
 
+/// two-body operator used by calcPotential
+void initPotentialoperator(const Interaction* Int, TwoBodyOperator* op);
+
 void calcPotential(const Interaction *Int,
 		   const SlaterDet* Q, const SlaterDetAux* X, double v[]);
 
@@ -35,6 +35,13 @@
 // make it easy for now: only calculate diagonal
 
 
+static void rotateDiagonalDensityMatrixHO(void* par, const SlaterDet* Qp,
+					  double alpha, double beta, double gamma)
+{
+  rotateDensityMatrixHO(par, Qp, alpha, beta, gamma);
+}
+
+
 // isoscalar, scalar density matrix
 ManyBodyOperator OpDiagonalDensityMatrixHO = {
   name : NULL,
@@ -43,7 +50,8 @@ ManyBodyOperator OpDiagonalDensityMatrixHO = {
   dim : 0,
   size : 0,
   par : NULL,
-  me : calcDiagonalDensityMatrixHOod
+  me : calcDiagonalDensityMatrixHOod,
+  rotate : rotateDiagonalDensityMatrixHO
 };
 
 
@@ -60,20 +68,15 @@ void initOpDiagonalDensityMatrixHO(DensityMatrixHOPar* par)
 }
 
 
-// workspace
-
-complex double rho[4*HODIMMAX*4*HODIMMAX];
-
-
 void calcDiagonalDensityMatrixHOod(DensityMatrixHOPar* par,
 				   const SlaterDet* Q, const SlaterDet* Qp,
 				   const SlaterDetAux* X,
 				   complex double* rhodiag)
 {
-  int dim = dimHOBasis(par->nmax);
+  complex double rho[dimHOBasis(par->nmax)];
   int idx;
 
-  calcDensityMatrixHOod(par, Q, Qp, X, rho);
+  calcDensityMatrixHOdiagod(par, Q, Qp, X, rho);
 
   int orbit, ixi, xi, N, n, l, twoj, twom; 
 
@@ -89,7 +92,7 @@ void calcDiagonalDensityMatrixHOod(DensityMatrixHOPar* par,
 	  rhodiag[orbit] = 0.0;
 	  for (twom=-twoj; twom<=twoj; twom=twom+2) {
 	    idx = HOxinljmidx(xi, n, l, twoj, twom);
-	    rhodiag[orbit] += rho[idx+idx*dim];
+	    rhodiag[orbit] += rho[idx];
 	  }
 	  orbit++;
 	}	
@@ -128,7 +131,7 @@ void writeprojectedDiagonalDensityMatrixHO(FILE* fp,
 
   int i;
   int orbit;
-  double nshell, norbit[HONMAX+1];
+  double nshell, norbit[nmax+1];
   int ixi, xi, N, n, l, twoj;
 
   i=0;
@@ -240,7 +243,7 @@ void writeprojectedDiagonalTransitionDensityMatrixHO(FILE* fp,
 
   int i;
   int orbit;
-  double nshell, norbit[HONMAX+1];
+  double nshell, norbit[nmax+1];
   int ixi, xi, N, n, l, twoj;
 
   i=0;
@@ -159,6 +159,11 @@ static complex double* B;
 static complex double* Bp;
 static complex double* Bn;
 
+// private to each thread of the projection loops
+#ifdef _OPENMP
+#pragma omp threadprivate(B, Bp, Bn)
+#endif
+
 
 void calcShellOccupationsod(ShellOccupationsPara* par,
 			    const SlaterDet* Q, const SlaterDet* Qp,
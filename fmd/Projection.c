@@ -17,21 +17,28 @@
 #include <complex.h>
 #include <math.h>
 #include <zlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "SlaterDet.h"
 #include "Observables.h"
 #include "CenterofMass.h"
 
 #include "numerics/zcw.h"
+#include "numerics/gaussquad.h"
 #include "numerics/wignerd.h"
 #include "numerics/clebsch.h"
 #include "numerics/cmat.h"
 
 #include "misc/physics.h"
 #include "misc/utils.h"
+#include "misc/profile.h"
 
 #include "Projection.h"
 #include "Symmetry.h"
+#include "MEDatabase.h"
 
 
 #define SQR(x) ((x)*(x))
@@ -54,13 +61,15 @@ char* AngmomtoStr(int j, int pi)
 
 char* ProjectiontoStr(const Projection* P)
 {
-  char* suffix = malloc(36*sizeof(char));
+  // the parts are sized for any int parameter, so the string
+  // is never truncated and fits into PROJSTRLEN
+  char* suffix = malloc(PROJSTRLEN*sizeof(char));
 
-  char jmaxsuf[10] = "";
+  char jmaxsuf[18] = "";
   if (P->jmax != JMAX)
     sprintf(jmaxsuf, "jmax-%d-", P->jmax-1);
 
-  char angsuf[12];
+  char angsuf[29];
   if (P->ang == AngNone)
     sprintf(angsuf, "ang-none");
   else if (P->ang == AngProd)
@@ -71,8 +80,10 @@ char* ProjectiontoStr(const Projection* P)
 	    P->angprod.nazimuth);
   else if (P->ang == AngZCW)
     sprintf(angsuf, "ang-zcw-%d", P->angzcw.idx);
+  else if (P->ang == AngAdapt)
+    sprintf(angsuf, "ang-adapt-%d", P->angadapt.tol);
 
-  char cmsuf[14] = "";
+  char cmsuf[40] = "";
   if (P->cm == CMNone)
     sprintf(cmsuf, "-cm-none");
   else if (P->cm == CMSimple)
@@ -95,7 +106,7 @@ char* ProjectiontoStr(const Projection* P)
 }
 
 
-// ang-[none|nbeta-nazimuth|zcw-izcw][-cm-nr-[ntheta-nphi|tet|oct|cbe]]
+// ang-[none|nbeta-nazimuth|zcw-izcw|adapt-tol][-cm-nr-[ntheta-nphi|tet|oct|cbe]]
 
 // should return error code if could analyze parameters
 
@@ -106,7 +117,7 @@ int initProjection(Projection* P, int odd, const char* projpar)
   P->jmax = JMAX;
   P->ang = AngNone; P->cm = CMSimple;
 
-  char projparcpy[strlen(projpar)];
+  char projparcpy[strlen(projpar)+1];
   strcpy(projparcpy, projpar);
   char* c = projparcpy;
 
@@ -127,6 +138,10 @@ int initProjection(Projection* P, int odd, const char* projpar)
       P->ang = AngZCW;
       c=strtok(NULL, "-");
       P->angzcw.idx = atoi(c);
+    } else if (!strncmp(c, "adapt", 5)) {
+      P->ang = AngAdapt;
+      c=strtok(NULL, "-");
+      P->angadapt.tol = atoi(c);
     } else if (!strncmp(c, "a", 1)) {
       P->ang = AngProdA;
       P->angprod.nbeta = atoi(++c);
@@ -192,6 +207,9 @@ void fprintProjectinfo(FILE* fp, const Projection* P)
   else if (P->ang == AngZCW)
     fprintf(fp, "# angular momentum projection - integration using ZCW set %d (%d angles)\n",
 	    P->angzcw.idx, nangles3(P->angzcw.idx));
+  else if (P->ang == AngAdapt)
+    fprintf(fp, "# angular momentum projection - nested product integration refined to relative accuracy 1e-%d\n",
+	    P->angadapt.tol);
 
   if (P->cm == CMNone)
     fprintf(fp, "# center of mass projection - none\n");
@@ -244,7 +262,9 @@ void* initprojectedmatrix(const Projection* P, int size, int n)
   char (**ppm)[size];
   int jmax=P->jmax;
 
-  ppm = malloc((jmax+1)*sizeof(void*));
+  // entries not used for odd/even j stay NULL,
+  // the additional last entry is used by initprojectedMBME
+  ppm = calloc(jmax+2, sizeof(void*));
   for (p=0; p<=1; p++)
     for (j=P->odd; j<jmax; j=j+2)
       ppm[idxpij(jmax,p,j)] = malloc(SQR(n*(j+1))*size);
@@ -308,7 +328,32 @@ void* initprojectedtransitionvectornull(const Projection* P,
 /// store projected MEs between two ManyBody states
 void* initprojectedMBME(const Projection* P, const ManyBodyOperator* Op)
 {
-  return initprojectedmatrix(P, (Op->rank+1)*Op->size*sizeof(complex double), 1);
+  void** ppm = initprojectedmatrix(P, (Op->rank+1)*Op->size*sizeof(complex double), 1);
+  ppm[P->jmax+1] = calloc(1, sizeof(projectedMBMEinfo));
+
+  return ppm;
+}
+
+
+void freeprojectedMBME(const Projection* P, void* mbme)
+{
+  void** ppm = mbme;
+  int p,j;
+  int jmax=P->jmax;
+
+  for (p=0; p<=1; p++)
+    for (j=P->odd; j<jmax; j=j+2)
+      free(ppm[idxpij(jmax,p,j)]);
+  free(ppm[jmax+1]);
+  free(ppm);
+}
+
+
+projectedMBMEinfo* getprojectedMBMEinfo(const Projection* P, const void* mbme)
+{
+  void* const* ppm = mbme;
+
+  return ppm[P->jmax+1];
 }
 
 
@@ -387,44 +432,243 @@ int writeprojectedMBME(gzFile fp, const Projection* P,
 }
 
 
-int writeprojectedMBMEtoFile(const char* mbfilea, const char* mbfileb,
-			     const Projection* P,
-			     const ManyBodyOperator* Op,
-			     Symmetry Sa, Symmetry Sb,
-			     const void* me)
+static void projectedMBMEfilename(char* mefilename,
+				  const char* mbfilea, const char* mbfileb,
+				  const Projection* P,
+				  const ManyBodyOperator* Op,
+				  Symmetry Sa, Symmetry Sb,
+				  const char* ext)
 {
-  gzFile mefp;
-  char mefilename[255];
-
-  ensuredir("ME");
-
-  snprintf(mefilename, 255, "ME/%s--%s%s--%s%s--%s.gz", 
+  snprintf(mefilename, 255, "ME/%s--%s%s--%s%s--%s.%s", 
 	   Op->name, 
 	   (Sa==0 ? "" : strjoin(SymmetrytoStr(Sa), ":")), 
 	   filepart(mbfilea), 
 	   (Sb==0 ? "" : strjoin(SymmetrytoStr(Sb), ":")), 
 	   filepart(mbfileb), 
-	   ProjectiontoStr(P));
+	   ProjectiontoStr(P),
+	   ext);
+}
+
+
+// binary matrix element files: header followed by the matrix elements
+// for all p, j in the idxpij, idxjmk layout used in memory,
+// only the dim used entries of each m, k
+
+#define MEBINMAGIC "FMDMEBIN"
+#define MEBINVERSION 4
+
+typedef struct {
+  char magic[8];
+  int version;
+  int jmax, odd;
+  int rank, dim, size;
+  Symmetry S, Sp;
+  char opname[80];
+  char projection[PROJSTRLEN];
+  char grid[PROJSTRLEN];	///< angular grid used by adaptive integration
+  char md5a[33], md5b[33];
+  char mbfilea[256], mbfileb[256];
+  long int n;			///< number of complex doubles following
+} mebinheader;
+
+
+// complex doubles stored per m, k and per p, j
+static long int projectedMBMErowsize(const ManyBodyOperator* Op)
+{
+  return (long int) (Op->rank+1)*Op->dim;
+}
 
-  if (!(mefp = gzopen(mefilename, "w"))) {
-    fprintf(stderr, "couldn't open %s for writing\n", mefilename);
+static long int projectedMBMEblocksize(const Projection* P, 
+				       const ManyBodyOperator* Op, int j)
+{
+  return SQR(j+1)*projectedMBMErowsize(Op);
+}
+
+
+static int _writeprojectedMBMEtoFile(const char* mbfilea, const char* mbfileb,
+				     const Projection* P,
+				     const ManyBodyOperator* Op,
+				     Symmetry Sa, Symmetry Sb,
+				     const void* me)
+{
+  FILE* mefp;
+  char mefilename[255], tmpfilename[280];
+  int jmax = P->jmax;
+  int odd = P->odd;
+  int rowsize = projectedMBMErowsize(Op);
+  int stride = (Op->rank+1)*Op->size;
+  complex double* const* mbme = (complex double* const*) me;
+  int p, j, mk;
+
+  if (usingMEDatabase())
+    return writeprojectedMBMEtoDatabase(mbfilea, mbfileb, P, Op, Sa, Sb, me);
+
+  ensuredir("ME");
+
+  projectedMBMEfilename(mefilename, mbfilea, mbfileb, P, Op, Sa, Sb, "bin");
+
+  // readers never see partially written files
+  snprintf(tmpfilename, 280, "%s.%d", mefilename, (int) getpid());
+
+  if (!(mefp = fopen(tmpfilename, "w"))) {
+    fprintf(stderr, "couldn't open %s for writing\n", tmpfilename);
     return -1;
   }
-    
-  gzprintinfo(mefp);
 
-  gzprintf(mefp, "<MBFile %s %s %d>\n", 
-	   mbfilea, md5hash(mbfilea), Sa);
-  gzprintf(mefp, "<MBFile %s %s %d>\n\n", 
-	   mbfileb, md5hash(mbfileb), Sb);
+  mebinheader h;
 
-  writeprojectedMBME(mefp, P, Op, Sa, Sb, me);
+  // header strings identify the matrix elements, they are never truncated
+  if (strlen(Op->name) >= sizeof(h.opname) ||
+      strlen(mbfilea) >= sizeof(h.mbfilea) ||
+      strlen(mbfileb) >= sizeof(h.mbfileb)) {
+    fprintf(stderr, "operator or file names too long for header of %s\n",
+	    mefilename);
+    fclose(mefp);
+    unlink(tmpfilename);
+    return -1;
+  }
 
-  gzclose(mefp);
+  char* projstr = ProjectiontoStr(P);
+  char* md5a = md5hash(mbfilea);
+  char* md5b = md5hash(mbfileb);
+
+  memset(&h, 0, sizeof(mebinheader));
+  memcpy(h.magic, MEBINMAGIC, 8);
+  h.version = MEBINVERSION;
+  h.jmax = jmax; h.odd = odd;
+  h.rank = Op->rank; h.dim = Op->dim; h.size = Op->size;
+  h.S = Sa; h.Sp = Sb;
+  strcpy(h.opname, Op->name);
+  strcpy(h.projection, projstr);
+  const projectedMBMEinfo* info = getprojectedMBMEinfo(P, me);
+  if (P->ang == AngAdapt && info)
+    snprintf(h.grid, PROJSTRLEN, "ang-cc-%d-%d-%d",
+	     info->grid[0], info->grid[1], info->grid[2]);
+  memcpy(h.md5a, md5a, 32);
+  memcpy(h.md5b, md5b, 32);
+  strcpy(h.mbfilea, mbfilea);
+  strcpy(h.mbfileb, mbfileb);
+  free(projstr); free(md5a); free(md5b);
+  h.n = 0;
+  for (p=0; p<=1; p++)
+    for (j=odd; j<jmax; j=j+2)
+      h.n += projectedMBMEblocksize(P, Op, j);
+
+  int ok = (fwrite(&h, sizeof(mebinheader), 1, mefp) == 1);
+  for (p=0; p<=1; p++)
+    for (j=odd; j<jmax; j=j+2)
+      for (mk=0; mk<SQR(j+1) && ok; mk++)
+	ok = (fwrite(mbme[idxpij(jmax,p,j)]+mk*stride, sizeof(complex double),
+		     rowsize, mefp) == rowsize);
+
+  if (fclose(mefp) || !ok || rename(tmpfilename, mefilename)) {
+    fprintf(stderr, "couldn't write %s\n", mefilename);
+    unlink(tmpfilename);
+    return -1;
+  }
 
   return 0;
 } 
 
+int writeprojectedMBMEtoFile(const char* mbfilea, const char* mbfileb,
+			     const Projection* P,
+			     const ManyBodyOperator* Op,
+			     Symmetry Sa, Symmetry Sb,
+			     const void* me)
+{
+  int res;
+
+  PROFILEBEGIN("ME file write")
+  res = _writeprojectedMBMEtoFile(mbfilea, mbfileb, P, Op, Sa, Sb, me);
+  PROFILEEND
+
+  return res;
+}
+
+
+static int readprojectedMBMEbinary(const char* mefilename,
+				   const char* mbfilea, const char* mbfileb, 
+				   const Projection* P,
+				   const ManyBodyOperator* Op,
+				   Symmetry Sa, Symmetry Sb,
+				   void* me)
+{
+  int jmax = P->jmax;
+  int odd = P->odd;
+  int rowsize = projectedMBMErowsize(Op);
+  int stride = (Op->rank+1)*Op->size;
+  complex double** mbme = me;
+  int p, j, mk;
+  int fd;
+  struct stat st;
+
+  if ((fd = open(mefilename, O_RDONLY)) < 0) {
+    fprintf(stderr, "... couldn't open %s for reading\n", mefilename);
+    return -1;
+  }
+  if (fstat(fd, &st) || st.st_size < sizeof(mebinheader)) {
+    fprintf(stderr, "... %s is not a matrix element file\n", mefilename);
+    close(fd);
+    return -2;
+  }
+
+  char* map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    fprintf(stderr, "... couldn't map %s\n", mefilename);
+    return -1;
+  }
+
+  fprintf(stderr, "... reading matrix elements from file %s\n", mefilename);
+
+  const mebinheader* h = (const mebinheader*) map;
+  int res = 0;
+
+  if (strncmp(h->magic, MEBINMAGIC, 8) || h->version != MEBINVERSION) {
+    fprintf(stderr, "...    not a binary matrix element file\n");
+    res = -2;
+  } else if (strncmp(h->opname, Op->name, 80) ||
+	     h->rank != Op->rank || h->dim != Op->dim || h->size != Op->size) {
+    fprintf(stderr, "...    not %s matrixelements\n", Op->name);
+    res = -2;
+  } else if (strncmp(h->md5a, md5hash(mbfilea), 32) || 
+	     strncmp(h->md5b, md5hash(mbfileb), 32)) {
+    fprintf(stderr, "...    MBFile does not match with existing ME\n");
+    res = -2;
+  } else if (h->S != Sa || h->Sp != Sb) {
+    fprintf(stderr, "...    Symmetry does not match with existing ME\n");
+    res = -2;
+  } else if (h->jmax != jmax || h->odd != odd ||
+	     st.st_size != sizeof(mebinheader)+h->n*sizeof(complex double)) {
+    fprintf(stderr, "...    Projection does not match with existing ME\n");
+    res = -2;
+  }
+
+  if (!res) {
+    const complex double* val = (const complex double*) (map+sizeof(mebinheader));
+    for (p=0; p<=1; p++)
+      for (j=odd; j<jmax; j=j+2)
+	for (mk=0; mk<SQR(j+1); mk++) {
+	  memcpy(mbme[idxpij(jmax,p,j)]+mk*stride, val, 
+		 rowsize*sizeof(complex double));
+	  val += rowsize;
+	}
+
+    projectedMBMEinfo* info = getprojectedMBMEinfo(P, me);
+    if (info) {
+      char grid[PROJSTRLEN];
+      memcpy(grid, h->grid, PROJSTRLEN); grid[PROJSTRLEN-1] = '\0';
+      if (sscanf(grid, "ang-cc-%d-%d-%d",
+		 &info->grid[0], &info->grid[1], &info->grid[2]) != 3)
+	info->grid[0] = info->grid[1] = info->grid[2] = 0;
+    }
+  }
+
+  munmap(map, st.st_size);
+
+  return res;
+}
+
 
 #define BUFSIZE 65536
 
@@ -523,11 +767,11 @@ int readprojectedMBME(gzFile fp,
 
 
 
-int readprojectedMBMEfromFile(const char* mbfilea, const char* mbfileb, 
-			      const Projection* P,
-			      const ManyBodyOperator* Op,
-			      Symmetry Sa, Symmetry Sb,
-			      void* mbme)
+static int _readprojectedMBMEfromFile(const char* mbfilea, const char* mbfileb, 
+				      const Projection* P,
+				      const ManyBodyOperator* Op,
+				      Symmetry Sa, Symmetry Sb,
+				      void* mbme)
 {
   gzFile mefp;
   char mefilename[255];
@@ -535,13 +779,18 @@ int readprojectedMBMEfromFile(const char* mbfilea, const char* mbfileb,
   char fnam[255], md5fnam[33];
   int fileS;
 
-  snprintf(mefilename, 255, "ME/%s--%s%s--%s%s--%s.gz", 
-	   Op->name, 
-	   (Sa==0 ? "" : strjoin(SymmetrytoStr(Sa), ":")), 
-	   filepart(mbfilea), 
-	   (Sb==0 ? "" : strjoin(SymmetrytoStr(Sb), ":")), 
-	   filepart(mbfileb), 
-	   ProjectiontoStr(P));
+  if (usingMEDatabase() &&
+      !readprojectedMBMEfromDatabase(mbfilea, mbfileb, P, Op, Sa, Sb, mbme))
+    return 0;
+
+  // binary files take precedence over text files
+  projectedMBMEfilename(mefilename, mbfilea, mbfileb, P, Op, Sa, Sb, "bin");
+
+  if (!fileexists(mefilename))
+    return readprojectedMBMEbinary(mefilename, mbfilea, mbfileb, 
+				   P, Op, Sa, Sb, mbme);
+
+  projectedMBMEfilename(mefilename, mbfilea, mbfileb, P, Op, Sa, Sb, "gz");
 
   if (fileexists(mefilename)) {
       fprintf(stderr, "... %s does not exist\n", mefilename);
@@ -600,6 +849,403 @@ int readprojectedMBMEfromFile(const char* mbfilea, const char* mbfileb,
   return res;
 }
 
+
+int readprojectedMBMEfromFile(const char* mbfilea, const char* mbfileb, 
+			      const Projection* P,
+			      const ManyBodyOperator* Op,
+			      Symmetry Sa, Symmetry Sb,
+			      void* mbme)
+{
+  int res;
+
+  PROFILEBEGIN("ME file read")
+  res = _readprojectedMBMEfromFile(mbfilea, mbfileb, P, Op, Sa, Sb, mbme);
+  PROFILEEND
+
+  return res;
+}
+
+// adaptive angular integration
+//
+// Clenshaw-Curtis rule in cos(beta) and trapezoidal rule in alpha, gamma
+// are refined by doubling the number of intervals, all points of the
+// coarser rules are reused; refinement in beta and in the azimuthal
+// angles continues until the projected matrix elements change less
+// than the requested tolerance
+
+// the quadrature rules converge exponentially, the error of the refined
+// rule is estimated from the last two changes as change^2/previous change
+
+#define ADAPTNBETA0 4
+#define ADAPTNBETAMAX 64
+#define ADAPTNAZIM0 4
+#define ADAPTNAZIMMAX 64
+
+typedef struct {
+  const Projection* P;
+  const ManyBodyOperator* Op;
+  const SlaterDet* Q;
+  const SlaterDet* Qp;
+  Symmetry S, Sp;
+  cmintegrationpara cmpara;
+  int compatible;
+  SlaterDetAuxinv Y;
+  int nbetamax;			///< intervals of finest beta rule, 0 if spherical
+  int axial, axialp;
+  void** T;			///< azimuthal sums for beta nodes of finest rule
+  double** d;			///< d^j_mk(beta) for beta nodes of finest rule
+} angadaptwork;
+
+
+static double angadaptbeta(const angadaptwork* W, int ib)
+{
+  return W->nbetamax ? ib*M_PI/W->nbetamax : 0.0;
+}
+
+
+// add contribution of rotation (alpha, beta, gamma) to the azimuthal sum T
+static void addangadaptpoint(const angadaptwork* W, int ib,
+			     double alpha, double gamma,
+			     SlaterDet Qpp[2], SlaterDetAux X[2])
+{
+  const Projection* P = W->P;
+  const ManyBodyOperator* Op = W->Op;
+  int size=Op->size;
+  int rank=Op->rank;
+  int dim=Op->dim;
+  complex double (**t)[(rank+1)*size] = W->T[ib];
+  const double* d = W->d[ib];
+  double beta = angadaptbeta(W, ib);
+
+  int jmax = P->jmax;
+  int odd = P->odd;
+  int nc = (rank+1)*dim;
+
+  complex double sval[(rank+1)*size];
+  complex double K[2][nc];
+  double xcm[3]; double weightcm;
+  int icm, ip, c;
+
+  for (c=0; c<nc; c++)
+    K[0][c] = K[1][c] = 0.0;
+
+  // cm integration and parity projection
+  for (icm=0; icm<W->cmpara.n; icm++) {
+    getcmintegrationpoint(icm, &W->cmpara, xcm, &weightcm);
+
+    copySlaterDet(W->Qp, &Qpp[0]);
+    moveSlaterDet(&Qpp[0], xcm);
+    if (Op->rotate)
+      Op->rotate(Op->par, &Qpp[0], alpha, beta, gamma);
+    rotateSlaterDet(&Qpp[0], alpha, beta, gamma);
+    copySlaterDet(&Qpp[0], &Qpp[1]);
+    invertSlaterDet(&Qpp[1]);
+
+    if (W->compatible)
+      calcSlaterDetAuxodinvparity(W->Q, &Qpp[0], &W->Y, &X[0], &X[1]);
+    else if (W->Q->A == W->Qp->A) {
+      calcSlaterDetAuxodsingular(W->Q, &Qpp[0], &X[0]);
+      calcSlaterDetAuxodsingular(W->Q, &Qpp[1], &X[1]);
+    }
+
+    for (ip=0; ip<=1; ip++) {
+      Op->me(Op->par, W->Q, &Qpp[ip], &X[ip], sval);
+      for (c=0; c<nc; c++) {
+	K[0][c] += 0.5*weightcm*sval[c];
+	K[1][c] += (ip ? -0.5 : 0.5)*weightcm*sval[c];
+      }
+    }
+  }
+
+  complex double ea[2*jmax-1], eg[2*jmax-1];
+  int m, k, j, p;
+  for (m=-(jmax-1); m<=jmax-1; m++) {
+    ea[m+jmax-1] = cexp(0.5*I*m*alpha);
+    eg[m+jmax-1] = cexp(0.5*I*m*gamma);
+  }
+
+  complex double w;
+  for (p=0; p<=1; p++)
+    for (j=odd; j<jmax; j=j+2)
+      for (k=-j; k<=j; k=k+2)
+	for (m=-j; m<=j; m=m+2)
+	  if ((Op->rank != 0 || SymmetryAllowed(W->S, p, j, m)) &&
+	      SymmetryAllowed(W->Sp, p, j, k)) {
+	    w = (j+1)/(8*SQR(M_PI))*
+	      ea[m+jmax-1]*eg[k+jmax-1]*d[idxdj(j)+idxjmk(j,m,k)];
+	    for (c=0; c<nc; c++)
+	      t[idxpij(jmax,p,j)][idxjmk(j,m,k)][c] += w*K[p][c];
+	  }
+}
+
+
+// azimuthal sums with na intervals for beta nodes ib[0..nb-1],
+// only points not contained in the rule with na/2 intervals if refine
+static void angadaptsweep(angadaptwork* W, const int* ib, int nb,
+			  int na, int refine)
+{
+  int nalpha = W->axial ? 1 : na;
+  int ngamma = W->axialp ? 1 : na;
+  int i;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    SlaterDet Qpp[2];
+    SlaterDetAux X[2];
+    int ia, ig;
+
+    initSlaterDet(W->Qp, &Qpp[0]);
+    initSlaterDet(W->Qp, &Qpp[1]);
+    initSlaterDetAux(W->Q, &X[0]);
+    initSlaterDetAux(W->Q, &X[1]);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (i=0; i<nb; i++)
+      for (ig=0; ig<ngamma; ig++)
+	for (ia=0; ia<nalpha; ia++) {
+	  if (refine && !(ia%2) && !(ig%2))
+	    continue;
+	  addangadaptpoint(W, ib[i], 2*M_PI*ia/nalpha, 2*M_PI*ig/ngamma,
+			   Qpp, X);
+	  PROFILECOUNT("projection points", W->cmpara.n);
+	}
+
+    freeSlaterDetAux(&X[0]);
+    freeSlaterDetAux(&X[1]);
+    freeSlaterDet(&Qpp[0]);
+    freeSlaterDet(&Qpp[1]);
+  }
+}
+
+
+static void zeroprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
+			      void* mbme)
+{
+  complex double (**val)[(Op->rank+1)*Op->size] = mbme;
+  int p, j, k, c;
+
+  for (p=0; p<=1; p++)
+    for (j=P->odd; j<P->jmax; j=j+2)
+      for (k=0; k<SQR(j+1); k++)
+	for (c=0; c<(Op->rank+1)*Op->size; c++)
+	  val[idxpij(P->jmax,p,j)][k][c] = 0.0;
+}
+
+
+static void copyprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
+			      const void* mbme, void* mbmecpy)
+{
+  void* const* val = mbme;
+  void** cpy = mbmecpy;
+  int p, j;
+
+  for (p=0; p<=1; p++)
+    for (j=P->odd; j<P->jmax; j=j+2)
+      memcpy(cpy[idxpij(P->jmax,p,j)], val[idxpij(P->jmax,p,j)],
+	     SQR(j+1)*(Op->rank+1)*Op->size*sizeof(complex double));
+}
+
+
+// azimuthal sums and d-functions for new beta nodes
+static void angadaptnodes(angadaptwork* W, const int* ib, int nb)
+{
+  int i;
+
+  for (i=0; i<nb; i++) {
+    W->T[ib[i]] = initprojectedMBME(W->P, W->Op);
+    zeroprojectedMBME(W->P, W->Op, W->T[ib[i]]);
+    W->d[ib[i]] = malloc(idxdj(W->P->jmax)*sizeof(double));
+    djmktable(W->P->jmax, angadaptbeta(W, ib[i]), W->d[ib[i]]);
+  }
+}
+
+
+// integrate azimuthal sums with nb beta intervals and na azimuthal intervals
+static void angadaptintegrate(const angadaptwork* W, int nb, int na,
+			      void* mbme)
+{
+  const Projection* P = W->P;
+  const ManyBodyOperator* Op = W->Op;
+  int nc = (Op->rank+1)*Op->size;
+  complex double (**val)[nc] = mbme;
+  int nalpha = W->axial ? 1 : na;
+  int ngamma = W->axialp ? 1 : na;
+  double x[nb+1], wb[nb+1];
+  int i, p, j, k, c;
+
+  if (nb)
+    ClenshawCurtisPoints(nb+1, -1.0, 1.0, x, wb);
+  else
+    wb[0] = 2.0;
+
+  zeroprojectedMBME(P, Op, mbme);
+
+  for (i=0; i<=nb; i++) {
+    complex double (**t)[nc] = W->T[nb ? i*(W->nbetamax/nb) : 0];
+    double w = wb[i]*(2*M_PI/nalpha)*(2*M_PI/ngamma);
+
+    for (p=0; p<=1; p++)
+      for (j=P->odd; j<P->jmax; j=j+2)
+	for (k=0; k<SQR(j+1); k++)
+	  for (c=0; c<nc; c++)
+	    val[idxpij(P->jmax,p,j)][k][c] += w*t[idxpij(P->jmax,p,j)][k][c];
+  }
+}
+
+
+// largest change of the matrix elements of any (p,j) level relative
+// to the largest matrix element of that level, levels negligible
+// compared to the largest matrix element of the operator component
+// are ignored
+static double angadaptchange(const Projection* P, const ManyBodyOperator* Op,
+			     double tol, void* mbme, void* mbmeold)
+{
+  int nc = (Op->rank+1)*Op->dim;
+  complex double (**val)[(Op->rank+1)*Op->size] = mbme;
+  complex double (**old)[(Op->rank+1)*Op->size] = mbmeold;
+  int nl = idxpij(P->jmax,1,P->jmax)+1;
+  double scale[nc], lscale[nl][nc], ldiff[nl][nc];
+  int p, j, l, k, c;
+
+  for (c=0; c<nc; c++)
+    scale[c] = 0.0;
+  for (l=0; l<nl; l++)
+    for (c=0; c<nc; c++)
+      lscale[l][c] = ldiff[l][c] = 0.0;
+
+  for (p=0; p<=1; p++)
+    for (j=P->odd; j<P->jmax; j=j+2) {
+      l = idxpij(P->jmax,p,j);
+      for (k=0; k<SQR(j+1); k++)
+	for (c=0; c<nc; c++) {
+	  lscale[l][c] = fmax(lscale[l][c], cabs(val[l][k][c]));
+	  ldiff[l][c] = fmax(ldiff[l][c], cabs(val[l][k][c]-old[l][k][c]));
+	}
+      for (c=0; c<nc; c++)
+	scale[c] = fmax(scale[c], lscale[l][c]);
+    }
+
+  double change = 0.0;
+  for (l=0; l<nl; l++)
+    for (c=0; c<nc; c++)
+      if (lscale[l][c] > tol*scale[c] && lscale[l][c] > 0.0)
+	change = fmax(change, ldiff[l][c]/lscale[l][c]);
+
+  return change;
+}
+
+
+static void calcprojectedMBMEadapt(const Projection* P, 
+				   const ManyBodyOperator* Op,
+				   const SlaterDet* Q, const SlaterDet* Qp,
+				   Symmetry S, Symmetry Sp,
+				   void* mbme)
+{
+  PROFILEBEGIN("calcprojectedMBME")
+  double tol = pow(10.0, -(double) P->angadapt.tol);
+
+  angadaptwork W;
+  W.P = P; W.Op = Op;
+  W.Q = Q; W.Qp = Qp;
+  W.S = S; W.Sp = Sp;
+  initcmintegration(P, Q, Qp, &W.cmpara);
+
+  W.compatible = (Q->A == Qp->A && Q->Z == Qp->Z && Q->N == Qp->N);
+  if (W.compatible)
+    initSlaterDetAuxinv(Q, Qp, &W.Y);
+
+  // symmetries reduce the integration
+  W.nbetamax = hasSymmetry(S, spherical) ? 0 : ADAPTNBETAMAX;
+  W.axial = hasAxialSymmetry(S);
+  W.axialp = hasAxialSymmetry(Sp);
+  int nazimmax = (W.axial && W.axialp) ? 1 : ADAPTNAZIMMAX;
+
+  W.T = calloc(W.nbetamax+1, sizeof(void*));
+  W.d = calloc(W.nbetamax+1, sizeof(double*));
+
+  int ib[W.nbetamax+1];
+  int nb = W.nbetamax ? ADAPTNBETA0 : 0;
+  int na = nazimmax > 1 ? ADAPTNAZIM0 : 1;
+  int nnew, i;
+
+  // start with coarsest rules
+  for (i=0; i<=nb; i++)
+    ib[i] = nb ? i*(W.nbetamax/nb) : 0;
+  angadaptnodes(&W, ib, nb+1);
+  angadaptsweep(&W, ib, nb+1, na, 0);
+  angadaptintegrate(&W, nb, na, mbme);
+
+  void* old = initprojectedMBME(P, Op);
+  double dbeta = W.nbetamax ? 1.0 : 0.0;
+  double dazim = nazimmax > 1 ? 1.0 : 0.0;
+  double cbeta = 0.0, cazim = 0.0, change;
+  int refined = 1;
+
+  while (refined) {
+    refined = 0;
+
+    // new beta nodes at odd positions of the refined rule
+    if (dbeta > tol && nb < W.nbetamax) {
+      copyprojectedMBME(P, Op, mbme, old);
+      nb *= 2;
+      nnew = 0;
+      for (i=1; i<=nb; i=i+2)
+	ib[nnew++] = i*(W.nbetamax/nb);
+      angadaptnodes(&W, ib, nnew);
+      angadaptsweep(&W, ib, nnew, na, 0);
+      angadaptintegrate(&W, nb, na, mbme);
+      change = angadaptchange(P, Op, tol, mbme, old);
+      dbeta = change < cbeta ? SQR(change)/cbeta : change;
+      cbeta = change;
+      refined = 1;
+    }
+
+    // new azimuthal points on all beta nodes
+    if (dazim > tol && na < nazimmax) {
+      copyprojectedMBME(P, Op, mbme, old);
+      na *= 2;
+      for (i=0; i<=nb; i++)
+	ib[i] = nb ? i*(W.nbetamax/nb) : 0;
+      angadaptsweep(&W, ib, nb+1, na, 1);
+      angadaptintegrate(&W, nb, na, mbme);
+      change = angadaptchange(P, Op, tol, mbme, old);
+      dazim = change < cazim ? SQR(change)/cazim : change;
+      cazim = change;
+      refined = 1;
+    }
+  }
+
+  if (dbeta > tol || dazim > tol)
+    fprintf(stderr, "... adaptive angular integration not converged, estimated error %8.2e\n",
+	    fmax(dbeta, dazim));
+
+  int nalpha = W.axial ? 1 : na;
+  int ngamma = W.axialp ? 1 : na;
+  projectedMBMEinfo* info = getprojectedMBMEinfo(P, mbme);
+  if (info) {
+    info->grid[0] = nalpha; info->grid[1] = nb+1; info->grid[2] = ngamma;
+  }
+  fprintf(stderr, "... adaptive angular integration with %d,%d,%d points\n",
+	  nalpha, nb+1, ngamma);
+
+  for (i=0; i<=W.nbetamax; i++)
+    if (W.T[i]) {
+      freeprojectedMBME(P, W.T[i]);
+      free(W.d[i]);
+    }
+  free(W.T);
+  free(W.d);
+  freeprojectedMBME(P, old);
+  if (W.compatible)
+    freeSlaterDetAuxinv(&W.Y);
+  PROFILEEND
+}
+
+
 // 07/13/09 important change: do not normalize Q and Qp anymore
 
 void calcprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
@@ -607,20 +1253,21 @@ void calcprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
 		       Symmetry S, Symmetry Sp,
 		       void* mbme)
 {
+  if (P->ang == AngAdapt) {
+    calcprojectedMBMEadapt(P, Op, Q, Qp, S, Sp, mbme);
+    return;
+  }
+  PROFILEBEGIN("calcprojectedMBME")
+
   int size=Op->size;
   int rank=Op->rank;
   int dim=Op->dim;
   complex double (**val)[(rank+1)*size] = mbme;
 
-  SlaterDet Qpp;
-  SlaterDetAux X;
-
   int jmax = P->jmax;
   int odd = P->odd;
 
   // norms of SlaterDets
-  initSlaterDetAux(Q, &X);
-
   // calcSlaterDetAuxod(Q, Q, &X);
   // double norm = sqrt(creal(X.ovlap));
 
@@ -637,6 +1284,14 @@ void calcprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
   angintegrationpara angpara;
   initangintegration(P, Q, Qp, S, Sp, &angpara);
   int nang = angpara.n;
+  const angDtable* Dtab = getangDtable(&angpara, jmax);
+
+  // diagonal matrix elements of hermitian scalar operators
+  // <Q|Op R(Omega^-1)|Q> = <Q|Op R(Omega)|Q>^*, only one point of each
+  // pair of inverse rotations has to be calculated
+  int herm = (S == Sp && usingHermiticity(Op) &&
+	      (P->cm == CMNone || P->cm == CMSimple) && angHermitian(&angpara) &&
+	      sameSlaterDet(Q, Qp));
 
   int l, r;
   int p, j, m, k;
@@ -651,41 +1306,82 @@ void calcprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
 	      val[idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] = 0.0;
     }	
 
-  initSlaterDet(Qp, &Qpp);
-  
-  int icm; 
-  double xcm[3]; double weightcm;
+  // integration points are distributed over the threads,
+  // each thread works on its own copy of Qp and accumulates
+  // into private matrix elements
+  int nrot = ncm*nang;
+  PROFILECOUNT("projection points", nrot);
+
+  // Gaussian pair auxiliaries not changing over the integration points
+  SlaterDetAuxinv Y;
+  int compatible = (Q->A == Qp->A && Q->Z == Qp->Z && Q->N == Qp->N);
+  if (compatible)
+    initSlaterDetAuxinv(Q, Qp, &Y);
+
+#ifdef _OPENMP
+#pragma omp parallel private(l, r, p, j, m, k)
+#endif
+  {
+    // Qp rotated and its parity image, calculated together
+    SlaterDet Qpp[2];
+    SlaterDetAux X[2];
+
+    initSlaterDet(Qp, &Qpp[0]);
+    initSlaterDet(Qp, &Qpp[1]);
+    initSlaterDetAux(Q, &X[0]);
+    initSlaterDetAux(Q, &X[1]);
+
+    complex double (**pval)[(rank+1)*size] = initprojectedMBME(P, Op);
+    for (p=0; p<=1; p++)
+      for (j=odd; j<jmax; j=j+2)
+	for (k=0; k<SQR(j+1); k++)
+	  for (l=0; l<(rank+1)*size; l++)
+	    pval[idxpij(jmax,p,j)][k][l] = 0.0;
 
-  int iang;
-  double alpha, beta, gamma; double weightang;
+    int irot, icm; 
+    double xcm[3]; double weightcm;
 
-  complex double sval[(rank+1)*size];
-  double weight;
-  int ip;
+    int iang;
+    double alpha, beta, gamma; double weightang;
+
+    complex double sval[(rank+1)*size];
+    double weight;
+    int ip;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (irot=0; irot<nrot; irot++) {
+      icm = irot/nang; iang = irot%nang;
 
-  for (icm=0; icm<ncm; icm++) {
-    getcmintegrationpoint(icm, &cmpara, xcm, &weightcm);
+      if (herm && angpara.inv[iang] < iang)
+	continue;
 
-    for (iang=0; iang<nang; iang++) {
+      getcmintegrationpoint(icm, &cmpara, xcm, &weightcm);
       getangintegrationpoint(iang, &angpara, &alpha, &beta, &gamma, &weightang);
       // weight = 1.0/(2*norm*normp)*weightcm*weightang;
       weight = 0.5*weightcm*weightang;
+      if (herm)
+	weight *= angHermitianweight(&angpara, iang);
       
-      copySlaterDet(Qp, &Qpp);
-      moveSlaterDet(&Qpp, xcm);
-      rotateSlaterDet(&Qpp, alpha, beta, gamma);
+      copySlaterDet(Qp, &Qpp[0]);
+      moveSlaterDet(&Qpp[0], xcm);
+      if (Op->rotate)
+	Op->rotate(Op->par, &Qpp[0], alpha, beta, gamma);
+      rotateSlaterDet(&Qpp[0], alpha, beta, gamma);
+      copySlaterDet(&Qpp[0], &Qpp[1]);
+      invertSlaterDet(&Qpp[1]);
+
+      // can only calculate Auxilliaries if Sldets are compatible
+      if (compatible)
+	calcSlaterDetAuxodinvparity(Q, &Qpp[0], &Y, &X[0], &X[1]);
+      else if (Q->A == Qp->A) {
+	calcSlaterDetAuxodsingular(Q, &Qpp[0], &X[0]);
+	calcSlaterDetAuxodsingular(Q, &Qpp[1], &X[1]);
+      }
 
       for (ip=0; ip<=1; ip++) {
-	  if (ip) invertSlaterDet(&Qpp);
-
-	  // can only calculate Auxilliaries if Sldets are compatible
-	  if (Q->A == Qp->A) {
-            if (Q->Z == Qp->Z && Q->N == Qp->N)
-              calcSlaterDetAuxod(Q, &Qpp, &X);
-            else
-              calcSlaterDetAuxodsingular(Q, &Qpp, &X);
-          }
-	  Op->me(Op->par, Q, &Qpp, &X, sval);
+	  Op->me(Op->par, Q, &Qpp[ip], &X[ip], sval);
 
 	  complex double w;
 	  for (p=0; p<=1; p++)
@@ -695,10 +1391,10 @@ void calcprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
 		  if ((Op->rank != 0 || SymmetryAllowed(S, p, j, m)) &&
 		      SymmetryAllowed(Sp, p, j, k)) {
 		    w = weight * (p && ip%2 ? -1 : 1)*
-		      (j+1)/(8*SQR(M_PI))*Djmkstar(j,m,k,alpha,beta,gamma);
+		      (j+1)/(8*SQR(M_PI))*angDstar(Dtab,iang,j,m,k);
 		    for (l=0; l<dim; l++)
 		      for (r=0; r<=rank; r++)
-			val[idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] += 
+			pval[idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] += 
 			  w*sval[r+l*(rank+1)];
 		  }	
 		}	
@@ -706,10 +1402,41 @@ void calcprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
 
     }
 
+    // collect the contributions of all threads
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+    for (p=0; p<=1; p++)
+      for (j=odd; j<jmax; j=j+2)
+	for (k=0; k<SQR(j+1); k++)
+	  for (l=0; l<dim; l++)
+	    for (r=0; r<=rank; r++)
+	      val[idxpij(jmax,p,j)][k][r+l*(rank+1)] += 
+		pval[idxpij(jmax,p,j)][k][r+l*(rank+1)];
+
+    freeprojectedMBME(P, pval);
+    freeSlaterDetAux(&X[0]);
+    freeSlaterDetAux(&X[1]);
+    freeSlaterDet(&Qpp[0]);
+    freeSlaterDet(&Qpp[1]);
   }
-  freeSlaterDetAux(&X);
-  freeSlaterDet(&Qpp);
-}	
+
+  if (compatible)
+    freeSlaterDetAuxinv(&Y);
+
+  // contributions of the inverse rotations
+  if (herm)
+    for (p=0; p<=1; p++)
+      for (j=odd; j<jmax; j=j+2)
+	for (k=-j; k<=j; k=k+2)
+	  for (m=-j; m<=k; m=m+2)
+	    for (l=0; l<dim; l++)
+	      angHermitianpair(&val[idxpij(jmax,p,j)][idxjmk(j,m,k)][l],
+			       &val[idxpij(jmax,p,j)][idxjmk(j,k,m)][l]);
+
+  freeAngintegration(&angpara);
+  PROFILEEND
+}
 
 
 void calcprojectedMBMEs(const Projection* P, const ManyBodyOperators* Ops,
@@ -717,18 +1444,15 @@ void calcprojectedMBMEs(const Projection* P, const ManyBodyOperators* Ops,
 			Symmetry S, Symmetry Sp,
 			void* mbme)
 {
+  PROFILEBEGIN("calcprojectedMBMEs")
   int size=Ops->size;
   int dim=Ops->dim;
   complex double ***val = mbme;
 
-  SlaterDet Qpp;
-  SlaterDetAux  X;
-
   int jmax = P->jmax;
   int odd = P->odd;
 
   // norms of SlaterDets
-  initSlaterDetAux(Q, &X);
   // calcSlaterDetAuxod(Q, Q, &X);
   // double norm = sqrt(creal(X.ovlap));
 
@@ -745,6 +1469,7 @@ void calcprojectedMBMEs(const Projection* P, const ManyBodyOperators* Ops,
   angintegrationpara angpara;
   initangintegration(P, Q, Qp, S, Sp, &angpara);
   int nang = angpara.n;
+  const angDtable* Dtab = getangDtable(&angpara, jmax);
 
   int l, r;
   int o, p, j, m, k;
@@ -779,42 +1504,77 @@ void calcprojectedMBMEs(const Projection* P, const ManyBodyOperators* Ops,
 		val[o][idxpij(jmax,p,j)][r+l*(ranko[o]+1)+idxjmk(j,m,k)*sizeo[o]] = 0.0;
     }	
 
-  initSlaterDet(Qp, &Qpp);
-  
-  int icm; 
-  double xcm[3]; double weightcm;
+  // integration points are distributed over the threads,
+  // each thread works on its own copy of Qp and accumulates
+  // into private matrix elements
+  int nrot = ncm*nang;
+  PROFILECOUNT("projection points", nrot);
+
+  // Gaussian pair auxiliaries not changing over the integration points
+  SlaterDetAuxinv Y;
+  int compatible = (Q->A == Qp->A && Q->Z == Qp->Z && Q->N == Qp->N);
+  if (compatible)
+    initSlaterDetAuxinv(Q, Qp, &Y);
+
+#ifdef _OPENMP
+#pragma omp parallel private(l, r, o, p, j, m, k)
+#endif
+  {
+    // Qp rotated and its parity image, calculated together
+    SlaterDet Qpp[2];
+    SlaterDetAux X[2];
+
+    initSlaterDet(Qp, &Qpp[0]);
+    initSlaterDet(Qp, &Qpp[1]);
+    initSlaterDetAux(Q, &X[0]);
+    initSlaterDetAux(Q, &X[1]);
+
+    complex double **pval[Ops->n];
+    for (o=0; o<Ops->n; o++) {
+      pval[o] = initprojectedmatrix(P, sizeo[o]*sizeof(complex double), 1);
+      for (p=0; p<=1; p++)
+	for (j=odd; j<jmax; j=j+2)
+	  for (l=0; l<SQR(j+1)*sizeo[o]; l++)
+	    pval[o][idxpij(jmax,p,j)][l] = 0.0;
+    }
 
-  int iang;
-  double alpha, beta, gamma; double weightang;
+    int irot, icm; 
+    double xcm[3]; double weightcm;
 
+    int iang;
+    double alpha, beta, gamma; double weightang;
 
-  complex double sval[no];
-  double weight;
-  int ip;
+    complex double sval[no];
+    double weight;
+    int ip;
 
-  for (icm=0; icm<ncm; icm++) {
-    getcmintegrationpoint(icm, &cmpara, xcm, &weightcm);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (irot=0; irot<nrot; irot++) {
+      icm = irot/nang; iang = irot%nang;
 
-    for (iang=0; iang<nang; iang++) {
+      getcmintegrationpoint(icm, &cmpara, xcm, &weightcm);
       getangintegrationpoint(iang, &angpara, &alpha, &beta, &gamma, &weightang);
       // weight = 1.0/(2*norm*normp)*weightcm*weightang;
       weight = 0.5*weightcm*weightang;
       
-      copySlaterDet(Qp, &Qpp);
-      moveSlaterDet(&Qpp, xcm);
-      rotateSlaterDet(&Qpp, alpha, beta, gamma);
+      copySlaterDet(Qp, &Qpp[0]);
+      moveSlaterDet(&Qpp[0], xcm);
+      rotateSlaterDet(&Qpp[0], alpha, beta, gamma);
+      copySlaterDet(&Qpp[0], &Qpp[1]);
+      invertSlaterDet(&Qpp[1]);
+
+      // can only calculate Auxilliaries if Sldets are compatible
+      if (compatible)
+	calcSlaterDetAuxodinvparity(Q, &Qpp[0], &Y, &X[0], &X[1]);
+      else if (Q->A == Qp->A) {
+	calcSlaterDetAuxodsingular(Q, &Qpp[0], &X[0]);
+	calcSlaterDetAuxodsingular(Q, &Qpp[1], &X[1]);
+      }
 
       for (ip=0; ip<=1; ip++) {
-	  if (ip) invertSlaterDet(&Qpp);
-
-	  // can only calculate Auxilliaries if Sldets are compatible
-	  if (Q->A == Qp->A) {
-            if (Q->Z == Qp->Z && Q->N == Qp->N)
-              calcSlaterDetAuxod(Q, &Qpp, &X);
-            else
-              calcSlaterDetAuxodsingular(Q, &Qpp, &X);
-          }
-	  Ops->me(Ops->par, Q, &Qpp, &X, sval);
+	  Ops->me(Ops->par, Q, &Qpp[ip], &X[ip], sval);
 
 	  complex double w;
 	  for (o=0; o<Ops->n; o++)
@@ -825,21 +1585,42 @@ void calcprojectedMBMEs(const Projection* P, const ManyBodyOperators* Ops,
 		    if ((ranko[o] != 0 || SymmetryAllowed(S, p, j, m)) &&
 			SymmetryAllowed(Sp, p, j, k)) {
 		      w = weight * (p && ip%2 ? -1 : 1)*
-			(j+1)/(8*SQR(M_PI))*Djmkstar(j,m,k,alpha,beta,gamma);
+			(j+1)/(8*SQR(M_PI))*angDstar(Dtab,iang,j,m,k);
 		      for (l=0; l<dim; l++)
 			for (r=0; r<=ranko[o]; r++)
-			  val[o][idxpij(jmax,p,j)][r+l*(ranko[o]+1)+idxjmk(j,m,k)*sizeo[o]] += 
+			  pval[o][idxpij(jmax,p,j)][r+l*(ranko[o]+1)+idxjmk(j,m,k)*sizeo[o]] += 
 			    w*sval[r+l*(ranko[o]+1)+io[o]];
 		  }	
 		}	
       }
 
-    }
+    }	
 
-  }	
-  freeSlaterDetAux(&X);
-  freeSlaterDet(&Qpp);
-}	
+    // collect the contributions of all threads
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+    for (o=0; o<Ops->n; o++)
+      for (p=0; p<=1; p++)
+	for (j=odd; j<jmax; j=j+2)
+	  for (k=0; k<SQR(j+1); k++)
+	    for (l=0; l<dim; l++)
+	      for (r=0; r<=ranko[o]; r++)
+		val[o][idxpij(jmax,p,j)][r+l*(ranko[o]+1)+k*sizeo[o]] += 
+		  pval[o][idxpij(jmax,p,j)][r+l*(ranko[o]+1)+k*sizeo[o]];
+
+    for (o=0; o<Ops->n; o++)
+      freeprojectedMBME(P, pval[o]);
+    freeSlaterDetAux(&X[0]);
+    freeSlaterDetAux(&X[1]);
+    freeSlaterDet(&Qpp[0]);
+    freeSlaterDet(&Qpp[1]);
+  }
+
+  if (compatible)
+    freeSlaterDetAuxinv(&Y);
+  PROFILEEND
+}
 
 
 void hermitizeprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
@@ -875,6 +1656,57 @@ void hermitizeprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
 	      }
 }    
 
+
+static int hermiticity = 0;
+
+void useHermiticity(int flag)
+{
+  hermiticity = flag;
+}
+
+
+int usingHermiticity(const ManyBodyOperator* Op)
+{
+  return (hermiticity && Op->rank == 0 && !Op->pi);
+}
+
+
+// <Qp|Op P^j_mk|Q> = <Q|Op P^j_km|Qp>^*
+
+void adjointprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
+			  const void* mbme, void* adjmbme)
+{
+  int size=Op->size;
+  int rank=Op->rank;
+  int dim=Op->dim;
+  complex double (**val)[(rank+1)*size] = (void*) mbme;
+  complex double (**adj)[(rank+1)*size] = adjmbme;
+
+  int jmax = P->jmax;
+  int odd = P->odd;
+
+  int p, j, m, k;
+  int l, r;
+
+  for (p=0; p<=1; p++)
+    for (j=odd; j<jmax; j=j+2)
+      for (k=-j; k<=j; k=k+2)
+	for (m=-j; m<=j; m=m+2)
+	  for (l=0; l<dim; l++) 
+	    for (r=0; r<=rank; r++)
+	      adj[idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] =
+		conj(val[idxpij(jmax,p,j)][idxjmk(j,k,m)][r+l*(rank+1)]);
+
+  // alpha and gamma exchange their roles
+  const projectedMBMEinfo* info = getprojectedMBMEinfo(P, mbme);
+  projectedMBMEinfo* adjinfo = getprojectedMBMEinfo(P, adjmbme);
+  if (info && adjinfo) {
+    adjinfo->grid[0] = info->grid[2];
+    adjinfo->grid[1] = info->grid[1];
+    adjinfo->grid[2] = info->grid[0];
+  }
+}
+
 // calculates reduced matrix element divided by sqrt(2j+1)
 
 void calcexpectprojectedMBME(const Projection* P,
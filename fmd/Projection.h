@@ -20,6 +20,8 @@
 #include "Observables.h"
 #include "Symmetry.h"
 
+#include "numerics/wignerd.h"
+
 
 /// Integration for CM projection using Product integration or Polyhedron points
 enum { CMNone, CMSimple, CMProd, CMPoly };
@@ -49,7 +51,8 @@ typedef struct {
 
 
 /// Integration over Euler angles using Product integration or ZCW points
-enum { AngNone, AngProd, AngProdA, AngZCW };
+/// or nested product rules refined until converged
+enum { AngNone, AngProd, AngProdA, AngZCW, AngAdapt };
 
 typedef struct {
   unsigned int nazimuth : 8;
@@ -60,6 +63,10 @@ typedef struct {
   unsigned int idx : 8;
 } angzcwpara;
 
+typedef struct {
+  unsigned int tol : 8;		///< relative tolerance 10^-tol
+} angadaptpara;
+
 
 typedef struct {
   int idx;
@@ -85,9 +92,23 @@ typedef struct {
     angzcwintegrationpara zcw;
     angprodintegrationpara prod;
   };   
+  int* inv;			///< index of inverse rotation, NULL if grid not closed
 } angintegrationpara;
 
 
+/// Wigner D-functions tabulated on angular integration grid
+typedef struct {
+  int jmax;
+  int n;			///< number of integration points
+  int nd;			///< size of d-table for each beta
+  double (*angle)[3];		///< Euler angles of integration points
+  int* ibeta;			///< beta index of integration points
+  double* d;			///< d^j_mk(beta) for all j < jmax
+  complex double* ealpha;	///< exp(i m alpha/2) for all integration points
+  complex double* egamma;	///< exp(i k gamma/2) for all integration points
+} angDtable;
+
+
 /// Projection
 typedef struct {
   int jmax;		///< calculate up to (jmax-1)/2
@@ -98,6 +119,7 @@ typedef struct {
   union {
     angprodpara angprod;
     angzcwpara angzcw;
+    angadaptpara angadapt;
   };
   int cm;		///< type of cm projection
   union {
@@ -119,6 +141,10 @@ typedef struct {
 	     const SlaterDet* Q, const SlaterDet* Qp,
 	     const SlaterDetAux* X,
 	     complex double *val);
+  /// optional, called with unrotated Qp before me is called
+  /// with Qp rotated by Euler angles alpha, beta, gamma
+  void (*rotate)(void* parameters, const SlaterDet* Qp,
+		 double alpha, double beta, double gamma);
 } ManyBodyOperator;
 
 
@@ -189,6 +215,9 @@ inline static int idxjmk(int j, int m, int k)
 
 char* AngmomtoStr(int j, int pi);
 
+/// longest string returned by ProjectiontoStr, including terminating 0
+#define PROJSTRLEN 96
+
 char* ProjectiontoStr(const Projection* P);
 
 int initAngintegration(angintegrationpara* par, const char* projpar);
@@ -215,8 +244,18 @@ void* initprojectedtransitionVectornull(const Projection* P, const ManyBodyOpera
 					int n, int np);
 
 
+/// stored with the matrix elements allocated by initprojectedMBME
+typedef struct {
+  int grid[3];		///< nalpha, nbeta, ngamma used by ang-adapt, 0 otherwise
+} projectedMBMEinfo;
+
 void* initprojectedMBME(const Projection* P, const ManyBodyOperator* Op);
 
+void freeprojectedMBME(const Projection* P, void* mbme);
+
+/// info of matrix elements mbme, NULL if not allocated by initprojectedMBME
+projectedMBMEinfo* getprojectedMBMEinfo(const Projection* P, const void* mbme);
+
 
 void initcmintegration(const Projection* P, 
 		       const SlaterDet* Q, const SlaterDet* Qp,
@@ -265,6 +304,41 @@ void getangintegrationpoint(int i, const angintegrationpara* par,
 			    double* alpha, double* beta, double* gamma, 
 			    double* w);
 
+/// grid closed under inversion, for diagonal matrix elements of hermitian
+/// scalar operators only points with inv[i] >= i have to be calculated
+inline static int angHermitian(const angintegrationpara* par)
+{
+  return (par->inv != NULL);
+}
+
+/// weight factor for integration point i if only half of the grid is used,
+/// the other half is obtained by adding the hermitian conjugate
+inline static double angHermitianweight(const angintegrationpara* par, int i)
+{
+  return (par->inv[i] < i ? 0.0 : (par->inv[i] == i ? 0.5 : 1.0));
+}
+
+/// add contributions of the inverse rotations to the matrix elements
+/// amk and akm calculated on half of the grid
+inline static void angHermitianpair(complex double* amk, complex double* akm)
+{
+  complex double a = *amk, b = *akm;
+  *amk = a + conj(b);
+  *akm = b + conj(a);
+}
+
+/// cached table of D-functions for integration grid par
+const angDtable* getangDtable(const angintegrationpara* par, int jmax);
+
+/// D^j_mk*(alpha,beta,gamma) at integration point i
+inline static complex double angDstar(const angDtable* D, 
+				      int i, int j, int m, int k)
+{
+  int nph = 2*D->jmax-1;
+  return (D->ealpha[m+D->jmax-1+i*nph]*D->egamma[k+D->jmax-1+i*nph]*
+	  D->d[idxdj(j)+idxjmk(j,m,k)+D->ibeta[i]*D->nd]);
+}
+
 
 void calcprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
 		       const SlaterDet* Q, const SlaterDet* Qp,
@@ -278,16 +352,22 @@ void calcprojectedMBMEs(const Projection* P, const ManyBodyOperators* Ops,
 			void* mbmes);
 
 
-void calcprojectedMBMEsingular(const Projection* P, const ManyBodyOperator* Op,
-			       const SlaterDet* Q, const SlaterDet* Qp,
-			       Symmetry S, Symmetry Sp,
-			       void* mbme);
-
-
 void hermitizeprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
 			    void* mbme, int n);
 
 
+/// calculate only half of the matrix elements of hermitian scalar
+/// positive parity operators, the others follow by conjugation (flag=1)
+void useHermiticity(int flag);
+
+/// can matrix elements of Op be obtained by hermiticity ?
+int usingHermiticity(const ManyBodyOperator* Op);
+
+/// matrix elements <Qp|Op|Q> from <Q|Op|Qp> for hermitian scalar operators
+void adjointprojectedMBME(const Projection* P, const ManyBodyOperator* Op,
+			  const void* mbme, void* adjmbme);
+
+
 int writeprojectedMBME(gzFile fp,
 		       const Projection* P, const ManyBodyOperator* Op,
 		       Symmetry S, Symmetry Sp,
@@ -33,22 +33,43 @@ static void ob_radii2(const SlaterDet* Q,
 }
 
 
-static void tb_radii2(const SlaterDet* Q,
-	   const Gaussian* G1, const Gaussian* G2, 
-	   const Gaussian* G3, const Gaussian* G4, 
-	   const GaussianAux* X13, const GaussianAux* X24, 
-	   complex double r2[3])
-{	
-  complex double mr2;
+// two-body part is separable with the one-body operators x/A, 
+// proton x/Z and neutron x/N 
+static void sep_radii2(const void* par,
+		       const Gaussian*G1, const Gaussian* G2, 
+		       const GaussianAux* X, complex double x[9])
+{
+  const SlaterDet* Q = par;
   int A=Q->A, Z=Q->Z, N=Q->N;
+  int i;
+
+  for (i=0; i<3; i++) {
+    x[i] += 1.0/A* X->rho[i]* X->Q;
+    if (G1->xi == +1)
+      x[3+i] += 1.0/Z* X->rho[i]* X->Q;
+    else
+      x[6+i] += 1.0/N* X->rho[i]* X->Q;
+  }
+}
+
+static const SeparableTerm sep_r2[15] = {
+  {0, 0, 0, -2.0}, {0, 1, 1, -2.0}, {0, 2, 2, -2.0},
+  {1, 0, 0, 2.0}, {1, 1, 1, 2.0}, {1, 2, 2, 2.0},
+  {1, 3, 0, -4.0}, {1, 4, 1, -4.0}, {1, 5, 2, -4.0},
+  {2, 0, 0, 2.0}, {2, 1, 1, 2.0}, {2, 2, 2, 2.0},
+  {2, 6, 0, -4.0}, {2, 7, 1, -4.0}, {2, 8, 2, -4.0}
+};
 
-  mr2 = cvec3mult(X13->rho, X24->rho)*X13->Q*X24->Q;
 
-  r2[0] += -2.0/(A*A)* mr2;
-  r2[1] +=  2.0*(1.0/(A*A) - 
-		 ((1+G1->xi)/2+(1+G2->xi)/2) *1.0/(A*Z))* mr2;
-  r2[2] +=  2.0*(1.0/(A*A) - 
-		 ((1-G1->xi)/2+(1-G2->xi)/2) *1.0/(A*N))* mr2;
+void initRadii2operators(const SlaterDet* Q, 
+			 OneBodyOperator* ob, SeparableOperator* tb)
+{
+  OneBodyOperator op_ob_radii2 = {dim: 3, opt: 1, par: Q, me: ob_radii2};
+  SeparableOperator op_tb_radii2 = {dim: 3, nob: 9, opt: OPTTPROP, par: Q, 
+				    me: sep_radii2, nterms: 15, terms: sep_r2};
+
+  *ob = op_ob_radii2;
+  *tb = op_tb_radii2;
 }
 
 
@@ -57,11 +78,12 @@ void calcRadii2(const SlaterDet* Q, const SlaterDetAux* X,
 {
   double r2one[3], r2two[3];
   OneBodyOperator op_ob_radii2 = {dim: 3, opt: 1, par: Q, me: ob_radii2};
-  TwoBodyOperator op_tb_radii2 = {dim: 3, opt: 1, par: Q, me: tb_radii2};
+  SeparableOperator op_tb_radii2 = {dim: 3, nob: 9, opt: OPTTPROP, par: Q, 
+				    me: sep_radii2, nterms: 15, terms: sep_r2};
 
 
   calcSlaterDetOBME(Q, X, &op_ob_radii2, r2one);
-  calcSlaterDetTBME(Q, X, &op_tb_radii2, r2two);
+  calcSlaterDetSepME(Q, X, &op_tb_radii2, r2two);
 
   *r2mass = r2one[0] + r2two[0];
   *r2proton = r2one[1] + r2two[1];
@@ -76,11 +98,12 @@ void calcRadii2od(const SlaterDet* Q, const SlaterDet* Qp,
 {
   complex double r2one[3], r2two[3];
   OneBodyOperator op_ob_radii2 = {dim: 3, opt: 1, par: Q, me: ob_radii2};
-  TwoBodyOperator op_tb_radii2 = {dim: 3, opt: 1, par: Q, me: tb_radii2};
+  SeparableOperator op_tb_radii2 = {dim: 3, nob: 9, opt: OPTTPROP, par: Q, 
+				    me: sep_radii2, nterms: 15, terms: sep_r2};
 
 
   calcSlaterDetOBMEod(Q, Qp, X, &op_ob_radii2, r2one);
-  calcSlaterDetTBMEod(Q, Qp, X, &op_tb_radii2, r2two);
+  calcSlaterDetSepMEod(Q, Qp, X, &op_tb_radii2, r2two);
 
   *r2mass = r2one[0] + r2two[0];
   *r2proton = r2one[1] + r2two[1];
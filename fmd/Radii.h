@@ -16,6 +16,10 @@
 #include "SlaterDet.h"
 
 
+/// one- and two-body operators used by calcRadii2
+void initRadii2operators(const SlaterDet* Q, 
+			 OneBodyOperator* ob, SeparableOperator* tb);
+
 void calcRadii2(const SlaterDet* Q, const SlaterDetAux* X, 
 		double* r2mass, double* r2proton, double* r2neutron);
 
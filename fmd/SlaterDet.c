@@ -25,6 +25,7 @@
 #include "numerics/lapack.h"
 
 #include "misc/utils.h"
+#include "misc/profile.h"
 
 #define SQR(x) (x)*(x)
 
@@ -195,6 +196,36 @@ void copySlaterDet(const SlaterDet* Q, SlaterDet* Qp)
 }
 
 
+int sameSlaterDet(const SlaterDet* Q, const SlaterDet* Qp)
+{
+  const Gaussian *G, *Gp;
+  int i,c;
+
+  if (Q == Qp)
+    return 1;
+
+  if (Q->A != Qp->A || Q->Z != Qp->Z || Q->N != Qp->N ||
+      Q->ngauss != Qp->ngauss)
+    return 0;
+
+  for (i=0; i<Q->A; i++)
+    if (Q->idx[i] != Qp->idx[i] || Q->ng[i] != Qp->ng[i])
+      return 0;
+
+  for (i=0; i<Q->ngauss; i++) {
+    G = &Q->G[i]; Gp = &Qp->G[i];
+    if (G->xi != Gp->xi || G->a != Gp->a ||
+	G->chi[0] != Gp->chi[0] || G->chi[1] != Gp->chi[1])
+      return 0;
+    for (c=0; c<3; c++)
+      if (G->b[c] != Gp->b[c])
+	return 0;
+  }
+
+  return 1;
+}
+
+
 void cloneSlaterDet(const SlaterDet* Q, SlaterDet* Qp)
 {
   Qp->A = Q->A;
@@ -428,65 +459,84 @@ void freeSlaterDetAux(SlaterDetAux* X)
 }
 
 
-// hermiticity of matrices is not exploited
+// Gaussian auxiliaries Gaux(a,c) for all Gaussians a of Q and c of Qp,
+// calculated column by column with the vectorized row kernel
+static void calcSlaterDetGaussianAux(const SlaterDet* Q, const SlaterDet* Qp,
+				     GaussianAux* Gaux)
+{
+  int ngauss=Q->ngauss;
+  GaussianSoA G;
+  int c;
+
+  allocateGaussianSoA(&G, ngauss);
+  GaussiantoSoA(Q->G, ngauss, &G);
+
+  for (c=0; c<Qp->ngauss; c++)
+    calcGaussianAuxrow(&G, &Qp->G[c], &Gaux[c*ngauss]);
+
+  freeGaussianSoA(&G);
+}
+
+
+// hermiticity of Gaux and n is exploited, only a <= c is calculated
 void calcSlaterDetAux(const SlaterDet* Q, SlaterDetAux* X)
 {
+  PROFILEBEGIN("calcSlaterDetAux")
   int A=Q->A; int ngauss=Q->ngauss; 
   int* idx=Q->idx; int* ng=Q->ng;
-  Gaussian* G=Q->G;
   GaussianAux* Gaux=X->Gaux;
 
-  int k,l,ki,li;
+  int k,l,ki,li,a,c;
+  GaussianSoA G, Gc;
 
-  for (l=0; l<A; l++)
-    for (li=0; li<ng[l]; li++)
-      for (k=0; k<A; k++)
-	for (ki=0; ki<ng[k]; ki++)
-	  calcGaussianAux(&G[idx[k]+ki], &G[idx[l]+li], 
-			  &Gaux[(idx[k]+ki)+(idx[l]+li)*ngauss]);
+  allocateGaussianSoA(&G, ngauss);
+  GaussiantoSoA(Q->G, ngauss, &G);
+
+  Gc = G;
+  for (c=0; c<ngauss; c++) {
+    Gc.n = c+1;
+    calcGaussianAuxrow(&Gc, &Q->G[c], &Gaux[c*ngauss]);
+    for (a=0; a<c; a++)
+      hermGaussianAux(&Gaux[a+c*ngauss], &Gaux[c+a*ngauss]);
+  }
+
+  freeGaussianSoA(&G);
 
 
   for (l=0; l<A; l++) 
-    for (k=0; k<A; k++) {
+    for (k=0; k<=l; k++) {
       X->n[k+l*A] = 0.0;
       for (li=0; li<ng[l]; li++)
 	for (ki=0; ki<ng[k]; ki++)
 	  X->n[k+l*A] += Gaux[(idx[k]+ki)+(idx[l]+li)*ngauss].Q;
+      X->n[l+k*A] = conj(X->n[k+l*A]);
     }
 
   char UPLO='U';
   int info;
 
   copycmat(A, X->n, X->o);
+  PROFILEBEGIN("zpotrf/zpotri")
   FORTRAN(zpotrf)(&UPLO, &A, X->o, &A, &info);
   FORTRAN(zpotri)(&UPLO, &A, X->o, &A, &info);
+  PROFILEEND
   mirrorcmat(A, X->o);
+  PROFILEEND
 }
 
 
-///
-void calcSlaterDetAuxod(const SlaterDet* Q, const SlaterDet* Qp,
-			SlaterDetAux* X)
+// overlap matrix, its inverse and determinant from Gaux
+static void calcSlaterDetovlapod(const SlaterDet* Q, const SlaterDet* Qp,
+				 SlaterDetAux* X)
 {
-  assert(Q->A == Qp->A && Q->Z == Qp->Z && Q->N == Qp->N);
-
   int A=Q->A; int ngauss=Q->ngauss;
   int* idx=Q->idx; int* idxp=Qp->idx; 
   int* ng=Q->ng; int* ngp=Qp->ng;
-  Gaussian* G=Q->G; Gaussian* Gp=Qp->G;
   GaussianAux* Gaux=X->Gaux;
   complex double* n=X->n;
 
   int k,l,ki,li;
 
-  for (l=0; l<A; l++)
-    for (li=0; li<ngp[l]; li++)
-      for (k=0; k<A; k++)
-	for (ki=0; ki<ng[k]; ki++)
-	  calcGaussianAux(&G[idx[k]+ki], &Gp[idxp[l]+li], 
-			  &Gaux[(idx[k]+ki)+(idxp[l]+li)*ngauss]);
-
-
   for (l=0; l<A; l++) 
     for (k=0; k<A; k++) {
       n[k+l*A] = 0.0;
@@ -502,15 +552,93 @@ void calcSlaterDetAuxod(const SlaterDet* Q, const SlaterDet* Qp,
   int info;
   
   copycmat(A, X->n, X->o);
+  PROFILEBEGIN("zgetrf/zgetri")
   FORTRAN(zgetrf)(&A, &A, X->o, &A, ipiv, &info);
   FORTRAN(zdet)(X->o, &A, &A, ipiv, &X->ovlap);
   FORTRAN(zgetri)(&A, X->o, &A, ipiv, work, &lwork, &info);
+  PROFILEEND
 
   if (info)
     fprintf(stderr, "calcSlaterDetAuxod: overlap matrix singular !\n");
 }
 
 
+///
+void calcSlaterDetAuxod(const SlaterDet* Q, const SlaterDet* Qp,
+			SlaterDetAux* X)
+{
+  PROFILEBEGIN("calcSlaterDetAuxod")
+  assert(Q->A == Qp->A && Q->Z == Qp->Z && Q->N == Qp->N);
+
+  calcSlaterDetGaussianAux(Q, Qp, X->Gaux);
+  calcSlaterDetovlapod(Q, Qp, X);
+  PROFILEEND
+}
+
+
+void initSlaterDetAuxinv(const SlaterDet* Q, const SlaterDet* Qp,
+			 SlaterDetAuxinv* Y)
+{
+  int ngauss=Q->ngauss;
+  int c;
+
+  Y->ngauss = ngauss;
+  allocateGaussianSoA(&Y->G, ngauss);
+  GaussiantoSoA(Q->G, ngauss, &Y->G);
+  Y->Y = malloc(ngauss*Qp->ngauss*sizeof(GaussianAuxinv));
+
+  for (c=0; c<Qp->ngauss; c++)
+    calcGaussianAuxinvrow(&Y->G, &Qp->G[c], &Y->Y[c*ngauss]);
+}
+
+
+void freeSlaterDetAuxinv(SlaterDetAuxinv* Y)
+{
+  freeGaussianSoA(&Y->G);
+  free(Y->Y);
+}
+
+
+// Q is the SlaterDet Y was calculated for
+void calcSlaterDetAuxodinv(const SlaterDet* Q, const SlaterDet* Qp,
+			   const SlaterDetAuxinv* Y, SlaterDetAux* X)
+{
+  PROFILEBEGIN("calcSlaterDetAuxodinv")
+  assert(Q->A == Qp->A && Q->Z == Qp->Z && Q->N == Qp->N);
+
+  int ngauss=Y->ngauss;
+  int c;
+
+  for (c=0; c<Qp->ngauss; c++)
+    calcGaussianAuxrowinv(&Y->G, &Qp->G[c], &Y->Y[c*ngauss], 
+			  &X->Gaux[c*ngauss]);
+
+  calcSlaterDetovlapod(Q, Qp, X);
+  PROFILEEND
+}
+
+
+void calcSlaterDetAuxodinvparity(const SlaterDet* Q, const SlaterDet* Qp,
+				 const SlaterDetAuxinv* Y, 
+				 SlaterDetAux* X, SlaterDetAux* Xp)
+{
+  PROFILEBEGIN("calcSlaterDetAuxodinvparity")
+  assert(Q->A == Qp->A && Q->Z == Qp->Z && Q->N == Qp->N);
+
+  int ngauss=Y->ngauss;
+  int c;
+
+  for (c=0; c<Qp->ngauss; c++)
+    calcGaussianAuxrowinvparity(&Y->G, &Qp->G[c], &Y->Y[c*ngauss], 
+				&X->Gaux[c*ngauss], &Xp->Gaux[c*ngauss]);
+
+  // overlap matrices only depend on Gaux and the nucleon indices
+  calcSlaterDetovlapod(Q, Qp, X);
+  calcSlaterDetovlapod(Q, Qp, Xp);
+  PROFILEEND
+}
+
+
 // sort of a hack
 // calculate cofactors by using the svd 
 // assume rank A-1 for overlap matrix
@@ -520,22 +648,17 @@ void calcSlaterDetAuxod(const SlaterDet* Q, const SlaterDet* Qp,
 void calcSlaterDetAuxodsingular(const SlaterDet* Q, const SlaterDet* Qp,
 				SlaterDetAux* X)
 {
+  PROFILEBEGIN("calcSlaterDetAuxodsingular")
   int A=Q->A; int ngauss=Q->ngauss;
   int* idx=Q->idx; int* idxp=Qp->idx; 
   int* ng=Q->ng; int* ngp=Qp->ng;
-  Gaussian* G=Q->G; Gaussian* Gp=Qp->G;
   GaussianAux* Gaux=X->Gaux;
   complex double* n=X->n;
   complex double* o=X->o;
 
   int k,l,ki,li;
 
-  for (l=0; l<A; l++)
-    for (li=0; li<ngp[l]; li++)
-      for (k=0; k<A; k++)
-	for (ki=0; ki<ng[k]; ki++)
-	  calcGaussianAux(&G[idx[k]+ki], &Gp[idxp[l]+li], 
-			  &Gaux[(idx[k]+ki)+(idxp[l]+li)*ngauss]);
+  calcSlaterDetGaussianAux(Q, Qp, Gaux);
 
 
   for (l=0; l<A; l++) 
@@ -557,8 +680,10 @@ void calcSlaterDetAuxodsingular(const SlaterDet* Q, const SlaterDet* Qp,
     double rwork[lwork];
     int info;
 
+    PROFILEBEGIN("zgesvd")
     FORTRAN(zgesvd)(&jobu, &jobvt, &A, &A, n, &A, S,
 		    U, &A, Vh, &A, work, &lwork, rwork, &info);
+    PROFILEEND
   }
 
   // calculate phase detVhU using LU decomposition
@@ -585,6 +710,7 @@ void calcSlaterDetAuxodsingular(const SlaterDet* Q, const SlaterDet* Qp,
       o[k+l*A] = conj(Vh[A-1+k*A])*prodS*conj(U[l+(A-1)*A])*detVhU;
 
   X->ovlap = 1.0;
+  PROFILEEND
 }
 
 
@@ -638,6 +764,57 @@ void calcSlaterDetOBME(const SlaterDet* Q, const SlaterDetAux* X,
 }
 
 
+// particle i is Gaussian idx[i] or Gaussian i if idx is NULL
+static void isospinpartition(int n, const Gaussian* G, const int* idx,
+			     int* xi, int* part, int npart[3])
+{
+  int i, t;
+
+  npart[0] = npart[1] = npart[2] = 0;
+  for (i=0; i<n; i++) {
+    xi[i] = G[idx ? idx[i] : i].xi;
+    t = (xi[i] > 0) ? 0 : 1;
+    part[t*n+npart[t]++] = i;
+    part[2*n+npart[2]++] = i;
+  }
+}
+
+
+void SlaterDetisospinpartition(const SlaterDet* Q, int* xi, 
+			       int* part, int npart[3])
+{
+  isospinpartition(Q->A, Q->G, Q->idx, xi, part, npart);
+}
+
+
+void SlaterDetGaussianisospinpartition(const SlaterDet* Q, int* xi,
+				       int* part, int npart[3])
+{
+  isospinpartition(Q->ngauss, Q->G, NULL, xi, part, npart);
+}
+
+
+// direct (xib = xia, xid = xic) and exchange (xib = xic, xid = xia) 
+// contributions of charge conserving operators
+int isospinblocks(int opt, int xia, int xic, int tb[2], int td[2])
+{
+  if (!(opt & OPTCHARGE)) {
+    tb[0] = td[0] = 2;
+    return 1;
+  }
+
+  if (xia == xic) {
+    tb[0] = td[0] = 0;
+    tb[1] = td[1] = 1;
+    return 2;
+  }
+
+  tb[0] = (xic > 0) ? 0 : 1;
+  td[0] = (xia > 0) ? 0 : 1;
+  return 1;
+}
+
+
 void calcSlaterDetTBME(const SlaterDet* Q, const SlaterDetAux* X,
 		       const TwoBodyOperator* op, double val[])
 {
@@ -648,18 +825,27 @@ void calcSlaterDetTBME(const SlaterDet* Q, const SlaterDetAux* X,
   complex double* o=X->o;
 
   int k,l,m,n, ki,li,mi,ni;
+  int kk,mm, blk,nblk, tk[2],tm[2];
   int i;
+  int xi[A], part[3*A], npart[3];
   complex double *gval = malloc(op->dim*sizeof(complex double));
 
+  SlaterDetisospinpartition(Q, xi, part, npart);
+
   for (i=0; i<op->dim; i++)
     val[i] = 0.0;
 
   for (n=0; n<A; n++)
     for (l=0; l<A; l++)
-      if (!op->opt || Gaux[idx[l]+idx[n]*ngauss].T) {
-	for (m=0; m<A; m++)
-	  for (k=0; k<l; k++)
-	    if (!op->opt || Gaux[idx[k]+idx[m]*ngauss].T) {
+      if (!(op->opt & OPTTPROP) || Gaux[idx[l]+idx[n]*ngauss].T) {
+	nblk = isospinblocks(op->opt, xi[l], xi[n], tk, tm);
+	for (blk=0; blk<nblk; blk++)
+	for (mm=0; mm<npart[tm[blk]]; mm++)
+	  for (kk=0; kk<npart[tk[blk]]; kk++) {
+	    m = part[tm[blk]*A+mm]; k = part[tk[blk]*A+kk];
+	    if (k >= l)
+	      break;
+	    if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idx[m]*ngauss].T) {
 
 	      for (i=0; i<op->dim; i++) 
 		gval[i] = 0.0;
@@ -679,12 +865,146 @@ void calcSlaterDetTBME(const SlaterDet* Q, const SlaterDetAux* X,
 		val[i] += gval[i]*
 		  (o[m+k*A]*o[n+l*A]-o[n+k*A]*o[m+l*A]);
 	    }	
+	  }
       }
   
   free(gval);
 }
 
 
+// one-body density matrix in the Gaussian basis
+// rho(c,a) = o(m,k) with Gaussian a belonging to nucleon k of Q
+// and Gaussian c to nucleon m of Qp
+static void calcSlaterDetrho(const SlaterDet* Q, const SlaterDet* Qp,
+			     const SlaterDetAux* X, int* nuc, int* nucp,
+			     complex double* rho)
+{
+  int A=Q->A; int ngauss=Q->ngauss;
+  complex double* o=X->o;
+
+  int k,ki,a,c;
+
+  for (k=0; k<A; k++)
+    for (ki=0; ki<Q->ng[k]; ki++)
+      nuc[Q->idx[k]+ki] = k;
+  for (k=0; k<A; k++)
+    for (ki=0; ki<Qp->ng[k]; ki++)
+      nucp[Qp->idx[k]+ki] = k;
+
+  for (a=0; a<ngauss; a++)
+    for (c=0; c<ngauss; c++)
+      rho[c+a*ngauss] = o[nucp[c]+nuc[a]*A];
+}
+
+
+// two-body matrix element contracted with the one-body density matrix
+// pairs p1=(a,c), p2=(b,d) of Gaussians index Gaux directly,
+// exchange of particles (p1 <-> p2) and hermiticity 
+// (p1,p2 <-> p1^T,p2^T) reduce the number of operator calls by 4,
+// operator has to be hermitian
+void calcSlaterDetTBMErho(const SlaterDet* Q, const SlaterDetAux* X,
+			  const TwoBodyOperator* op, double val[])
+{
+  int ngauss=Q->ngauss; int ng2=ngauss*ngauss;
+  Gaussian* G=Q->G;
+  GaussianAux* Gaux=X->Gaux;
+
+  int a,b,c,d, p1,p2, tp1,tp2, tmin,tmax;
+  int i, n;
+  int nuc[ngauss];
+  int bb,dd, blk,nblk, tb[2],td[2];
+  int xi[ngauss], part[3*ngauss], npart[3];
+  complex double cof;
+  double w;
+  complex double *gval = malloc(op->dim*sizeof(complex double));
+  complex double *rho = malloc(ng2*sizeof(complex double));
+
+  // pairs p2 collected for the vectorized operator
+  GaussianAuxSoA X24;
+  double *wre=NULL, *wim=NULL;
+  if (op->melanes) {
+    allocateGaussianAuxSoA(&X24, ng2);
+    wre = malloc(2*ng2*sizeof(double)); wim = wre+ng2;
+  }
+
+  calcSlaterDetrho(Q, Q, X, nuc, nuc, rho);
+
+  SlaterDetGaussianisospinpartition(Q, xi, part, npart);
+
+  for (i=0; i<op->dim; i++)
+    val[i] = 0.0;
+
+  for (p1=0; p1<ng2; p1++) 
+    if (!(op->opt & OPTTPROP) || Gaux[p1].T) {
+      a = p1 % ngauss; c = p1 / ngauss;
+      tp1 = c+a*ngauss;
+      n = 0;
+
+      nblk = isospinblocks(op->opt, xi[a], xi[c], tb, td);
+      for (blk=0; blk<nblk; blk++)
+      for (dd=0; dd<npart[td[blk]]; dd++)
+      for (bb=0; bb<npart[tb[blk]]; bb++) {
+	b = part[tb[blk]*ngauss+bb]; d = part[td[blk]*ngauss+dd];
+	p2 = b+d*ngauss;
+	if (p2 <= p1)
+	  continue;
+
+	// antisymmetrized density vanishes for Gaussians of same nucleon
+	if (nuc[a] == nuc[b] || nuc[c] == nuc[d])
+	  continue;
+	if ((op->opt & OPTTPROP) && !Gaux[p2].T)
+	  continue;
+
+	// hermitian conjugate pair is visited instead ?
+	tp2 = d+b*ngauss;
+	tmin = min(tp1, tp2); tmax = max(tp1, tp2);
+	if (tmin < p1 || (tmin == p1 && tmax < p2))
+	  continue;
+	w = (tmin == p1 && tmax == p2) ? 1.0 : 2.0;
+
+	cof = rho[c+a*ngauss]*rho[d+b*ngauss] - rho[d+a*ngauss]*rho[c+b*ngauss];
+
+	if (op->melanes) {
+	  GaussianAuxtoSoA(&G[b], &G[d], &Gaux[p2], &X24, n);
+	  wre[n] = w*creal(cof); wim[n] = w*cimag(cof);
+	  n++;
+	  continue;
+	}
+
+	for (i=0; i<op->dim; i++) 
+	  gval[i] = 0.0;
+
+	op->me(op->par, 
+	       &G[a], &G[b], &G[c], &G[d], 
+	       &Gaux[p1], &Gaux[p2],
+	       gval);
+
+	for (i=0; i<op->dim; i++)
+	  val[i] += w*creal(gval[i]*cof);
+      }
+
+      if (n) {
+	X24.n = n;
+
+	for (i=0; i<op->dim; i++) 
+	  gval[i] = 0.0;
+
+	op->melanes(op->par, &G[a], &G[c], &Gaux[p1], &X24, wre, wim, gval);
+
+	for (i=0; i<op->dim; i++)
+	  val[i] += creal(gval[i]);
+      }
+    }
+
+  if (op->melanes) {
+    freeGaussianAuxSoA(&X24);
+    free(wre);
+  }
+  free(rho);
+  free(gval);
+}
+
+
 void calcSlaterDetTBMErowcol(const SlaterDet* Q, const SlaterDetAux* X,
 			     const TwoBodyOperator* op, double val[], 
 			     int k, int l)
@@ -704,10 +1024,10 @@ void calcSlaterDetTBMErowcol(const SlaterDet* Q, const SlaterDetAux* X,
 
   for (n=0; n<A; n++)
     // for (l=0; l<A; l++)
-      if (!op->opt || Gaux[idx[l]+idx[n]*ngauss].T) {
+      if (!(op->opt & OPTTPROP) || Gaux[idx[l]+idx[n]*ngauss].T) {
 	for (m=0; m<A; m++)
 	  // for (k=0; k<l; k++)
-	    if (!op->opt || Gaux[idx[k]+idx[m]*ngauss].T) {
+	    if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idx[m]*ngauss].T) {
 
 	      for (i=0; i<op->dim; i++) 
 		gval[i] = 0.0;
@@ -787,18 +1107,26 @@ void calcSlaterDetTBMEod(const SlaterDet* Q, const SlaterDet* Qp,
   complex double ovl=X->ovlap;
 
   int k,l,m,n, ki,li,mi,ni;
+  int kk,mm, blk,nblk, tk[2],tm[2];
+  int xi[A], xip[A], part[3*A], partp[3*A], npart[3], npartp[3];
   int i;
   complex double *gval = malloc(op->dim*sizeof(complex double));
 
   for (i=0; i<op->dim; i++)
     val[i] = 0.0;
 
+  SlaterDetisospinpartition(Q, xi, part, npart);
+  SlaterDetisospinpartition(Qp, xip, partp, npartp);
+
   for (n=0; n<A; n++)
     for (l=0; l<A; l++)
-      if (!op->opt || Gaux[idx[l]+idxp[n]*ngauss].T) {
-	for (m=0; m<A; m++)
-	  for (k=0; k<A; k++)
-	    if (!op->opt || Gaux[idx[k]+idxp[m]*ngauss].T) {
+      if (!(op->opt & OPTTPROP) || Gaux[idx[l]+idxp[n]*ngauss].T) {
+	nblk = isospinblocks(op->opt, xi[l], xip[n], tk, tm);
+	for (blk=0; blk<nblk; blk++)
+	for (mm=0; mm<npartp[tm[blk]]; mm++)
+	  for (kk=0; kk<npart[tk[blk]]; kk++) {
+	    m = partp[tm[blk]*A+mm]; k = part[tk[blk]*A+kk];
+	    if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idxp[m]*ngauss].T) {
 
 	      for (i=0; i<op->dim; i++) 
 		gval[i] = 0.0;
@@ -818,12 +1146,178 @@ void calcSlaterDetTBMEod(const SlaterDet* Q, const SlaterDet* Qp,
 		val[i] += 0.5*gval[i]*
 		  (o[m+k*A]*o[n+l*A]-o[n+k*A]*o[m+l*A])*ovl;
 	    }	
+	  }
       }
 
   free(gval);
 }
 
 
+static void calcSlaterDetSepterms(int A, const SeparableOperator* op,
+				  const complex double* Fo,
+				  complex double val[]);
+
+
+// off-diagonal version, only exchange of particles can be exploited
+// the one-body and separable operators share the traversal of the
+// Gaussian pairs, operators not needed are passed as NULL
+void calcSlaterDetMEodrho(const SlaterDet* Q, const SlaterDet* Qp,
+			  const SlaterDetAux* X,
+			  const OneBodyOperator* obop,
+			  const SeparableOperator* sepop,
+			  const TwoBodyOperator* op,
+			  complex double obval[], complex double sepval[],
+			  complex double val[])
+{
+  int A=Q->A; int ngauss=Q->ngauss; int ng2=ngauss*ngauss;
+  Gaussian* G=Q->G; Gaussian* Gp=Qp->G;
+  GaussianAux* Gaux=X->Gaux;
+  complex double ovl=X->ovlap;
+
+  int a,b,c,d, p1,p2;
+  int i, n;
+  int nuc[ngauss], nucp[ngauss];
+  int bb,dd, blk,nblk, tb[2],td[2];
+  int xi[ngauss], xip[ngauss], part[3*ngauss], partp[3*ngauss];
+  int npart[3], npartp[3];
+  int obdim = obop ? obop->dim : 0;
+  int nob = sepop ? sepop->nob : 0;
+  int tbdim = op ? op->dim : 0;
+  complex double cof;
+  complex double *obgval = malloc((obdim+nob+tbdim)*sizeof(complex double));
+  complex double *sepgval = obgval+obdim;
+  complex double *gval = sepgval+nob;
+  complex double *rho = malloc(ng2*sizeof(complex double));
+  complex double *F=NULL, *Fo=NULL;
+
+  GaussianAuxSoA X24;
+  double *wre=NULL, *wim=NULL;
+  if (op && op->melanes) {
+    allocateGaussianAuxSoA(&X24, ng2);
+    wre = malloc(2*ng2*sizeof(double)); wim = wre+ng2;
+  }
+
+  calcSlaterDetrho(Q, Qp, X, nuc, nucp, rho);
+
+  if (op) {
+    SlaterDetGaussianisospinpartition(Q, xi, part, npart);
+    SlaterDetGaussianisospinpartition(Qp, xip, partp, npartp);
+  }
+
+  for (i=0; i<obdim; i++)
+    obval[i] = 0.0;
+  if (sepop) {
+    F = malloc(2*nob*A*A*sizeof(complex double)); Fo = F+nob*A*A;
+    for (i=0; i<nob*A*A; i++)
+      F[i] = 0.0;
+    for (i=0; i<sepop->dim; i++)
+      sepval[i] = 0.0;
+  }
+  for (i=0; i<tbdim; i++)
+    val[i] = 0.0;
+
+  for (p1=0; p1<ng2; p1++) {
+    a = p1 % ngauss; c = p1 / ngauss;
+
+    if (obop && (!obop->opt || Gaux[p1].T)) {
+      for (i=0; i<obdim; i++)
+	obgval[i] = 0.0;
+
+      obop->me(obop->par, &G[a], &Gp[c], &Gaux[p1], obgval);
+
+      for (i=0; i<obdim; i++)
+	obval[i] += obgval[i]*rho[c+a*ngauss]*ovl;
+    }
+
+    // one-body transition matrices F(k,m) as in calcSlaterDetSepFo
+    if (sepop && (!(sepop->opt & OPTTPROP) || Gaux[p1].T)) {
+      for (i=0; i<nob; i++)
+	sepgval[i] = 0.0;
+
+      sepop->me(sepop->par, &G[a], &Gp[c], &Gaux[p1], sepgval);
+
+      for (i=0; i<nob; i++)
+	F[nuc[a]+nucp[c]*A+i*A*A] += sepgval[i];
+    }
+
+    if (op && (!(op->opt & OPTTPROP) || Gaux[p1].T)) {
+      n = 0;
+
+      nblk = isospinblocks(op->opt, xi[a], xip[c], tb, td);
+      for (blk=0; blk<nblk; blk++)
+      for (dd=0; dd<npartp[td[blk]]; dd++)
+      for (bb=0; bb<npart[tb[blk]]; bb++) {
+	b = part[tb[blk]*ngauss+bb]; d = partp[td[blk]*ngauss+dd];
+	p2 = b+d*ngauss;
+	if (p2 <= p1)
+	  continue;
+
+	if (nuc[a] == nuc[b] || nucp[c] == nucp[d])
+	  continue;
+	if ((op->opt & OPTTPROP) && !Gaux[p2].T)
+	  continue;
+
+	cof = rho[c+a*ngauss]*rho[d+b*ngauss] - rho[d+a*ngauss]*rho[c+b*ngauss];
+
+	if (op->melanes) {
+	  GaussianAuxtoSoA(&G[b], &Gp[d], &Gaux[p2], &X24, n);
+	  wre[n] = creal(cof); wim[n] = cimag(cof);
+	  n++;
+	  continue;
+	}
+
+	for (i=0; i<op->dim; i++) 
+	  gval[i] = 0.0;
+
+	op->me(op->par, 
+	       &G[a], &G[b], &Gp[c], &Gp[d], 
+	       &Gaux[p1], &Gaux[p2],
+	       gval);
+
+	for (i=0; i<op->dim; i++)
+	  val[i] += gval[i]*cof*ovl;
+      }
+
+      if (n) {
+	X24.n = n;
+
+	for (i=0; i<op->dim; i++) 
+	  gval[i] = 0.0;
+
+	op->melanes(op->par, &G[a], &Gp[c], &Gaux[p1], &X24, wre, wim, gval);
+
+	for (i=0; i<op->dim; i++)
+	  val[i] += gval[i]*ovl;
+      }
+    }
+  }
+
+  if (sepop) {
+    for (i=0; i<nob; i++)
+      multcmat(&F[i*A*A], X->o, &Fo[i*A*A], A);
+    calcSlaterDetSepterms(A, sepop, Fo, sepval);
+    for (i=0; i<sepop->dim; i++)
+      sepval[i] *= ovl;
+    free(F);
+  }
+
+  if (op && op->melanes) {
+    freeGaussianAuxSoA(&X24);
+    free(wre);
+  }
+  free(rho);
+  free(obgval);
+}
+
+
+void calcSlaterDetTBMEodrho(const SlaterDet* Q, const SlaterDet* Qp,
+			    const SlaterDetAux* X,
+			    const TwoBodyOperator* op, complex double val[])
+{
+  calcSlaterDetMEodrho(Q, Qp, X, NULL, NULL, op, NULL, NULL, val);
+}
+
+
 void calcSlaterDetTBMEodrowcol(const SlaterDet* Q, const SlaterDet* Qp,
 			       const SlaterDetAux* X,
 			       const TwoBodyOperator* op, complex double val[],
@@ -846,10 +1340,10 @@ void calcSlaterDetTBMEodrowcol(const SlaterDet* Q, const SlaterDet* Qp,
 
   for (n=0; n<A; n++)
     // for (l=0; l<A; l++)
-      if (!op->opt || Gaux[idx[l]+idxp[n]*ngauss].T) {
+      if (!(op->opt & OPTTPROP) || Gaux[idx[l]+idxp[n]*ngauss].T) {
 	for (m=0; m<A; m++)
 	  // for (k=0; k<A; k++)
-	    if (!op->opt || Gaux[idx[k]+idxp[m]*ngauss].T) {
+	    if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idxp[m]*ngauss].T) {
 
 	      for (i=0; i<op->dim; i++) 
 		gval[i] = 0.0;
@@ -876,6 +1370,114 @@ void calcSlaterDetTBMEodrowcol(const SlaterDet* Q, const SlaterDet* Qp,
 
 
 
+// one-body transition matrices F(k,m) of the nob one-body operators
+// between nucleon k of Q and m of Qp, contracted with the inverse overlap
+// matrix Fo(k,l) = sum_m F(k,m) o(m,l)
+static void calcSlaterDetSepFo(const SlaterDet* Q, const SlaterDet* Qp,
+			       const SlaterDetAux* X,
+			       const SeparableOperator* op, 
+			       complex double* F, complex double* Fo)
+{
+  int A=Q->A; int ngauss=Q->ngauss; int nob=op->nob;
+  int* idx=Q->idx; int* idxp=Qp->idx; 
+  int* ng=Q->ng; int* ngp=Qp->ng;
+  Gaussian* G=Q->G; Gaussian* Gp=Qp->G;
+  GaussianAux* Gaux=X->Gaux;
+
+  int k,m,ki,mi,c;
+  complex double gval[nob];
+
+  for (m=0; m<A; m++)
+    for (k=0; k<A; k++) {
+      for (c=0; c<nob; c++)
+	gval[c] = 0.0;
+
+      if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idxp[m]*ngauss].T)
+	for (mi=0; mi<ngp[m]; mi++)
+	  for (ki=0; ki<ng[k]; ki++)
+	    op->me(op->par,
+		   &G[idx[k]+ki], &Gp[idxp[m]+mi],
+		   &Gaux[(idx[k]+ki)+(idxp[m]+mi)*ngauss],
+		   gval);
+
+      for (c=0; c<nob; c++)
+	F[k+m*A+c*A*A] = gval[c];
+    }
+
+  for (c=0; c<nob; c++)
+    multcmat(&F[c*A*A], X->o, &Fo[c*A*A], A);
+}
+
+
+// sum_{klmn} a(k,m) b(l,n) (o(m,k)o(n,l)-o(n,k)o(m,l)) 
+// = tr(Fa) tr(Fb) - tr(Fa Fb)
+static void calcSlaterDetSepterms(int A, const SeparableOperator* op,
+				  const complex double* Fo,
+				  complex double val[])
+{
+  const complex double *Fa, *Fb;
+  complex double tra, trb, trab;
+  int t,k,l;
+
+  for (t=0; t<op->nterms; t++) {
+    Fa = &Fo[op->terms[t].a*A*A]; Fb = &Fo[op->terms[t].b*A*A];
+    tra = trb = trab = 0.0;
+    for (k=0; k<A; k++) {
+      tra += Fa[k+k*A]; trb += Fb[k+k*A];
+    }
+    for (l=0; l<A; l++)
+      for (k=0; k<A; k++)
+	trab += Fa[k+l*A]*Fb[l+k*A];
+
+    val[op->terms[t].i] += 0.5*op->terms[t].w*(tra*trb - trab);
+  }
+}
+
+
+void calcSlaterDetSepME(const SlaterDet* Q, const SlaterDetAux* X,
+			const SeparableOperator* op, double val[])
+{
+  int A=Q->A; int nob=op->nob;
+  complex double* F = malloc(2*nob*A*A*sizeof(complex double));
+  complex double* Fo = F+nob*A*A;
+  complex double cval[op->dim];
+  int i;
+
+  for (i=0; i<op->dim; i++)
+    cval[i] = 0.0;
+
+  calcSlaterDetSepFo(Q, Q, X, op, F, Fo);
+  calcSlaterDetSepterms(A, op, Fo, cval);
+
+  for (i=0; i<op->dim; i++)
+    val[i] = creal(cval[i]);
+
+  free(F);
+}
+
+
+void calcSlaterDetSepMEod(const SlaterDet* Q, const SlaterDet* Qp,
+			  const SlaterDetAux* X,
+			  const SeparableOperator* op, complex double val[])
+{
+  int A=Q->A; int nob=op->nob;
+  complex double* F = malloc(2*nob*A*A*sizeof(complex double));
+  complex double* Fo = F+nob*A*A;
+  int i;
+
+  for (i=0; i<op->dim; i++)
+    val[i] = 0.0;
+
+  calcSlaterDetSepFo(Q, Qp, X, op, F, Fo);
+  calcSlaterDetSepterms(A, op, Fo, val);
+
+  for (i=0; i<op->dim; i++)
+    val[i] *= X->ovlap;
+
+  free(F);
+}
+
+
 void calcSlaterDetOBHFMEs(const SlaterDet* Q, const SlaterDetAux* X,
 			  const OneBodyOperator* op, void* val)
 {
@@ -925,6 +1527,8 @@ void calcSlaterDetTBHFMEs(const SlaterDet* Q, const SlaterDetAux* X,
   complex double (*mes)[op->dim] = val;
 
   int k,l,m,n, ki,li,mi,ni;
+  int kk,mm, blk,nblk, tk[2],tm[2];
+  int xi[A], part[3*A], npart[3];
   int i;
   complex double gval[op->dim];
 
@@ -933,12 +1537,17 @@ void calcSlaterDetTBHFMEs(const SlaterDet* Q, const SlaterDetAux* X,
       for (i=0; i<op->dim; i++)
 	mes[k+m*A][i] = 0.0;
 
+  SlaterDetisospinpartition(Q, xi, part, npart);
+
   for (n=0; n<A; n++)
     for (l=0; l<A; l++)
-      if (!op->opt || Gaux[idx[l]+idx[n]*ngauss].T) {
-	for (m=0; m<A; m++)
-	  for (k=0; k<A; k++)
-	    if (!op->opt || Gaux[idx[k]+idx[m]*ngauss].T) {
+      if (!(op->opt & OPTTPROP) || Gaux[idx[l]+idx[n]*ngauss].T) {
+	nblk = isospinblocks(op->opt, xi[l], xi[n], tk, tm);
+	for (blk=0; blk<nblk; blk++)
+	for (mm=0; mm<npart[tm[blk]]; mm++)
+	  for (kk=0; kk<npart[tk[blk]]; kk++) {
+	    m = part[tm[blk]*A+mm]; k = part[tk[blk]*A+kk];
+	    if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idx[m]*ngauss].T) {
 
 	      for (i=0; i<op->dim; i++) 
 		gval[i] = 0.0;
@@ -959,5 +1568,6 @@ void calcSlaterDetTBHFMEs(const SlaterDet* Q, const SlaterDetAux* X,
 		mes[k+n*A][i] -= gval[i]*o[m+l*A];
 	      }
 	    }	
+	  }
       }	
 }
@@ -48,6 +48,43 @@ typedef struct {
 } SlaterDetAux;
 
 
+/// Gaussian pair auxiliaries of Q and Qp invariant under translations,
+/// rotations and parity of Qp, reused in projection integrals
+typedef struct {
+  int ngauss;
+  GaussianSoA G;		///< Gaussians of Q
+  GaussianAuxinv* Y;		///< invariant auxiliaries Y(ngauss, ngauss)
+} SlaterDetAuxinv;
+
+
+/// term w a(1) b(2) of a separable two-body operator,
+/// a and b index the one-body operators, added to val[i]
+typedef struct {
+  int i;
+  int a, b;
+  double w;
+} SeparableTerm;
+
+
+/// Separable two-body operator.
+/// two-body operator build from products of one-body operators, 
+/// equivalent to the TwoBodyOperator with matrix elements
+/// sum_t w_t a_t(13) b_t(24). me adds the matrix elements of all nob 
+/// one-body operators to val[nob]. If all one-body matrix elements are
+/// proportional to the isospin overlap T opt should be set to OPTTPROP
+typedef struct {
+  int dim;
+  int nob;
+  int opt;
+  const void* par;
+  void (*me)(const void* parameters,
+	     const Gaussian* G1, const Gaussian* G2, const GaussianAux* X12, 
+	     complex double val[]);
+  int nterms;
+  const SeparableTerm* terms;
+} SeparableOperator;
+
+
 /// allocate memory for SlaterDet
 void allocateSlaterDet(SlaterDet* Q, int A);
 
@@ -77,6 +114,9 @@ void copySlaterDet(const SlaterDet* Q, SlaterDet* Qp);
 /// Qp will be initialized
 void cloneSlaterDet(const SlaterDet* Q, SlaterDet* Qp);
 
+/// are Q and Qp the same Slater determinant (same parameters) ?
+int sameSlaterDet(const SlaterDet* Q, const SlaterDet* Qp);
+
 /// join Slater determinants Qa and Qb into Q
 /// Q will be initialized
 void joinSlaterDets(const SlaterDet* Qa, const SlaterDet* Qb, SlaterDet* Q);
@@ -124,7 +164,7 @@ void initSlaterDetAux(const SlaterDet* Q, SlaterDetAux* X);
 void freeSlaterDetAux(SlaterDetAux* X);
 
 /// calculate SlaterDetAux for SlaterDet Q.
-/// hermiticity not exploited yet
+/// only the upper triangle is calculated, the rest follows by hermiticity
 void calcSlaterDetAux(const SlaterDet* Q, SlaterDetAux* X);
 
 
@@ -134,6 +174,24 @@ void calcSlaterDetAux(const SlaterDet* Q, SlaterDetAux* X);
 void calcSlaterDetAuxod(const SlaterDet* Q, const SlaterDet* Qp,
 			SlaterDetAux* X);
 
+/// calculate invariant auxiliaries Y for SlaterDet's Q and Qp
+void initSlaterDetAuxinv(const SlaterDet* Q, const SlaterDet* Qp,
+			 SlaterDetAuxinv* Y);
+
+/// free memory used by SlaterDetAuxinv Y
+void freeSlaterDetAuxinv(SlaterDetAuxinv* Y);
+
+/// same as calcSlaterDetAuxod, Qp has to be a translated, rotated 
+/// or inverted copy of the SlaterDet Y was calculated for
+void calcSlaterDetAuxodinv(const SlaterDet* Q, const SlaterDet* Qp,
+			   const SlaterDetAuxinv* Y, SlaterDetAux* X);
+
+/// same as calcSlaterDetAuxodinv, calculates in addition Xp for Qp 
+/// inverted in one pass
+void calcSlaterDetAuxodinvparity(const SlaterDet* Q, const SlaterDet* Qp,
+				 const SlaterDetAuxinv* Y, 
+				 SlaterDetAux* X, SlaterDetAux* Xp);
+
 /// calculate SlaterDetAux for SlaterDet's Q and Qp.
 /// inversion by SVD decomposition
 /// rank A-1 of overlap matrix assumed, ovlap set to 1.0
@@ -148,6 +206,22 @@ void calcSlaterDetOBME(const SlaterDet* Q, const SlaterDetAux* X,
 		       const OneBodyOperator* op, double val[]);
 
 
+/// isospins xi of the nucleons of Q partitioned in protons 
+/// part[0..npart[0]-1], neutrons part[A..A+npart[1]-1] and all nucleons
+/// part[2A..2A+npart[2]-1]
+void SlaterDetisospinpartition(const SlaterDet* Q, int* xi, 
+			       int* part, int npart[3]);
+
+/// same as SlaterDetisospinpartition for the ngauss Gaussians of Q
+void SlaterDetGaussianisospinpartition(const SlaterDet* Q, int* xi,
+				       int* part, int npart[3]);
+
+/// isospin blocks (tb[i], td[i]) of the partition for the pair (b,d) 
+/// contributing to <ab|op|cd> given the isospins xia, xic of pair (a,c),
+/// returns number of blocks
+int isospinblocks(int opt, int xia, int xic, int tb[2], int td[2]);
+
+
 /// calculate matrix element with SaterDet Q for 
 /// two-body operator op defined for Gaussians
 /// val will be overwritten 
@@ -158,6 +232,13 @@ void calcSlaterDetTBMErowcol(const SlaterDet* Q, const SlaterDetAux* X,
 			     const TwoBodyOperator* op, double val[], 
 			     int k, int l);
 
+/// calculate matrix element with SlaterDet Q for
+/// two-body operator op using the one-body density matrix
+/// in the Gaussian basis, op has to be hermitian
+/// val will be overwritten
+void calcSlaterDetTBMErho(const SlaterDet* Q, const SlaterDetAux* X,
+			  const TwoBodyOperator* op, double val[]);
+
 
 /// calculate off-diagonal matrix element with SaterDets Q  and Qp for 
 /// one-body operator op defined for Gaussians
@@ -181,6 +262,37 @@ void calcSlaterDetTBMEodrowcol(const SlaterDet* Q, const SlaterDet* Qp,
 			       complex double val[], 
 			       int k, int l);
 
+/// calculate off-diagonal matrix element with SlaterDets Q and Qp for
+/// two-body operator op using the one-body density matrix
+/// in the Gaussian basis
+/// val will be overwritten
+void calcSlaterDetTBMEodrho(const SlaterDet* Q, const SlaterDet* Qp,
+			    const SlaterDetAux* X,
+			    const TwoBodyOperator* op, complex double val[]);
+
+/// one-body operator obop, separable operator sepop and two-body
+/// operator op evaluated in one traversal of the Gaussian pairs,
+/// operators passed as NULL are skipped
+void calcSlaterDetMEodrho(const SlaterDet* Q, const SlaterDet* Qp,
+			  const SlaterDetAux* X,
+			  const OneBodyOperator* obop,
+			  const SeparableOperator* sepop,
+			  const TwoBodyOperator* op,
+			  complex double obval[], complex double sepval[],
+			  complex double val[]);
+
+
+/// calculate matrix element with SlaterDet Q for separable
+/// two-body operator op from the one-body transition matrices,
+/// O(A^2 ng^2) instead of O(A^4 ng^4)
+/// val will be overwritten
+void calcSlaterDetSepME(const SlaterDet* Q, const SlaterDetAux* X,
+			const SeparableOperator* op, double val[]);
+
+void calcSlaterDetSepMEod(const SlaterDet* Q, const SlaterDet* Qp,
+			  const SlaterDetAux* X,
+			  const SeparableOperator* op, complex double val[]);
+
 
 /// calculate Hartree-Fock matrix elements for one-body operator
 void calcSlaterDetOBHFMEs(const SlaterDet* Q, const SlaterDetAux* X,
@@ -37,6 +37,11 @@ ManyBodyOperator OpTimeReversal = {
 static SlaterDet Qpp;
 static SlaterDetAux Xpp;
 
+// calcTimeReversalod runs in parallel projection loops
+#ifdef _OPENMP
+#pragma omp threadprivate(Qpp, Xpp)
+#endif
+
 
 void calcTimeReversal(const SlaterDet* Q, const SlaterDetAux* X,
 		      complex double* t)
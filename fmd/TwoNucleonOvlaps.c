@@ -141,6 +141,11 @@ void initOpTwoNucleonOvlapsY(TwoNucleonOvlapsPara* par)
 static SlaterDet *QAp;
 static complex double *n, *nlu;
 
+// one copy per thread, spectroscopic amplitudes are projected in parallel
+#ifdef _OPENMP
+#pragma omp threadprivate(QAp, n, nlu)
+#endif
+
 // overlap between Gaussians
 static complex double calcGaussianOvlap(const Gaussian* G1, const Gaussian* G2)
 {
@@ -9,6 +9,7 @@
 */
 
 #include <math.h>
+#include <complex.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,10 +21,13 @@
 
 #include "numerics/zcw.h"
 #include "numerics/gaussquad.h"
+#include "numerics/wignerd.h"
 
 
 #define SQR(x) ((x)*(x))
 
+static void initanginverse(angintegrationpara* par);
+
 
 int initAngintegration(angintegrationpara* par, const char* projpar)
 {
@@ -43,6 +47,9 @@ int initAngintegration(angintegrationpara* par, const char* projpar)
       c=strtok(NULL, "-");
       par->zcw.idx = atoi(c);
       par->n = nangles3(par->zcw.idx);
+    } else if (!strncmp(c, "adapt", 5)) {
+      fprintf(stderr, "adaptive angular integration (ang-adapt) only available for single operators without MPI\n");
+      exit(-1);
     } else {
       par->type = AngProd;
       int nbeta = atoi(c);
@@ -68,6 +75,7 @@ int initAngintegration(angintegrationpara* par, const char* projpar)
       par->prod.wgamma = par->prod.walpha;
 
     }
+    initanginverse(par);
   }
 
   return 0;
@@ -82,6 +90,8 @@ void freeAngintegration(angintegrationpara* par)
     free(par->prod.alpha);
     free(par->prod.walpha);
   }
+  free(par->inv);
+  par->inv = NULL;
 }
 
 
@@ -193,6 +203,15 @@ void _initangintegration(const Projection* P,
 
     par->n = par->prod.nbeta* par->prod.nalpha* par->prod.ngamma;
   }
+
+  // adaptive integration needs the matrix elements while refining,
+  // only implemented in calcprojectedMBME
+  else if (P->ang == AngAdapt) {
+    fprintf(stderr, "adaptive angular integration (ang-adapt) only available for single operators without MPI\n");
+    exit(-1);
+  }
+
+  initanginverse(par);
 }
 
 
@@ -280,3 +299,195 @@ void getangintegrationpoint(int i, const angintegrationpara* par,
   // fprintf(stderr, "ang integration point: (%8.5f, %8.5f, %8.5f) weight %8.5f\n", 
   //	     *alpha, *beta, *gamma, *w);
 }
+
+
+// rotation matrix R = Rz(alpha) Ry(beta) Rz(gamma)
+static void eulerrotation(double alpha, double beta, double gamma,
+			  double R[3][3])
+{
+  double ca=cos(alpha), sa=sin(alpha);
+  double cb=cos(beta), sb=sin(beta);
+  double cg=cos(gamma), sg=sin(gamma);
+
+  R[0][0] = ca*cb*cg-sa*sg; R[0][1] = -ca*cb*sg-sa*cg; R[0][2] = ca*sb;
+  R[1][0] = sa*cb*cg+ca*sg; R[1][1] = -sa*cb*sg+ca*cg; R[1][2] = sa*sb;
+  R[2][0] = -sb*cg;         R[2][1] = sb*sg;           R[2][2] = cb;
+}
+
+
+typedef struct {
+  double cosb;
+  int i;
+} angpoint;
+
+static int cmpangpoint(const void* a, const void* b)
+{
+  double ca = ((const angpoint*) a)->cosb;
+  double cb = ((const angpoint*) b)->cosb;
+  return (ca < cb ? -1 : (ca > cb ? 1 : 0));
+}
+
+
+// pair integration points with their inverse rotations
+// R(alpha,beta,gamma)^-1 = R(pi-gamma,beta,pi-alpha), partners have
+// the same beta and the same weight
+// product grids are closed under inversion for odd numbers of azimuthal
+// points, ZCW sets have distinct betas and only the identity is paired
+
+#define INVEPS 1e-10
+
+static void initanginverse(angintegrationpara* par)
+{
+  int n = par->n;
+  double (*R)[3][3] = malloc(n*sizeof(double[3][3]));
+  double* w = malloc(n*sizeof(double));
+  angpoint* pt = malloc(n*sizeof(angpoint));
+  int* inv = malloc(n*sizeof(int));
+  double alpha, beta, gamma;
+  int i, j, ki, kj, a, b, match, closed;
+
+  for (i=0; i<n; i++) {
+    getangintegrationpoint(i, par, &alpha, &beta, &gamma, &w[i]);
+    eulerrotation(alpha, beta, gamma, R[i]);
+    pt[i].cosb = R[i][2][2]; pt[i].i = i;
+    inv[i] = -1;
+  }
+
+  qsort(pt, n, sizeof(angpoint), cmpangpoint);
+
+  for (ki=0; ki<n; ki++) {
+    i = pt[ki].i;
+    if (inv[i] >= 0)
+      continue;
+    for (kj=ki; kj<n && pt[kj].cosb-pt[ki].cosb < INVEPS; kj++) {
+      j = pt[kj].i;
+      if (inv[j] >= 0 || fabs(w[i]-w[j]) > INVEPS*fabs(w[i]))
+	continue;
+      match = 1;
+      for (a=0; a<3; a++)
+	for (b=0; b<3; b++)
+	  if (fabs(R[j][a][b]-R[i][b][a]) > INVEPS)
+	    match = 0;
+      if (match) {
+	inv[i] = j; inv[j] = i;
+	break;
+      }
+    }
+  }
+
+  closed = (n > 1);
+  for (i=0; i<n; i++)
+    if (inv[i] < 0)
+      closed = 0;
+
+  if (closed)
+    par->inv = inv;
+  else {
+    par->inv = NULL;
+    free(inv);
+  }
+
+  free(R);
+  free(w);
+  free(pt);
+}
+
+
+// D-functions are tabulated for the most recently used integration grids,
+// grids are identified by their Euler angles as adaptive grids
+// are modified in place
+
+#define NDTABLES 8
+
+static angDtable Dtable[NDTABLES];
+static int nDtable = 0;
+static int nextDtable = 0;
+
+
+static int matchangDtable(const angDtable* D, 
+			  const angintegrationpara* par, int jmax)
+{
+  if (D->n != par->n || D->jmax < jmax)
+    return 0;
+
+  double alpha, beta, gamma, w;
+  int i;
+  for (i=0; i<par->n; i++) {
+    getangintegrationpoint(i, par, &alpha, &beta, &gamma, &w);
+    if (alpha != D->angle[i][0] || beta != D->angle[i][1] || 
+	gamma != D->angle[i][2])
+      return 0;
+  }
+
+  return 1;
+}
+
+
+static void initangDtable(angDtable* D, 
+			  const angintegrationpara* par, int jmax)
+{
+  int n = par->n;
+  int nph = 2*jmax-1;
+
+  D->jmax = jmax;
+  D->n = n;
+  D->nd = idxdj(jmax);
+
+  // product grids share beta values
+  int nbeta;
+  if (par->type == AngProd || par->type == AngProdA)
+    nbeta = par->prod.nbeta;
+  else
+    nbeta = n;
+
+  D->angle = malloc(n*sizeof(double[3]));
+  D->ibeta = malloc(n*sizeof(int));
+  D->d = malloc(nbeta*D->nd*sizeof(double));
+  D->ealpha = malloc(n*nph*sizeof(complex double));
+  D->egamma = malloc(n*nph*sizeof(complex double));
+
+  double w;
+  int i, m;
+  for (i=0; i<n; i++) {
+    getangintegrationpoint(i, par, &D->angle[i][0], &D->angle[i][1], 
+			   &D->angle[i][2], &w);
+    D->ibeta[i] = i % nbeta;
+    for (m=-(jmax-1); m<=jmax-1; m++) {
+      D->ealpha[m+jmax-1+i*nph] = cexp(0.5*I*m*D->angle[i][0]);
+      D->egamma[m+jmax-1+i*nph] = cexp(0.5*I*m*D->angle[i][2]);
+    }
+  }
+
+  for (i=0; i<nbeta; i++)
+    djmktable(jmax, D->angle[i][1], D->d+i*D->nd);
+}
+
+
+static void freeangDtable(angDtable* D)
+{
+  free(D->angle);
+  free(D->ibeta);
+  free(D->d);
+  free(D->ealpha);
+  free(D->egamma);
+}
+
+
+const angDtable* getangDtable(const angintegrationpara* par, int jmax)
+{
+  int i;
+  for (i=0; i<nDtable; i++)
+    if (matchangDtable(&Dtable[i], par, jmax))
+      return &Dtable[i];
+
+  angDtable* D = &Dtable[nextDtable];
+  if (nDtable < NDTABLES)
+    nDtable++;
+  else
+    freeangDtable(D);
+  nextDtable = (nextDtable+1) % NDTABLES;
+
+  initangDtable(D, par, jmax);
+
+  return D;
+}
@@ -26,11 +26,12 @@ typedef struct {
 } gcmpara;
 
 
-void gob_dcm(const gcmpara* para,
+void gob_dcm(void* par,
 	     const Gaussian* G1, const Gaussian* G2,
 	     const GaussianAux* X, const gradGaussianAux* dX,
 	     complex double* dcm, gradGaussian* ddcm)
 {
+  gcmpara* para = par;
   int i;
   double M;
   double* dXcm = para->X;
@@ -100,3 +101,26 @@ void calcgradCMSlaterDetTBME(const SlaterDet* Q, const SlaterDetAux* X,
 
   calcgradSlaterDetOBME(Q, X, dX, &gop_ob_dcm, grad);
 }
+
+
+void calcgradCMSlaterDetSepME(const SlaterDet* Q, const SlaterDetAux* X,
+			      const gradSlaterDetAux* dX,
+			      const SeparableOperator* op,
+			      gradSlaterDet* grad)
+{
+  int i;
+  double dcm[6];
+  calcSlaterDetSepME(Q, X, op, dcm);
+
+  gcmpara para;
+  para.A = Q->A; para.Z = Q->Z; para.N = Q->N;
+  for (i=0; i<3; i++)
+    para.X[i] = dcm[i];
+  for (i=0; i<3; i++)
+    para.V[i] = dcm[i+3];
+
+  gradOneBodyOperator gop_ob_dcm = {opt: op->opt & OPTTPROP, par: &para, 
+				    me: gob_dcm}; 
+
+  calcgradSlaterDetOBME(Q, X, dX, &gop_ob_dcm, grad);
+}
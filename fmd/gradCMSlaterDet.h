@@ -37,4 +37,9 @@ void calcgradCMSlaterDetTBME(const SlaterDet* Q, const SlaterDetAux* X,
 			     const TwoBodyOperator* op,
 			     gradSlaterDet* grad);
 
+void calcgradCMSlaterDetSepME(const SlaterDet* Q, const SlaterDetAux* X,
+			      const gradSlaterDetAux* dX,
+			      const SeparableOperator* op,
+			      gradSlaterDet* grad);
+
 #endif
@@ -59,3 +59,48 @@ void calcgradGaussianAux(const Gaussian* G1, const Gaussian* G2,
     dX->dQ.b[i] = X->T* X->S* dX->dR.b[i];
   }
 }
+
+
+// derivatives which depend only on X are reused for the swapped pair
+void calcgradGaussianAuxherm(const Gaussian* G1, const Gaussian* G2, 
+			     const GaussianAux* X, const GaussianAux* Xh,
+			     gradGaussianAux* dX, gradGaussianAux* dXh)
+{
+  int i;
+
+  calcgradGaussianAux(G1, G2, X, dX);
+
+  dXh->dsig.chi[0][0] = G1->chi[1];	dXh->dsig.chi[1][0] = G1->chi[0];
+  dXh->dsig.chi[0][1] = -I*G1->chi[1];	dXh->dsig.chi[1][1] = I*G1->chi[0];
+  dXh->dsig.chi[0][2] = G1->chi[0];	dXh->dsig.chi[1][2] = -G1->chi[1];
+
+  dXh->dlambda = conj(dX->dlambda);
+  dXh->dalpha = Xh->lambda*(G1->a - Xh->alpha);
+
+  for (i=0; i<3; i++) 
+    dXh->drho.a[i] = Xh->lambda*(G1->b[i] - Xh->rho[i]);
+  dXh->drho.b = G1->a*Xh->lambda;
+
+  dXh->drho2.a = 2*cvec3mult(dXh->drho.a, Xh->rho);
+  for (i=0; i<3; i++)
+    dXh->drho2.b[i] = 2*dXh->drho.b*Xh->rho[i];
+  
+  for (i=0; i<3; i++)
+    dXh->dpi.a[i] = conj(dX->dpi.a[i]);
+  dXh->dpi.b = -conj(dX->dpi.b);
+
+  dXh->dpi2.a = conj(dX->dpi2.a);
+  for (i=0; i<3; i++)
+    dXh->dpi2.b[i] = -conj(dX->dpi2.b[i]);
+  
+  for (i=0; i<2; i++) {
+    dXh->dS.chi[i] = G1->chi[i];
+    dXh->dQ.chi[i] = Xh->T* dXh->dS.chi[i]* Xh->R;
+  }
+  dXh->dR.a = 0.5*(3.0/conj(G2->a) - 3.0*Xh->lambda - Xh->pi2)*Xh->R;
+  dXh->dQ.a = Xh->T* Xh->S* dXh->dR.a;
+  for (i=0; i<3; i++) {
+    dXh->dR.b[i] = -conj(dX->dR.b[i]);
+    dXh->dQ.b[i] = Xh->T* Xh->S* dXh->dR.b[i];
+  }
+}
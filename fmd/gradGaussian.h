@@ -77,7 +77,7 @@ typedef struct {
 } gradOneBodyOperator;
 
 
-/// Two-body operator
+/// Two-body operator, opt as in TwoBodyOperator
 typedef struct {
   int opt;
   void* par;
@@ -147,5 +147,11 @@ inline static void rotategradGaussian(gradGaussian* dG,
 void calcgradGaussianAux(const Gaussian* G1, const Gaussian* G2, 
 			 const GaussianAux* X, gradGaussianAux* dX);
 
+/// calculate derivatives dX for G1, G2 and dXh for G2, G1 together,
+/// X and Xh are the auxiliaries for G1, G2 and G2, G1
+void calcgradGaussianAuxherm(const Gaussian* G1, const Gaussian* G2, 
+			     const GaussianAux* X, const GaussianAux* Xh,
+			     gradGaussianAux* dX, gradGaussianAux* dXh);
+
 
 #endif
@@ -37,15 +37,31 @@
 
 #include "numerics/cmath.h"
 #include "numerics/coulomb.h"
+#include "misc/profile.h"
 
 
-static void gtb_pot(Interaction* P,
+// generic two-body potential kernel, inlined into the specialized
+// kernels below with features known at compile time
+static inline __attribute__((always_inline))
+void gtb_pot_kernel(const int features, Interaction* P,
 		    const Gaussian* G1, const Gaussian* G2, 
 		    const Gaussian* G3, const Gaussian* G4, 
 		    const GaussianAux* X13, const GaussianAux* X24, 
 		    const gradGaussianAux* dX13,
 		    complex double* v, gradGaussian* dv)
 {	
+  // interaction terms, compile-time constants in the specialized kernels
+  const int spinorbit = (features & FEATSPINORBIT) && P->spinorbit;
+  const int tensor = (features & FEATTENSOR) && P->tensor;
+  const int momentump2 = (features & FEATMOMENTUMP2) && P->momentump2;
+  const int momentumpr2 = (features & FEATMOMENTUMPR2) && P->momentumpr2;
+  const int l2 = (features & FEATL2) && P->l2;
+  const int l2ls = (features & FEATL2LS) && P->l2ls;
+  const int tll = (features & FEATTLL) && P->tll;
+  const int tpp = (features & FEATTPP) && P->tpp;
+  const int l2tpp = (features & FEATL2TPP) && P->l2tpp;
+  const int prtrp = (features & FEATPRTRP) && P->prtrp;
+
   int TT, tautau;
 
   TT = X13->T * X24->T;
@@ -60,7 +76,7 @@ static void gtb_pot(Interaction* P,
   complex double lambda, alpha, rho[3], rho2, pi[3], pi2;
   complex double dlambda, dalpha;
   gradVector drho, dpi;
-  gradScalar drho2, dpi2;
+  gradScalar drho2, dpi2 = {0};
   complex double sigsig;
   gradSpinor dsigsig;
 
@@ -70,22 +86,26 @@ static void gtb_pot(Interaction* P,
   complex double psi, dpsi;
   
   complex double rhopi;
-  gradScalar drhopi;
+  gradScalar drhopi = {0};
 
-  complex double rhoxpi[3];
+  complex double rhoxpi[3] = {0};
   complex double L2;
-  gradScalar dL2;
+  gradScalar dL2 = {0};
   
   complex double S[3], LS;
-  gradGaussian dLS;
+  gradGaussian dLS = {0};
   
   complex double lsigrho, rsigrho, S12;
-  gradGaussian dS12;
+  gradGaussian dS12 = {0};
 
   complex double lsigpi, rsigpi, lsigrhoxpi, rsigrhoxpi;
   
   complex double S12ll, S12pipi, S12rhopi;
-  gradGaussian dS12ll, dS12pipi, dS12rhopi;
+  gradGaussian dS12ll = {0}, dS12pipi = {0}, dS12rhopi = {0};
+
+  // terms only needed for some interactions
+  pi2 = beta = dbeta = theta = dtheta = psi = dpsi = rhopi = 0.0;
+  L2 = LS = S12 = S12ll = S12pipi = S12rhopi = 0.0;
 
   complex double vcoul;
   gradScalar dvcoul;
@@ -128,7 +148,7 @@ static void gtb_pot(Interaction* P,
   for (i=0; i<2; i++)
     dsigsig.chi[i] = cvec3mult(dX13->dsig.chi[i], X24->sig);
 
-  if (P->momentump2 || P->momentumpr2 || P->l2 || P->l2ls || P->tll || P->tpp || P->prtrp || P->l2tpp) {
+  if (momentump2 || momentumpr2 || l2 || l2ls || tll || tpp || prtrp || l2tpp) {
     rtheta = (conj(G1->a)*X13->lambda + conj(G2->a)*X24->lambda);
     ltheta = (G3->a*X13->lambda + G4->a*X24->lambda);
     dltheta = - G3->a* csqr(X13->lambda);
@@ -154,7 +174,7 @@ static void gtb_pot(Interaction* P,
       drhopi.b[i] = drho.b*pi[i]+rho[i]*dpi.b;
   }
     
-  if (P->l2 || P->spinorbit || P->l2ls || P->tll || P->tpp || P->l2tpp){
+  if (l2 || spinorbit || l2ls || tll || tpp || l2tpp){
     cvec3cross(rho, pi, rhoxpi);
     
     L2 = cvec3sqr(rhoxpi);
@@ -164,7 +184,7 @@ static void gtb_pot(Interaction* P,
       dL2.b[i] = drho2.b[i]*pi2 + rho2*dpi2.b[i] - 2*rhopi*drhopi.b[i];
   }
     
-  if (P->spinorbit || P->l2ls) {
+  if (spinorbit || l2ls) {
     for (i=0; i<3; i++)
       S[i] = 0.5*(X13->sig[i]*X24->S+X13->S*X24->sig[i]);
     LS = cvec3mult(rhoxpi, S);
@@ -182,7 +202,7 @@ static void gtb_pot(Interaction* P,
                (drho.b*pi[1]-rho[1]*dpi.b)*S[0];
   }
 
-  if (P->tensor || P->tll || P->tpp || P->prtrp || P->l2tpp) {
+  if (tensor || tll || tpp || prtrp || l2tpp) {
     lsigrho = cvec3mult(X13->sig, rho); 
     rsigrho = cvec3mult(X24->sig, rho);
     
@@ -199,7 +219,7 @@ static void gtb_pot(Interaction* P,
 	sigsig* drho2.b[i];
   }
     
-  if (P->tll || P->tpp || P->prtrp || P->l2tpp) { 
+  if (tll || tpp || prtrp || l2tpp) { 
     lsigpi = cvec3mult(X13->sig, pi);
     rsigpi = cvec3mult(X24->sig, pi);
     		
@@ -236,7 +256,7 @@ static void gtb_pot(Interaction* P,
     
   }
     
-  if (P->tll || P->tpp || P->l2tpp) {
+  if (tll || tpp || l2tpp) {
     lsigrhoxpi = cvec3mult(X13->sig, rhoxpi);
     rsigrhoxpi = cvec3mult(X24->sig, rhoxpi);
   
@@ -279,27 +299,27 @@ static void gtb_pot(Interaction* P,
   complex double iakapi, kapakapi, diakapi, dkapakapi;
   complex double thelakapi, dthelakapi;
   complex double Gi;
-  gradScalar dGi;
+  gradScalar dGi = {0};
 
   
   complex double PiPi, PiPiG, PirPir;
-  gradScalar dPiPi, dPiPiG, dPirPir;
+  gradScalar dPiPi = {0}, dPiPiG = {0}, dPirPir = {0};
   int pipidone=0, pipigdone=0, pirpirdone=0;
   
   complex double LL;
-  gradScalar dLL;
+  gradScalar dLL = {0};
   int l2done=0;
   
   complex double L2LS;
-  gradGaussian dL2LS;
+  gradGaussian dL2LS = {0};
   int l2lsdone=0;
   
   complex double TLL, TPP, TRP;
-  gradGaussian dTLL, dTPP, dTRP;
+  gradGaussian dTLL = {0}, dTPP = {0}, dTRP = {0};
   int tlldone=0, tppdone=0, trpdone=0;
   
   complex double L2TPP;
-  gradGaussian dL2TPP;
+  gradGaussian dL2TPP = {0};
   int l2tppdone=0;
   
   complex double tppll, tpppipi, tpprhopi, tpprr;
@@ -307,6 +327,11 @@ static void gtb_pot(Interaction* P,
   complex double l2tpppipi, l2tpprhopi, l2tpprr, l2tppll;
   
   gradScalar dl2tpppipi, dl2tpprhopi, dl2tpprr, dl2tppll;
+
+  iakapi = kapakapi = diakapi = dkapakapi = 0.0;
+  thelakapi = dthelakapi = Gi = 0.0;
+  PiPi = PiPiG = PirPir = LL = L2LS = 0.0;
+  TLL = TPP = TRP = L2TPP = 0.0;
   
   int idx;
 
@@ -321,7 +346,7 @@ static void gtb_pot(Interaction* P,
       diakapi = -dalpha*csqr(iakapi);
       kapakapi = kappa*iakapi;
       dkapakapi = kappa*diakapi;
-      if (P->l2 || P->l2ls || P->tll || P->tpp || P->prtrp || P->l2tpp) {
+      if (l2 || l2ls || tll || tpp || prtrp || l2tpp) {
         thelakapi = theta*iakapi + lambda*kapakapi;
 	dthelakapi = dtheta*iakapi + theta*diakapi + dlambda*kapakapi + lambda*dkapakapi;
       }
@@ -343,7 +368,7 @@ static void gtb_pot(Interaction* P,
     }
 
     // p2V
-    if (!pipidone && (p2V <= type && type <= tsp2V)) {
+    if (momentump2 && !pipidone && (p2V <= type && type <= tsp2V)) {
       PiPi = pi2-0.5*beta*iakapi*rhopi+
 	0.25*theta*csqr(iakapi)*rho2+
 	0.75*(lambda-theta*iakapi);
@@ -360,7 +385,7 @@ static void gtb_pot(Interaction* P,
     }
 
     // Vp2
-    if (!pipigdone && (Vp2 <= type && type <= tsVp2)) {
+    if (momentump2 && !pipigdone && (Vp2 <= type && type <= tsVp2)) {
       PiPiG = pi2-0.5*beta*iakapi*rhopi+
 	(0.25*theta-0.5)*csqr(iakapi)*rho2+
 	0.75*lambda-(0.75*theta-1.5)*iakapi;
@@ -377,7 +402,7 @@ static void gtb_pot(Interaction* P,
     }
 
     // pr2V
-    if (!pirpirdone && (pr2V <= type && type <= tspr2V)) {
+    if (momentumpr2 && !pirpirdone && (pr2V <= type && type <= tspr2V)) {
       PirPir = 
 	csqr(kapakapi)*(csqr(rhopi)-0.5*beta*iakapi*rhopi*rho2+
 			0.25*theta*csqr(iakapi)*csqr(rho2))+
@@ -423,7 +448,7 @@ static void gtb_pot(Interaction* P,
     }
 
     // Vl2
-    if (!l2done && (Vl2 <= type && type <= tsVl2)) {
+    if (l2 && !l2done && (Vl2 <= type && type <= tsVl2)) {
       LL = kapakapi*
              (kapakapi*L2 + 2*alpha*pi2 - beta*rhopi + 0.5*(theta*iakapi+lambda*kapakapi)*rho2 -
     	      1.5*(theta - alpha*lambda));
@@ -447,7 +472,7 @@ static void gtb_pot(Interaction* P,
 
 
     // Vl2ls
-    if (!l2lsdone && (type == Vl2ls || type == tVl2ls)) {
+    if (l2ls && !l2lsdone && (type == Vl2ls || type == tVl2ls)) {
       L2LS = LS*csqr(kapakapi)*
                (kapakapi*L2 + 4*alpha*pi2 - 2*beta*rhopi + (theta*iakapi + lambda*kapakapi)*rho2 -
       		5*(theta - alpha*lambda)) + 
@@ -482,7 +507,7 @@ static void gtb_pot(Interaction* P,
     }		    
     
     // VTll - S12(l,l)
-    if (!tlldone && (type == VTll || type == tVTll)) {
+    if (tll && !tlldone && (type == VTll || type == tVTll)) {
       TLL = kapakapi*(kapakapi*S12ll - alpha*S12pipi -
       	    	      0.25*(theta*iakapi + lambda*kapakapi)*S12 +
 	              0.5*beta*S12rhopi);
@@ -507,7 +532,7 @@ static void gtb_pot(Interaction* P,
     }
     
     // VTpp - S12(p,p)
-    if (!tppdone && (type == VTpp || type == tVTpp)) {
+    if (tpp && !tppdone && (type == VTpp || type == tVTpp)) {
       tppll = 5*alpha + kapakapi*rho2;    
       
       tpppipi = 9*csqr(alpha) + 13*alpha*kapakapi*rho2 + 2*csqr(kapakapi*rho2);
@@ -569,7 +594,7 @@ static void gtb_pot(Interaction* P,
     }
     
     // prVTrp (p_r v(r) +v(r) p_r) S12(r,p)
-    if (!trpdone && (type == prVTrp || type == tprVTrp)) {
+    if (prtrp && !trpdone && (type == prVTrp || type == tprVTrp)) {
       trppipi = 2*alpha*(3*alpha + kapakapi*rho2);
       
       trprhopi = -1.5*alpha*beta*(2 - 7*kapakapi) - 0.5*csqr(kapakapi)*beta*iakapi*csqr(rho2) +
@@ -642,7 +667,7 @@ static void gtb_pot(Interaction* P,
     }
     
     // Vl2Tpp - {L2 S12(p,p)}_H
-    if (!l2tppdone && (type == Vl2Tpp || type == tVl2Tpp)) {
+    if (l2tpp && !l2tppdone && (type == Vl2Tpp || type == tVl2Tpp)) {
       
       // l2tpppipi
       l2tpppipi = 60*cpow(alpha, 3)*kapakapi*pi2 + 117*csqr(alpha*kapakapi)*pi2*rho2
@@ -950,7 +975,7 @@ static void gtb_pot(Interaction* P,
     } 
 
     // p2V Potentials
-    else if (type == p2V && TT) {
+    else if (momentump2 && type == p2V && TT) {
       *v += gamma*TT*SS*PiPi*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -959,7 +984,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
 	dv->b[i] += gamma*TT*SS*(dPiPi.b[i]*RR*Gi+PiPi*dRR.b[i]*Gi+PiPi*RR*dGi.b[i]);
     } 
-    else if (type == sp2V && TT) {
+    else if (momentump2 && type == sp2V && TT) {
       *v += gamma*TT*sigsig*PiPi*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -968,7 +993,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
 	dv->b[i] += gamma*TT*sigsig*(dPiPi.b[i]*RR*Gi+PiPi*dRR.b[i]*Gi+PiPi*RR*dGi.b[i]);
     } 
-    else if (type == tp2V && tautau) {
+    else if (momentump2 && type == tp2V && tautau) {
       *v += gamma*tautau*SS*PiPi*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -977,7 +1002,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
 	dv->b[i] += gamma*tautau*SS*(dPiPi.b[i]*RR*Gi+PiPi*dRR.b[i]*Gi+PiPi*RR*dGi.b[i]);
     } 
-    else if (type == tsp2V && tautau) {
+    else if (momentump2 && type == tsp2V && tautau) {
       *v += gamma*tautau*sigsig*PiPi*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -988,7 +1013,7 @@ static void gtb_pot(Interaction* P,
     } 
 
     // Vp2 Potentials
-    else if (type == Vp2 && TT) {
+    else if (momentump2 && type == Vp2 && TT) {
       *v += gamma*TT*SS*PiPiG*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -997,7 +1022,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
 	dv->b[i] += gamma*TT*SS*(dPiPiG.b[i]*RR*Gi+PiPiG*dRR.b[i]*Gi+PiPiG*RR*dGi.b[i]);
     } 
-    else if (type == sVp2 && TT) {
+    else if (momentump2 && type == sVp2 && TT) {
       *v += gamma*TT*sigsig*PiPiG*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1006,7 +1031,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
 	dv->b[i] += gamma*TT*sigsig*(dPiPiG.b[i]*RR*Gi+PiPiG*dRR.b[i]*Gi+PiPiG*RR*dGi.b[i]);
     } 
-    else if (type == tVp2 && tautau) {
+    else if (momentump2 && type == tVp2 && tautau) {
       *v += gamma*tautau*SS*PiPiG*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1015,7 +1040,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
 	dv->b[i] += gamma*tautau*SS*(dPiPiG.b[i]*RR*Gi+PiPiG*dRR.b[i]*Gi+PiPiG*RR*dGi.b[i]);
     } 
-    else if (type == tsVp2 && tautau) {
+    else if (momentump2 && type == tsVp2 && tautau) {
       *v += gamma*tautau*sigsig*PiPiG*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1026,7 +1051,7 @@ static void gtb_pot(Interaction* P,
     } 
 
     // pr2 Potentials
-    else if (type == pr2V && TT) {
+    else if (momentumpr2 && type == pr2V && TT) {
       *v += gamma*TT*SS*PirPir*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1036,7 +1061,7 @@ static void gtb_pot(Interaction* P,
 	dv->b[i] += gamma*TT*SS*(dPirPir.b[i]*RR*Gi+PirPir*dRR.b[i]*Gi+
 				PirPir*RR*dGi.b[i]);
     } 
-    else if (type == spr2V && TT) {
+    else if (momentumpr2 && type == spr2V && TT) {
       *v += gamma*TT*sigsig*PirPir*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1046,7 +1071,7 @@ static void gtb_pot(Interaction* P,
 	dv->b[i] += gamma*TT*sigsig*(dPirPir.b[i]*RR*Gi+PirPir*dRR.b[i]*Gi+
 				    PirPir*RR*dGi.b[i]);
     } 
-    else if (type == tpr2V && tautau) {
+    else if (momentumpr2 && type == tpr2V && tautau) {
       *v += gamma*tautau*SS*PirPir*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1056,7 +1081,7 @@ static void gtb_pot(Interaction* P,
 	dv->b[i] += gamma*tautau*SS*(dPirPir.b[i]*RR*Gi+PirPir*dRR.b[i]*Gi+
 				    PirPir*RR*dGi.b[i]);
     } 
-    else if (type == tspr2V && tautau) {
+    else if (momentumpr2 && type == tspr2V && tautau) {
       *v += gamma*tautau*sigsig*PirPir*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1068,7 +1093,7 @@ static void gtb_pot(Interaction* P,
     } 
 
     // L2 Potentials
-    else if (type == Vl2 && TT) {
+    else if (l2 && type == Vl2 && TT) {
       *v += gamma*TT*SS*RR*Gi*LL;
         
       for (i=0; i<2; i++)
@@ -1077,7 +1102,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
         dv->b[i] += gamma*TT*SS*(dRR.b[i]*Gi*LL + RR*dGi.b[i]*LL + RR*Gi*dLL.b[i]);    
     }
-    else if (type == sVl2 && TT) {
+    else if (l2 && type == sVl2 && TT) {
       *v += gamma*TT*sigsig*RR*Gi*LL;
         
       for (i=0; i<2; i++)
@@ -1086,7 +1111,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
         dv->b[i] += gamma*TT*sigsig*(dRR.b[i]*Gi*LL + RR*dGi.b[i]*LL + RR*Gi*dLL.b[i]);    
     }
-    else if (type == tVl2 && tautau) {
+    else if (l2 && type == tVl2 && tautau) {
       *v += gamma*tautau*SS*RR*Gi*LL;
         
       for (i=0; i<2; i++)
@@ -1095,7 +1120,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
         dv->b[i] += gamma*tautau*SS*(dRR.b[i]*Gi*LL + RR*dGi.b[i]*LL + RR*Gi*dLL.b[i]);    
     }
-    else if (type == tsVl2 && tautau) {
+    else if (l2 && type == tsVl2 && tautau) {
       *v += gamma*tautau*sigsig*RR*Gi*LL;
         
       for (i=0; i<2; i++)
@@ -1106,7 +1131,7 @@ static void gtb_pot(Interaction* P,
     }
     
     // Spin-Orbit Potentials
-    else if (type == Vls && TT) {
+    else if (spinorbit && type == Vls && TT) {
       *v += gamma*TT*LS*kapakapi*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1116,7 +1141,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
 	dv->b[i] += gamma*TT*kapakapi*(dLS.b[i]*RR*Gi+LS*dRR.b[i]*Gi+LS*RR*dGi.b[i]);
     } 
-    else if (type == tVls && tautau) {
+    else if (spinorbit && type == tVls && tautau) {
       *v += gamma*tautau*LS*kapakapi*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1128,7 +1153,7 @@ static void gtb_pot(Interaction* P,
     } 
 
     // L2LS Potentials
-    else if (type == Vl2ls && TT) {
+    else if (l2ls && type == Vl2ls && TT) {
       *v += gamma*TT*RR*Gi*L2LS;
       
       for (i=0; i<2; i++)
@@ -1137,7 +1162,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
         dv->b[i] += gamma*TT*(dRR.b[i]*Gi*L2LS + RR*dGi.b[i]*L2LS + RR*Gi*dL2LS.b[i]);
     }
-    else if (type == tVl2ls && tautau) {
+    else if (l2ls && type == tVl2ls && tautau) {
       *v += gamma*tautau*RR*Gi*L2LS;
       
       for (i=0; i<2; i++)
@@ -1148,7 +1173,7 @@ static void gtb_pot(Interaction* P,
     }
 
     // Tensor Potentials
-    else if (type == VT && TT) {
+    else if (tensor && type == VT && TT) {
       *v += gamma*TT*S12*csqr(kapakapi)*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1160,7 +1185,7 @@ static void gtb_pot(Interaction* P,
 	dv->b[i] += gamma*TT*csqr(kapakapi)*(dS12.b[i]*RR*Gi+S12*dRR.b[i]*Gi+
 					     S12*RR*dGi.b[i]);
     } 
-    else if (type == tVT && tautau) {
+    else if (tensor && type == tVT && tautau) {
       *v += gamma*tautau*S12*csqr(kapakapi)*RR*Gi;
 
       for (i=0; i<2; i++)
@@ -1174,7 +1199,7 @@ static void gtb_pot(Interaction* P,
     } 
 
     // TLL Potentials
-    else if (type == VTll && TT) {
+    else if (tll && type == VTll && TT) {
       *v += gamma*TT*RR*Gi*TLL;
       
       for (i=0; i<2; i++)
@@ -1183,7 +1208,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
         dv->b[i] += gamma*TT*(dRR.b[i]*Gi*TLL + RR*dGi.b[i]*TLL + RR*Gi*dTLL.b[i]);
     }
-    else if (type == tVTll && tautau) {
+    else if (tll && type == tVTll && tautau) {
       *v += gamma*tautau*RR*Gi*TLL;
       
       for (i=0; i<2; i++)
@@ -1194,7 +1219,7 @@ static void gtb_pot(Interaction* P,
     }
              
     // TPP
-    else if (type == VTpp && TT) {
+    else if (tpp && type == VTpp && TT) {
       *v += gamma*TT*RR*Gi*TPP;
       
       for (i=0; i<2; i++)
@@ -1203,7 +1228,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
         dv->b[i] += gamma*TT*(dRR.b[i]*Gi*TPP + RR*dGi.b[i]*TPP + RR*Gi*dTPP.b[i]);
     }
-    else if (type == tVTpp && tautau) {
+    else if (tpp && type == tVTpp && tautau) {
       *v += gamma*tautau*RR*Gi*TPP;
       
       for (i=0; i<2; i++)
@@ -1214,7 +1239,7 @@ static void gtb_pot(Interaction* P,
     }
     
     // (p_r v(r) + v(r) p_r)S12(r,p)
-    else if (type == prVTrp && TT) {
+    else if (prtrp && type == prVTrp && TT) {
       *v += gamma*TT*RR*Gi*TRP;
       
       for (i=0; i<2; i++)
@@ -1223,7 +1248,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
         dv->b[i] += gamma*TT*(dRR.b[i]*Gi*TRP + RR*dGi.b[i]*TRP + RR*Gi*dTRP.b[i]);
     }
-    else if (type == tprVTrp && tautau) {
+    else if (prtrp && type == tprVTrp && tautau) {
       *v += gamma*tautau*RR*Gi*TRP;
       
       for (i=0; i<2; i++)
@@ -1234,7 +1259,7 @@ static void gtb_pot(Interaction* P,
     }
     
     // {L^2 S12(p,p)}_H
-    else if (type == Vl2Tpp && TT) {
+    else if (l2tpp && type == Vl2Tpp && TT) {
       *v += gamma*TT*RR*Gi*L2TPP;
       
       for (i=0; i<2; i++)
@@ -1243,7 +1268,7 @@ static void gtb_pot(Interaction* P,
       for (i=0; i<3; i++)
         dv->b[i] += gamma*TT*(dRR.b[i]*Gi*L2TPP + RR*dGi.b[i]*L2TPP + RR*Gi*dL2TPP.b[i]);
     }
-    else if (type == tVl2Tpp && tautau) {
+    else if (l2tpp && type == tVl2Tpp && tautau) {
       *v += gamma*tautau*RR*Gi*L2TPP;
       
       for (i=0; i<2; i++)
@@ -1275,14 +1300,56 @@ static void gtb_pot(Interaction* P,
 }
 
 
+// specialized kernels, terms not contained in the feature set
+// are removed by the compiler
+#define GTB_POT(name, features)						\
+static void name(void* par,						\
+		 const Gaussian* G1, const Gaussian* G2,		\
+		 const Gaussian* G3, const Gaussian* G4,		\
+		 const GaussianAux* X13, const GaussianAux* X24,	\
+		 const gradGaussianAux* dX13,				\
+		 complex double* v, gradGaussian* dv)			\
+{									\
+  gtb_pot_kernel(features, par, G1, G2, G3, G4, X13, X24, dX13, v, dv); \
+}
+
+GTB_POT(gtb_pot_central, KERNELCENTRAL)
+GTB_POT(gtb_pot_centralls, KERNELCENTRALLS)
+GTB_POT(gtb_pot_tensor, KERNELTENSOR)
+GTB_POT(gtb_pot, KERNELALL)
+
+
+// two-body operator with the kernel specialized on the features of P,
+// dispatched once per gradient
+static void initgtb_pot(const Interaction* P, gradTwoBodyOperator* op)
+{
+  int features = Interactionfeatures(P);
+
+  op->opt = OPTCHARGE;
+  op->par = (Interaction*) P;
+
+  if (!(features & ~KERNELCENTRAL))
+    op->me = gtb_pot_central;
+  else if (!(features & ~KERNELCENTRALLS))
+    op->me = gtb_pot_centralls;
+  else if (!(features & ~KERNELTENSOR))
+    op->me = gtb_pot_tensor;
+  else
+    op->me = gtb_pot;
+}
+
+
 void calcgradPotential(const Interaction *P,
 		       const SlaterDet* Q, const SlaterDetAux* X, 
 		       const gradSlaterDetAux* dX,
 		       gradSlaterDet* dv)
 {
-  gradTwoBodyOperator gop_tb_pot = {opt: 0, par: P, me: gtb_pot};
+  PROFILEBEGIN("calcgradPotential")
+  gradTwoBodyOperator gop_tb_pot;
+  initgtb_pot(P, &gop_tb_pot);
 
   calcgradSlaterDetTBME(Q, X, dX, &gop_tb_pot, dv);
+  PROFILEEND
 }
 
 
@@ -1292,9 +1359,12 @@ void calcgradPotentialod(const Interaction *P,
 			 const gradSlaterDetAux* dX,
 			 gradSlaterDet* dv)
 {
-  gradTwoBodyOperator gop_tb_pot = {opt: 0, par: P, me: gtb_pot};
+  PROFILEBEGIN("calcgradPotentialod")
+  gradTwoBodyOperator gop_tb_pot;
+  initgtb_pot(P, &gop_tb_pot);
 
   calcgradSlaterDetTBMEod(Q, Qp, X, dX, &gop_tb_pot, dv);
+  PROFILEEND
 }
 
 
@@ -1304,7 +1374,8 @@ void calcgradPotentialrowcol(const Interaction *P,
 			     gradSlaterDet* dv,
 			     int k, int l)
 {
-  gradTwoBodyOperator gop_tb_pot = {opt: 0, par: P, me: gtb_pot};
+  gradTwoBodyOperator gop_tb_pot;
+  initgtb_pot(P, &gop_tb_pot);
 
   calcgradSlaterDetTBMErowcol(Q, X, dX, &gop_tb_pot, dv, k, l);
 }
@@ -1317,7 +1388,8 @@ void calcgradPotentialodrowcol(const Interaction *P,
 			       gradSlaterDet* dv,
 			       int k, int l)
 {
-  gradTwoBodyOperator gop_tb_pot = {opt: 0, par: P, me: gtb_pot};
+  gradTwoBodyOperator gop_tb_pot;
+  initgtb_pot(P, &gop_tb_pot);
 
   calcgradSlaterDetTBMEodrowcol(Q, Qp, X, dX, &gop_tb_pot, dv, k, l);
 }
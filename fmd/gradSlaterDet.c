@@ -19,6 +19,8 @@
 #include "gradSlaterDet.h"
 
 #include "numerics/cmath.h"
+#include "numerics/cmat.h"
+#include "misc/profile.h"
 
 #define SQR(x) (x)*(x)
 
@@ -135,6 +137,7 @@ void freegradSlaterDetAux(gradSlaterDetAux* dX)
 void calcgradSlaterDetAux(const SlaterDet* Q, const SlaterDetAux* X,
 			  gradSlaterDetAux* dX)
 {
+  PROFILEBEGIN("calcgradSlaterDetAux")
   int A=Q->A; int ngauss=Q->ngauss; 
   int* idx=Q->idx; int* ng=Q->ng;
   Gaussian* G=Q->G;
@@ -146,10 +149,15 @@ void calcgradSlaterDetAux(const SlaterDet* Q, const SlaterDetAux* X,
   int k,l,m,mi;
   gradGaussian dn;
 
-  for (l=0; l<ngauss; l++)
-    for (k=0; k<ngauss; k++)
-      calcgradGaussianAux(&G[k], &G[l], &Gaux[k+l*ngauss],
-			  &dGaux[k+l*ngauss]);
+  // pairs (l,k) together with (k,l)
+  for (l=0; l<ngauss; l++) {
+    for (k=0; k<l; k++)
+      calcgradGaussianAuxherm(&G[k], &G[l], 
+			      &Gaux[k+l*ngauss], &Gaux[l+k*ngauss],
+			      &dGaux[k+l*ngauss], &dGaux[l+k*ngauss]);
+    calcgradGaussianAux(&G[l], &G[l], &Gaux[l+l*ngauss],
+			&dGaux[l+l*ngauss]);
+  }
 
   for (l=0; l<A; l++)
     for (k=0; k<ngauss; k++)
@@ -163,6 +171,7 @@ void calcgradSlaterDetAux(const SlaterDet* Q, const SlaterDetAux* X,
       for (l=0; l<A; l++)
 	addmulttogradGaussian(&dno[k+l*ngauss], &dn, o[m+l*A]);
     }
+  PROFILEEND
 }
 
 
@@ -170,6 +179,7 @@ void calcgradSlaterDetAuxod(const SlaterDet* Q, const SlaterDet* Qp,
 			    const SlaterDetAux* X,
 			    gradSlaterDetAux* dX)
 {
+  PROFILEBEGIN("calcgradSlaterDetAuxod")
   int A=Q->A; int ngauss=Q->ngauss; 
   int* idx=Q->idx; int* idxp=Qp->idx;
   int* ng=Q->ng; int* ngp=Qp->ng;
@@ -202,6 +212,7 @@ void calcgradSlaterDetAuxod(const SlaterDet* Q, const SlaterDet* Qp,
       for (l=0; l<A; l++)
 	addmulttogradGaussian(&dno[k+l*ngauss], &dn, o[m+l*A]);
     }
+  PROFILEEND
 }
 
 
@@ -324,6 +335,40 @@ void calcgradSlaterDetOBMEod(const SlaterDet* Q, const SlaterDet* Qp,
 }
 
 
+// the two-body matrix element depends on Q also through the inverse 
+// overlap matrix o. Contributions gval*(o(m,s)o(n,l)-o(n,s)o(m,l)) 
+// for all k,l,m,n have been collected in D(k,j), contract D with o
+// and the overlap gradients dno once instead of for every k,l,m,n
+static void propagategradSlaterDetTBME(const SlaterDet* Q, 
+				       const SlaterDetAux* X,
+				       const gradSlaterDetAux* dX,
+				       const complex double* D,
+				       complex double fac,
+				       gradSlaterDet* grad)
+{
+  int A=Q->A; int ngauss=Q->ngauss;
+  int* idx = Q->idx; int* ng = Q->ng;
+  complex double* o=X->o;
+  gradGaussian* dno=dX->dno;
+  gradGaussian* dval = grad->gradval;
+
+  int k,j,s,si;
+  complex double Do;
+
+  for (s=0; s<A; s++)
+    for (k=0; k<A; k++) {
+      Do = 0.0;
+      for (j=0; j<A; j++)
+	Do += D[k+j*A]*o[j+s*A];
+      if (Do != 0.0)
+	for (si=0; si<ng[s]; si++)
+	  addmulttogradGaussian(&dval[idx[s]+si], 
+				&dno[(idx[s]+si)+k*ngauss],
+				-Do*fac);
+    }
+}
+
+
 void calcgradSlaterDetTBME(const SlaterDet* Q, const SlaterDetAux* X,
 			   const gradSlaterDetAux* dX,
 			   const gradTwoBodyOperator* op, 
@@ -335,20 +380,30 @@ void calcgradSlaterDetTBME(const SlaterDet* Q, const SlaterDetAux* X,
   GaussianAux* Gaux=X->Gaux;
   complex double* o=X->o;
   gradGaussianAux* dGaux=dX->dGaux;
-  gradGaussian* dno=dX->dno;
   complex double* val = &grad->val; gradGaussian* dval = grad->gradval;
 
-  int k,l,m,n,s, ki,li,mi,ni,si;
+  int k,l,m,n, ki,li,mi,ni;
+  int kk,mm, blk,nblk, tk[2],tm[2];
+  int xi[A], part[3*A], npart[3];
   complex double gval;
   gradGaussian gdval;
   complex double ooa;
+  complex double D[A*A];
+
+  for (l=0; l<A*A; l++)
+    D[l] = 0.0;
+
+  SlaterDetisospinpartition(Q, xi, part, npart);
 
   for (n=0; n<A; n++)
     for (l=0; l<A; l++)
-      if (!op->opt || Gaux[idx[l]+idx[n]*ngauss].T) {
-	for (m=0; m<A; m++)
-	  for (k=0; k<A; k++)
-	    if (!op->opt || Gaux[idx[k]+idx[m]*ngauss].T) {
+      if (!(op->opt & OPTTPROP) || Gaux[idx[l]+idx[n]*ngauss].T) {
+	nblk = isospinblocks(op->opt, xi[l], xi[n], tk, tm);
+	for (blk=0; blk<nblk; blk++)
+	for (mm=0; mm<npart[tm[blk]]; mm++)
+	  for (kk=0; kk<npart[tk[blk]]; kk++) {
+	    m = part[tm[blk]*A+mm]; k = part[tk[blk]*A+kk];
+	    if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idx[m]*ngauss].T) {
 
 	      ooa = o[m+k*A]*o[n+l*A]-o[n+k*A]*o[m+l*A];
 
@@ -372,15 +427,13 @@ void calcgradSlaterDetTBME(const SlaterDet* Q, const SlaterDetAux* X,
 	      }
 	      *val += 0.5*gval*ooa;
 
-	      for (s=0; s<A; s++) {
-		ooa = o[m+s*A]*o[n+l*A]-o[n+s*A]*o[m+l*A];
-		for (si=0; si<ng[s]; si++)
-		  addmulttogradGaussian(&dval[idx[s]+si], 
-					&dno[(idx[s]+si)+k*ngauss],
-					-gval*ooa);
-	      }
+	      D[k+m*A] += gval*o[n+l*A];
+	      D[k+n*A] -= gval*o[m+l*A];
 	    }
+	  }
       }
+
+  propagategradSlaterDetTBME(Q, X, dX, D, 1.0, grad);
 }
 
 
@@ -401,18 +454,30 @@ void calcgradSlaterDetTBMEod(const SlaterDet* Q, const SlaterDet* Qp,
   complex double val; gradGaussian* dval = grad->gradval;
   complex double ovl = X->ovlap;
 
-  int k,l,m,n,s, ki,li,mi,ni,si;
+  int k,l,m,n, ki,li,mi,ni;
+  int kk,mm, blk,nblk, tk[2],tm[2];
+  int xi[A], xip[A], part[3*A], partp[3*A], npart[3], npartp[3];
   complex double gval;
   gradGaussian gdval;
   complex double ooa;
+  complex double D[A*A];
+
+  for (l=0; l<A*A; l++)
+    D[l] = 0.0;
 
   val = 0.0;
+  SlaterDetisospinpartition(Q, xi, part, npart);
+  SlaterDetisospinpartition(Qp, xip, partp, npartp);
+
   for (n=0; n<A; n++)
     for (l=0; l<A; l++)
-      if (!op->opt || Gaux[idx[l]+idxp[n]*ngauss].T) {
-	for (m=0; m<A; m++)
-	  for (k=0; k<A; k++)
-	    if (!op->opt || Gaux[idx[k]+idxp[m]*ngauss].T) {
+      if (!(op->opt & OPTTPROP) || Gaux[idx[l]+idxp[n]*ngauss].T) {
+	nblk = isospinblocks(op->opt, xi[l], xip[n], tk, tm);
+	for (blk=0; blk<nblk; blk++)
+	for (mm=0; mm<npartp[tm[blk]]; mm++)
+	  for (kk=0; kk<npart[tk[blk]]; kk++) {
+	    m = partp[tm[blk]*A+mm]; k = part[tk[blk]*A+kk];
+	    if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idxp[m]*ngauss].T) {
 
 	      ooa = o[m+k*A]*o[n+l*A]-o[n+k*A]*o[m+l*A];
 
@@ -436,16 +501,14 @@ void calcgradSlaterDetTBMEod(const SlaterDet* Q, const SlaterDet* Qp,
 	      }
 	      val += 0.5*gval*ooa*ovl;
 
-	      for (s=0; s<A; s++) {
-		ooa = o[m+s*A]*o[n+l*A]-o[n+s*A]*o[m+l*A];
-		for (si=0; si<ng[s]; si++)
-		  addmulttogradGaussian(&dval[idx[s]+si], 
-					&dno[(idx[s]+si)+k*ngauss],
-					-gval*ooa*ovl);
-	      }
+	      D[k+m*A] += gval*o[n+l*A];
+	      D[k+n*A] -= gval*o[m+l*A];
 	    }
+	  }
       }	
 
+  propagategradSlaterDetTBME(Q, X, dX, D, ovl, grad);
+
   grad->val += val;
 
   // this term is comming from the derivative of the overlap
@@ -467,13 +530,16 @@ void calcgradSlaterDetTBMErowcol(const SlaterDet* Q, const SlaterDetAux* X,
   GaussianAux* Gaux=X->Gaux;
   complex double* o=X->o;
   gradGaussianAux* dGaux=dX->dGaux;
-  gradGaussian* dno=dX->dno;
   complex double* val = &grad->val; gradGaussian* dval = grad->gradval;
 
-  int m,n,s, ki,li,mi,ni,si;
+  int m,n, ki,li,mi,ni;
   complex double gval;
   gradGaussian gdval;
   complex double ooa;
+  complex double D[A*A];
+
+  for (m=0; m<A*A; m++)
+    D[m] = 0.0;
 
   // zero gradient, as each k,l component is calculated independendly
   *val = 0.0;
@@ -482,10 +548,10 @@ void calcgradSlaterDetTBMErowcol(const SlaterDet* Q, const SlaterDetAux* X,
 
   for (n=0; n<A; n++)
     // for (l=0; l<A; l++)
-      if (!op->opt || Gaux[idx[l]+idx[n]*ngauss].T) {
+      if (!(op->opt & OPTTPROP) || Gaux[idx[l]+idx[n]*ngauss].T) {
 	for (m=0; m<A; m++)
 	  // for (k=0; k<A; k++)
-	    if (!op->opt || Gaux[idx[k]+idx[m]*ngauss].T) {
+	    if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idx[m]*ngauss].T) {
 
 	      ooa = o[m+k*A]*o[n+l*A]-o[n+k*A]*o[m+l*A];
 
@@ -509,15 +575,12 @@ void calcgradSlaterDetTBMErowcol(const SlaterDet* Q, const SlaterDetAux* X,
 	      }
 	      *val += 0.5*gval*ooa;
 
-	      for (s=0; s<A; s++) {
-		ooa = o[m+s*A]*o[n+l*A] - o[n+s*A]*o[m+l*A];
-		for (si=0; si<ng[s]; si++)
-		  addmulttogradGaussian(&dval[idx[s]+si], 
-					&dno[(idx[s]+si)+k*ngauss],
-					-gval*ooa);
-	      }
+	      D[k+m*A] += gval*o[n+l*A];
+	      D[k+n*A] -= gval*o[m+l*A];
 	    }
       }
+
+  propagategradSlaterDetTBME(Q, X, dX, D, 1.0, grad);
 }
 
 
@@ -543,6 +606,10 @@ void calcgradSlaterDetTBMEodrowcol(const SlaterDet* Q, const SlaterDet* Qp,
   complex double gval;
   gradGaussian gdval;
   complex double ooa;
+  complex double D[A*A];
+
+  for (m=0; m<A*A; m++)
+    D[m] = 0.0;
 
   // zero gradient
   grad->val = 0.0;
@@ -552,10 +619,10 @@ void calcgradSlaterDetTBMEodrowcol(const SlaterDet* Q, const SlaterDet* Qp,
   val = 0.0;
   for (n=0; n<A; n++)
     // for (l=0; l<A; l++)
-      if (!op->opt || Gaux[idx[l]+idxp[n]*ngauss].T) {
+      if (!(op->opt & OPTTPROP) || Gaux[idx[l]+idxp[n]*ngauss].T) {
 	for (m=0; m<A; m++)
 	  // for (k=0; k<A; k++)
-	    if (!op->opt || Gaux[idx[k]+idxp[m]*ngauss].T) {
+	    if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idxp[m]*ngauss].T) {
 
 	      ooa = o[m+k*A]*o[n+l*A]-o[n+k*A]*o[m+l*A];
 
@@ -578,16 +645,13 @@ void calcgradSlaterDetTBMEodrowcol(const SlaterDet* Q, const SlaterDet* Qp,
 	      }
 	      val += 0.5*gval*ooa*ovl;
 
-	      for (s=0; s<A; s++) {
-		ooa = o[m+s*A]*o[n+l*A]-o[n+s*A]*o[m+l*A];
-		for (si=0; si<ng[s]; si++)
-		  addmulttogradGaussian(&dval[idx[s]+si], 
-					&dno[(idx[s]+si)+k*ngauss],
-					-gval*ooa*ovl);
-	      }
+	      D[k+m*A] += gval*o[n+l*A];
+	      D[k+n*A] -= gval*o[m+l*A];
 	    }
       }	
 
+  propagategradSlaterDetTBME(Q, X, dX, D, ovl, grad);
+
   grad->val += val;
 
   // this term is comming from the derivative of the overlap
@@ -595,3 +659,147 @@ void calcgradSlaterDetTBMEodrowcol(const SlaterDet* Q, const SlaterDet* Qp,
     for (si=0; si<ng[s]; si++)
       addmulttogradGaussian(&dval[idx[s]+si], &dno[(idx[s]+si)+s*ngauss], val);
 }
+
+
+// separable operator: with the one-body transition matrices F(c) and
+// K(a) = sum_t w_t/2 (tr(F(b)o) - o F(b)) (and a <-> b) the matrix 
+// element is 1/2 sum_c tr(F(c) K(c) o), the gradients of F(c) are 
+// contracted with K(c)o, the dependence on o goes through D = sum_c F(c)K(c)
+static void calcgradSlaterDetSep(const SlaterDet* Q, const SlaterDet* Qp,
+				 const SlaterDetAux* X,
+				 const gradSlaterDetAux* dX,
+				 const gradSeparableOperator* op,
+				 complex double ovl,
+				 gradSlaterDet* grad, complex double* val)
+{
+  int A=Q->A; int ngauss=Q->ngauss; int nob=op->nob; int AA=A*A;
+  int* idx = Q->idx; int* idxp = Qp->idx; 
+  int* ng = Q->ng; int* ngp = Qp->ng;
+  Gaussian* G=Q->G; Gaussian* Gp=Qp->G;
+  GaussianAux* Gaux=X->Gaux;
+  complex double* o=X->o;
+  gradGaussianAux* dGaux=dX->dGaux;
+  gradGaussian* dval = grad->gradval;
+
+  int k,m,ki,mi,c,t,a,b;
+  double w;
+  complex double gval[nob], tr[nob];
+  gradGaussian gdval[nob];
+  complex double oF[AA], FK[AA], D[AA];
+  complex double* F = malloc(3*nob*AA*sizeof(complex double));
+  complex double* K = F+nob*AA;
+  complex double* Ko = K+nob*AA;
+  gradGaussian* dF = malloc(nob*ngauss*A*sizeof(gradGaussian));
+
+  for (m=0; m<A; m++)
+    for (k=0; k<A; k++) {
+      for (c=0; c<nob; c++)
+	gval[c] = 0.0;
+
+      for (ki=0; ki<ng[k]; ki++) {
+	for (c=0; c<nob; c++)
+	  zerogradGaussian(&gdval[c]);
+	if (!(op->opt & OPTTPROP) || Gaux[idx[k]+idxp[m]*ngauss].T)
+	  for (mi=0; mi<ngp[m]; mi++)
+	    op->me(op->par,
+		   &G[idx[k]+ki], &Gp[idxp[m]+mi],
+		   &Gaux[(idx[k]+ki)+(idxp[m]+mi)*ngauss],
+		   &dGaux[(idx[k]+ki)+(idxp[m]+mi)*ngauss],
+		   gval, gdval);
+	for (c=0; c<nob; c++)
+	  dF[(idx[k]+ki)+m*ngauss+c*ngauss*A] = gdval[c];
+      }
+
+      for (c=0; c<nob; c++)
+	F[k+m*A+c*AA] = gval[c];
+    }
+
+  for (c=0; c<nob; c++) {
+    multcmat(&F[c*AA], o, Ko, A);
+    tr[c] = 0.0;
+    for (k=0; k<A; k++)
+      tr[c] += Ko[k+k*A];
+    for (k=0; k<AA; k++)
+      K[k+c*AA] = 0.0;
+  }
+
+  for (t=0; t<op->nterms; t++) {
+    a = op->terms[t].a; b = op->terms[t].b; w = op->terms[t].w;
+
+    multcmat(o, &F[b*AA], oF, A);
+    for (k=0; k<AA; k++)
+      K[k+a*AA] -= 0.5*w*oF[k];
+    for (k=0; k<A; k++)
+      K[k+k*A+a*AA] += 0.5*w*tr[b];
+
+    multcmat(o, &F[a*AA], oF, A);
+    for (k=0; k<AA; k++)
+      K[k+b*AA] -= 0.5*w*oF[k];
+    for (k=0; k<A; k++)
+      K[k+k*A+b*AA] += 0.5*w*tr[a];
+  }
+
+  *val = 0.0;
+  for (k=0; k<AA; k++)
+    D[k] = 0.0;
+
+  for (c=0; c<nob; c++) {
+    multcmat(&K[c*AA], o, &Ko[c*AA], A);
+    multcmat(&F[c*AA], &K[c*AA], FK, A);
+
+    for (k=0; k<AA; k++)
+      D[k] += FK[k];
+
+    for (k=0; k<A; k++)
+      for (m=0; m<A; m++) {
+	*val += 0.5*F[k+m*A+c*AA]*Ko[m+k*A+c*AA];
+	for (ki=0; ki<ng[k]; ki++)
+	  addmulttogradGaussian(&dval[idx[k]+ki], 
+				&dF[(idx[k]+ki)+m*ngauss+c*ngauss*A],
+				Ko[m+k*A+c*AA]*ovl);
+      }
+  }
+  *val *= ovl;
+
+  propagategradSlaterDetTBME(Q, X, dX, D, ovl, grad);
+
+  free(dF);
+  free(F);
+}
+
+
+void calcgradSlaterDetSepME(const SlaterDet* Q, const SlaterDetAux* X,
+			    const gradSlaterDetAux* dX,
+			    const gradSeparableOperator* op, 
+			    gradSlaterDet* grad)
+{
+  complex double val;
+
+  calcgradSlaterDetSep(Q, Q, X, dX, op, 1.0, grad, &val);
+
+  grad->val += val;
+}
+
+
+void calcgradSlaterDetSepMEod(const SlaterDet* Q, const SlaterDet* Qp, 
+			      const SlaterDetAux* X,
+			      const gradSlaterDetAux* dX,
+			      const gradSeparableOperator* op, 
+			      gradSlaterDet* grad)
+{
+  int A=Q->A; int ngauss=Q->ngauss;
+  int* idx = Q->idx; int* ng = Q->ng;
+  gradGaussian* dno=dX->dno;
+  gradGaussian* dval = grad->gradval;
+  complex double val;
+  int k,ki;
+
+  calcgradSlaterDetSep(Q, Qp, X, dX, op, X->ovlap, grad, &val);
+
+  grad->val += val;
+
+  // this term is comming from the derivative of the overlap
+  for (k=0; k<A; k++)
+    for (ki=0; ki<ng[k]; ki++)
+      addmulttogradGaussian(&dval[idx[k]+ki], &dno[(idx[k]+ki)+k*ngauss], val);
+}
@@ -29,6 +29,21 @@ typedef struct {
 } gradSlaterDetAux;
 
 
+/// Separable two-body operator, terms as in SeparableOperator,
+/// the index i of the terms is not used
+typedef struct {
+  int nob;
+  int opt;
+  const void* par;
+  void (*me)(const void* parameters,
+	     const Gaussian* G1, const Gaussian* G2, 
+	     const GaussianAux* X12, const gradGaussianAux* dX12, 
+	     complex double val[], gradGaussian dval[]);
+  int nterms;
+  const SeparableTerm* terms;
+} gradSeparableOperator;
+
+
 /// gradient of functionial f from Slater determinant
 typedef struct {
   int ngauss;
@@ -68,8 +83,8 @@ void initgradSlaterDetAux(const SlaterDet* Q, gradSlaterDetAux* dX);
 /// free memory used by gradSlaterDetAux dX
 void freegradSlaterDetAux(gradSlaterDetAux* dX);
 
-/// calculate SlaterDetAux for SlaterDet Q.
-/// hermiticity not exploited yet
+/// calculate gradSlaterDetAux for SlaterDet Q.
+/// auxiliaries for pairs (l,k) are calculated together with (k,l)
 void calcgradSlaterDetAux(const SlaterDet* Q, const SlaterDetAux* X,
 			  gradSlaterDetAux* dX);
 
@@ -124,4 +139,18 @@ void calcgradSlaterDetTBMEodrowcol(const SlaterDet* Q, const SlaterDet* Qp,
 				   gradSlaterDet* G,
 				   int k, int l);
 
+/// calculate gradient of matrix element with SlaterDet Q for
+/// separable two-body operator op
+/// val and dval(ngauss) will be added up
+void calcgradSlaterDetSepME(const SlaterDet* Q, const SlaterDetAux* X,
+			    const gradSlaterDetAux* dX,
+			    const gradSeparableOperator* op, 
+			    gradSlaterDet* G);
+
+void calcgradSlaterDetSepMEod(const SlaterDet* Q, const SlaterDet* Qp, 
+			      const SlaterDetAux* X,
+			      const gradSlaterDetAux* dX,
+			      const gradSeparableOperator* op, 
+			      gradSlaterDet* G);
+
 #endif
@@ -19,20 +19,16 @@
 #include "fmd/ProjectedDensityMatrixHO.h"
 
 #include "Communication.h"
+#include "Projectionmpi.h"
 #include "DiagonalDensityHOSlave.h"
 
 
 
 void DiagonalDensityHOSlave(void)
 {
-  MPI_Status status;
-
   DensityMatrixHOPar DMpar;
   int A;
-  SlaterDet Q, Qp, Qpp;
-  SlaterDetAux X;
-  complex double* dmme;
-  int dimdm;
+  SlaterDet Q, Qp;
 
   int task;
 
@@ -43,15 +39,10 @@ void DiagonalDensityHOSlave(void)
   BroadcastParameters(&DMpar, sizeof(DensityMatrixHOPar));
   initHOBasis(DMpar.nmax);
 
-  dimdm = (DMpar.nmax+1)*(DMpar.nmax+2);
-  dmme = malloc(2*dimdm*sizeof(complex double));
-
   BroadcastA(&A);
 
   allocateSlaterDet(&Q, A);
   allocateSlaterDet(&Qp, A);
-  allocateSlaterDet(&Qpp, A);
-  allocateSlaterDetAux(&X, A);
 
   while (1) {
 
@@ -59,38 +50,11 @@ void DiagonalDensityHOSlave(void)
     if (task != TASKPROJECTEDDIAGONALDENSITYMATRIXHOOD)
       return;
 
-    double projpar[6];
-    double *angle, *R;
-
     BroadcastSlaterDet(&Q);
     BroadcastSlaterDet(&Qp);
 
-    while (1) {
-
-      MPI_Recv(projpar, 6, MPI_DOUBLE, 0, TAGPROJECT6, MPI_COMM_WORLD, &status);
-      if (projpar[0] < 0.0)
-	break;
-	
-      angle = &projpar[0];
-      R = &projpar[3];
-      
-      copySlaterDet(&Qp, &Qpp);
-
-      moveSlaterDet(&Qpp, R);
-      rotateSlaterDet(&Qpp, angle[0], angle[1], angle[2]);
-
-      calcSlaterDetAuxod(&Q, &Qpp, &X); 
-      calcDiagonalDensityMatrixHOod(&DMpar, &Q, &Qpp, &X, &dmme[0]);
-
-      invertSlaterDet(&Qpp);
-
-      calcSlaterDetAuxod(&Q, &Qpp, &X); 
-      calcDiagonalDensityMatrixHOod(&DMpar, &Q, &Qpp, &X, &dmme[dimdm]);
-      
-      MPI_Send(dmme, 2*dimdm*sizeof(complex double), MPI_BYTE, 
-	       0, TAGMEOD, MPI_COMM_WORLD);
-
-    }	
+    integrateprojectedMBMEmpi(NULL, &Q, &Qp, 
+			      (projectionmpikernel) calcDiagonalDensityMatrixHOod, &DMpar, NULL);
 
   }
 
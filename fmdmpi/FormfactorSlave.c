@@ -19,20 +19,16 @@
 #include "fmd/Formfactors.h"
 
 #include "Communication.h"
+#include "Projectionmpi.h"
 #include "FormfactorSlave.h"
 
 
 
 void FormfactorSlave(void)
 {
-  MPI_Status status;
-
   FormfactorPara FfP;
   int A;
-  SlaterDet Q, Qp, Qpp;
-  SlaterDetAux X;
-  complex double* ffme;
-  int dimff;
+  SlaterDet Q, Qp;
 
   int task;
 
@@ -41,15 +37,11 @@ void FormfactorSlave(void)
     return;
 
   BroadcastParameters(&FfP, sizeof(FormfactorPara));
-  dimff = 2*FfP.npoints;
-  ffme = malloc(2*dimff*sizeof(complex double));
 
   BroadcastA(&A);
 
   allocateSlaterDet(&Q, A);
   allocateSlaterDet(&Qp, A);
-  allocateSlaterDet(&Qpp, A);
-  allocateSlaterDetAux(&X, A);
 
   while (1) {
 
@@ -57,38 +49,11 @@ void FormfactorSlave(void)
     if (task != TASKPROJECTMONOPOLEFORMFACTOROD)
       return;
 
-    double projpar[6];
-    double *angle, *R;
-
     BroadcastSlaterDet(&Q);
     BroadcastSlaterDet(&Qp);
 
-    while (1) {
-
-      MPI_Recv(projpar, 6, MPI_DOUBLE, 0, TAGPROJECT6, MPI_COMM_WORLD, &status);
-      if (projpar[0] < 0.0)
-	break;
-	
-      angle = &projpar[0];
-      R = &projpar[3];
-      
-      copySlaterDet(&Qp, &Qpp);
-
-      moveSlaterDet(&Qpp, R);
-      rotateSlaterDet(&Qpp, angle[0], angle[1], angle[2]);
-
-      calcSlaterDetAuxod(&Q, &Qpp, &X); 
-      calcMonopoleFormfactorod(&FfP, &Q, &Qpp, &X, &ffme[0]);
-
-      invertSlaterDet(&Qpp);
-
-      calcSlaterDetAuxod(&Q, &Qpp, &X); 
-      calcMonopoleFormfactorod(&FfP, &Q, &Qpp, &X, &ffme[dimff]);
-      
-      MPI_Send(ffme, 2*dimff*sizeof(complex double), MPI_BYTE, 
-	       0, TAGMEOD, MPI_COMM_WORLD);
-
-    }	
+    integrateprojectedMBMEmpi(NULL, &Q, &Qp, 
+			      calcMonopoleFormfactorod, &FfP, NULL);
 
   }
 
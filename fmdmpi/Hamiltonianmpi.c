@@ -17,6 +17,7 @@
 #include "fmd/Interaction.h"
 #include "fmd/KineticEnergy.h"
 #include "fmd/CenterofMass.h"
+#include "fmd/Potential.h"
 
 #include "Communication.h"
 #include "Hamiltonianmpi.h"
@@ -60,146 +61,83 @@ void calcHamiltonianodmpi(const Interaction *P,
 
 #define SQR(x) ((x)*(x))
 
-void calcPotentialmpi(const Interaction *P,
-                      const SlaterDet* Q, const SlaterDetAux* X, double v[])
+// every rank calculates a fixed share of the pairs k<l,
+// results are summed over all ranks
+
+void calcPotentialmpiblock(const Interaction *P,
+			   const SlaterDet* Q, const SlaterDetAux* X, 
+			   double v[])
 {
   int i;
   int A=Q->A;
-  int todo=(A*(A-1))/2;
-
-  int k[2]={0,1}; 
-  int done=0; int rank;
+  int k,l,kl=0;
   int dim=P->n;
   double vrowcol[dim];
-  MPI_Status status;
 
   for (i=0; i<dim; i++)
     v[i] = 0.0;
 
+  for (k=0; k<A; k++)
+    for (l=k+1; l<A; l++, kl++)
+      if (kl % mpisize == mpirank) {
+	calcPotentialrowcol(P, Q, X, vrowcol, k, l);
+	for (i=0; i<dim; i++)
+	  v[i] += vrowcol[i];
+      }
+
+  MPI_Allreduce(MPI_IN_PLACE, v, dim, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+}
+
+
+void calcPotentialmpi(const Interaction *P,
+                      const SlaterDet* Q, const SlaterDetAux* X, double v[])
+{
   int task = TASKPOTENTIAL;
   BroadcastTask(&task);
 
   BroadcastSlaterDet(Q);	
   // BroadcastSlaterDetAux(Q, X);
 
-  // supply slaves with work
-  for (rank=1; rank<mpisize; rank++) {
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-    k[1]++;
-    if (k[1] == A) {
-      k[0]++; k[1]=k[0]+1;
-    }
-  }
-
-  while (1) {
-    MPI_Recv(vrowcol, dim, MPI_DOUBLE, MPI_ANY_SOURCE, TAGPOTENTIAL,
-             MPI_COMM_WORLD, &status);
-    rank = status.MPI_SOURCE;
-
-    for (i=0; i<dim; i++)
-      v[i] += vrowcol[i];
-
-    done++;
-
-    // all work distributed ?
-    if (k[0] == A-1)
-      break;
-
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-
-    k[1]++;
-    if (k[1] == A) {
-      k[0]++; k[1]=k[0]+1;
-    }
-  }
-
-  // collect remaining results
-  while (done<todo) {
-    MPI_Recv(vrowcol, dim, MPI_DOUBLE, MPI_ANY_SOURCE, TAGPOTENTIAL,
-             MPI_COMM_WORLD, &status);
-
-    for (i=0; i<dim; i++)
-      v[i] += vrowcol[i];
-  
-    done++;
-  }
-
-  // tell slaves we have finished
-  k[0] = -1;
-  for (rank=1; rank<mpisize; rank++) {
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-  }
+  calcPotentialmpiblock(P, Q, X, v);
 }
 
 
-void calcPotentialodmpi(const Interaction *P,
-			const SlaterDet* Q, const SlaterDet* Qp,
-			const SlaterDetAux* X, complex double v[])
+void calcPotentialodmpiblock(const Interaction *P,
+			     const SlaterDet* Q, const SlaterDet* Qp,
+			     const SlaterDetAux* X, complex double v[])
 {
-  int task = TASKPOTENTIALOD;
   int i;
   int A=Q->A;
-  int todo=(A*(A-1))/2;
-  int k[2]={0,1}; 
-  int done=0; int rank;
+  int k,l,kl=0;
   int dim=P->n;
   complex double vrowcol[dim];
-  MPI_Status status;
 
   for (i=0; i<dim; i++)
     v[i] = 0.0;
 
+  for (k=0; k<A; k++)
+    for (l=k+1; l<A; l++, kl++)
+      if (kl % mpisize == mpirank) {
+	calcPotentialodrowcol(P, Q, Qp, X, vrowcol, k, l);
+	for (i=0; i<dim; i++)
+	  v[i] += vrowcol[i];
+      }
+
+  MPI_Allreduce(MPI_IN_PLACE, v, dim, MPI_DOUBLE_COMPLEX, MPI_SUM, 
+		MPI_COMM_WORLD);
+}
+
+
+void calcPotentialodmpi(const Interaction *P,
+			const SlaterDet* Q, const SlaterDet* Qp,
+			const SlaterDetAux* X, complex double v[])
+{
+  int task = TASKPOTENTIALOD;
   BroadcastTask(&task);
+
   BroadcastSlaterDet(Q);
   BroadcastSlaterDet(Qp);
   // BroadcastSlaterDetAux(Q, X);
 
-  // supply slaves with work
-  for (rank=1; rank<mpisize; rank++) {
-
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-    k[1]++;
-    if (k[1] == A) {
-      k[0]++; k[1]=k[0]+1;
-    }
-  }
-
-  while (1) {
-    MPI_Recv(vrowcol, dim, MPI_DOUBLE_COMPLEX, MPI_ANY_SOURCE, TAGPOTENTIALOD,
-             MPI_COMM_WORLD, &status);
-    rank = status.MPI_SOURCE;
-
-    for (i=0; i<dim; i++)
-      v[i] += vrowcol[i];
-
-    done++;
-
-    // all work distributed ?
-    if (k[0] == A-1)
-      break;
-
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-
-    k[1]++;
-    if (k[1] == A) {
-      k[0]++; k[1]=k[0]+1;
-    }
-  }
-
-  // collect remaining results
-  while (done<todo) {
-    MPI_Recv(vrowcol, dim, MPI_DOUBLE_COMPLEX, MPI_ANY_SOURCE, TAGPOTENTIALOD,
-             MPI_COMM_WORLD, &status);
-
-    for (i=0; i<dim; i++)
-      v[i] += vrowcol[i];
-  
-    done++;
-  }
-
-  // tell slaves we have finished
-  k[0] = -1;
-  for (rank=1; rank<mpisize; rank++) {
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-  }
+  calcPotentialodmpiblock(P, Q, Qp, X, v);
 }
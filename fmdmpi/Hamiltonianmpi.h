@@ -36,4 +36,14 @@ void calcPotentialodmpi(const Interaction *P,
 			const SlaterDet* Q, const SlaterDet* Qp,
 			const SlaterDetAux* X, complex double v[]);
 
+/// share of potential matrix element calculated on this rank,
+/// summed over all ranks, called by master and slaves
+void calcPotentialmpiblock(const Interaction *P,
+			   const SlaterDet* Q, const SlaterDetAux* X, 
+			   double v[]);
+
+void calcPotentialodmpiblock(const Interaction *P,
+			     const SlaterDet* Q, const SlaterDet* Qp,
+			     const SlaterDetAux* X, complex double v[]);
+
 #endif
@@ -20,13 +20,13 @@
 #include "fmd/gradPotential.h"
 
 #include "Communication.h"
+#include "Hamiltonianmpi.h"
+#include "gradHamiltonianmpi.h"
 #include "MinimizerSlave.h"
 
 
 void MinimizerSlave(void)
 {
-  MPI_Status status;
-
   Interaction Int;
   int A;
   SlaterDet Q;
@@ -54,39 +54,22 @@ void MinimizerSlave(void)
 
     BroadcastTask(&task);
     if (task == TASKPOTENTIAL) {
-      int k[2];
-
       BroadcastSlaterDet(&Q);
       // BroadcastSlaterDetAux(&Q, &X);
       calcSlaterDetAux(&Q, &X);
 
-      while (1) {
-	MPI_Recv(k, 2, MPI_INT, 0, TAGROWCOL, MPI_COMM_WORLD, &status);
-	if (k[0]==-1)
-	  break;
-	calcPotentialrowcol(&Int, &Q, &X, v, k[0], k[1]);
-	MPI_Send(v, Int.n, MPI_DOUBLE, 0, TAGPOTENTIAL, MPI_COMM_WORLD);
-      }
+      calcPotentialmpiblock(&Int, &Q, &X, v);
 
     } else if (task == TASKGRADPOTENTIAL) {
-      int k[2];
-
       BroadcastSlaterDet(&Q);
       // BroadcastSlaterDetAux(&Q, &X);
       // BroadcastgradSlaterDetAux(&Q, &dX);
       calcSlaterDetAux(&Q, &X);
       calcgradSlaterDetAux(&Q, &X, &dX);
 
-
-      while (1) {
-	MPI_Recv(k, 2, MPI_INT, 0, TAGROWCOL, MPI_COMM_WORLD, &status);
-	if (k[0]==-1)
-	  break;
-	calcgradPotentialrowcol(&Int, &Q, &X, &dX, &dv, k[0], k[1]);
-	MPI_Send(&dv.val, 1, MPI_DOUBLE_COMPLEX, 0, TAGGRADPOTENTIALVAL, MPI_COMM_WORLD);
-	MPI_Send(dv.gradval, Q.ngauss*sizeof(gradGaussian),
-		 MPI_BYTE, 0, TAGGRADPOTENTIALGRAD, MPI_COMM_WORLD);
-      }
+      dv.ngauss = Q.ngauss;
+      zerogradSlaterDet(&dv);
+      calcgradPotentialmpiblock(&Int, &Q, &X, &dX, &dv);
 
     } else if (task == TASKFIN) 
       return;
@@ -96,8 +79,6 @@ void MinimizerSlave(void)
 
 void MinimizerSlaveod(void)
 {
-  MPI_Status status;
-
   Interaction Int;
   int A;
   SlaterDet Q;
@@ -128,25 +109,14 @@ void MinimizerSlaveod(void)
 
     BroadcastTask(&task);
     if (task == TASKPOTENTIALOD) {
-      int k[2];
-
       BroadcastSlaterDet(&Q);
       BroadcastSlaterDet(&Qp);
       // BroadcastSlaterDetAux(&Q, &X);
       calcSlaterDetAuxod(&Q, &Qp, &X);
       
-      while (1) {
-	MPI_Recv(k, 2, MPI_INT, 0, TAGROWCOL, MPI_COMM_WORLD, &status);
-	if (k[0]==-1)
-	  break;
-	calcPotentialodrowcol(&Int, &Q, &Qp, &X, v, k[0], k[1]);
-	MPI_Send(v, Int.n, MPI_DOUBLE_COMPLEX, 0, TAGPOTENTIALOD, 
-		 MPI_COMM_WORLD);
-      }
+      calcPotentialodmpiblock(&Int, &Q, &Qp, &X, v);
 
     } else if (task == TASKGRADPOTENTIALOD) {
-      int k[2];
-
       BroadcastSlaterDet(&Q);
       BroadcastSlaterDet(&Qp);
       // BroadcastSlaterDetAux(&Q, &X);
@@ -154,16 +124,9 @@ void MinimizerSlaveod(void)
       calcSlaterDetAuxod(&Q, &Qp, &X);
       calcgradSlaterDetAuxod(&Q, &Qp, &X, &dX);
 
-      while (1) {
-	MPI_Recv(k, 2, MPI_INT, 0, TAGROWCOL, MPI_COMM_WORLD, &status);
-	if (k[0]==-1)
-	  break;
-	calcgradPotentialodrowcol(&Int, &Q, &Qp, &X, &dX, &dv, k[0], k[1]);
-	MPI_Send(&dv.val, 1, MPI_DOUBLE_COMPLEX, 0, TAGGRADPOTENTIALODVAL,
-		 MPI_COMM_WORLD);
-	MPI_Send(dv.gradval, Q.ngauss*sizeof(gradGaussian),
-		 MPI_BYTE, 0, TAGGRADPOTENTIALODGRAD, MPI_COMM_WORLD);
-      }
+      dv.ngauss = Q.ngauss;
+      zerogradSlaterDet(&dv);
+      calcgradPotentialodmpiblock(&Int, &Q, &Qp, &X, &dX, &dv);
 
     } else if (task == TASKFIN) 
       return;
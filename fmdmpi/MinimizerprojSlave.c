@@ -23,6 +23,8 @@
 #include "fmd/gradSlaterDet.h"
 #include "fmd/gradHamiltonian.h"
 
+#include "misc/profile.h"
+
 #include "Communication.h"
 #include "MinimizerprojSlave.h"
 
@@ -34,14 +36,15 @@ void MinimizerprojSlave(void)
 
   Interaction Int;
   int A;
-  SlaterDet Q, Qp, Qpp;
-  SlaterDetAux X;
+  SlaterDet Q, Qp, Qpp[2];
+  SlaterDetAux X[2];
+  SlaterDetAuxinv Y;
   gradSlaterDetAux dX;
   
   complex double h[2], n[2], j2[2];
   gradSlaterDet dh[2], dn[2];
 
-  int task;
+  int task, ip;
   int cmproj=0;
 
   BroadcastTask(&task);
@@ -56,8 +59,10 @@ void MinimizerprojSlave(void)
 
   allocateSlaterDet(&Q, A);
   allocateSlaterDet(&Qp, A);
-  allocateSlaterDet(&Qpp, A);
-  allocateSlaterDetAux(&X, A);
+  allocateSlaterDet(&Qpp[0], A);
+  allocateSlaterDet(&Qpp[1], A);
+  allocateSlaterDetAux(&X[0], A);
+  allocateSlaterDetAux(&X[1], A);
   allocategradSlaterDetAux(&dX, A);
   allocategradSlaterDet(&dh[0], A);
   allocategradSlaterDet(&dh[1], A);
@@ -74,46 +79,52 @@ void MinimizerprojSlave(void)
     BroadcastSlaterDet(&Q);
     BroadcastSlaterDet(&Qp);
 
+    // Gaussian pair auxiliaries not changing over the integration points
+    initSlaterDetAuxinv(&Q, &Qp, &Y);
+
     double projpar[6];
     double *angle, *R;
 
     while (1) {
 
       if (cmproj) {
+	PROFILEBEGIN("mpi wait")
 	MPI_Recv(projpar, 6, MPI_DOUBLE, 0, TAGPROJECT6, MPI_COMM_WORLD, &status);
+	PROFILEEND
 	if (projpar[0] < 0.0)
 	  break;
 
 	angle = &projpar[0];
 	R = &projpar[3];
 
-	copySlaterDet(&Qp, &Qpp);
-	moveSlaterDet(&Qpp, R);
-	rotateSlaterDet(&Qpp, angle[0], angle[1], angle[2]);
+	copySlaterDet(&Qp, &Qpp[0]);
+	moveSlaterDet(&Qpp[0], R);
+	rotateSlaterDet(&Qpp[0], angle[0], angle[1], angle[2]);
       } else {
+	PROFILEBEGIN("mpi wait")
 	MPI_Recv(projpar, 3, MPI_DOUBLE, 0, TAGPROJECT3, MPI_COMM_WORLD, &status);
+	PROFILEEND
 	if (projpar[0] < 0.0)
 	  break;
 
 	angle = &projpar[0];
 
-	copySlaterDet(&Qp, &Qpp);
-	rotateSlaterDet(&Qpp, angle[0], angle[1], angle[2]);
+	copySlaterDet(&Qp, &Qpp[0]);
+	rotateSlaterDet(&Qpp[0], angle[0], angle[1], angle[2]);
       }
 
+      copySlaterDet(&Qpp[0], &Qpp[1]);
+      invertSlaterDet(&Qpp[1]);
+
+      calcSlaterDetAuxodinvparity(&Q, &Qpp[0], &Y, &X[0], &X[1]);
+
       if (task == TASKHAMILTONIANOD) {
-	
-	calcSlaterDetAuxod(&Q, &Qpp, &X);
-	n[0] = X.ovlap;
-	calcHamiltonianod(&Int, &Q, &Qpp, &X, &h[0]);
-	calcConstraintJ2od(&Q, &Qpp, &X, &j2[0]);
-	
-	invertSlaterDet(&Qpp);
-
-	calcSlaterDetAuxod(&Q, &Qpp, &X); 
-	n[1] = X.ovlap;
-	calcHamiltonianod(&Int, &Q, &Qpp, &X, &h[1]);
-	calcConstraintJ2od(&Q, &Qpp, &X, &j2[1]);
+
+	for (ip=0; ip<=1; ip++) {
+	  n[ip] = X[ip].ovlap;
+	  calcHamiltonianod(&Int, &Q, &Qpp[ip], &X[ip], &h[ip]);
+	  calcConstraintJ2od(&Q, &Qpp[ip], &X[ip], &j2[ip]);
+	}
 
 	MPI_Send(h, 2, MPI_DOUBLE_COMPLEX, 0, TAGHAMILTONIANOD, MPI_COMM_WORLD);
 	MPI_Send(n, 2, MPI_DOUBLE_COMPLEX, 0, TAGOVLAPOD, MPI_COMM_WORLD);
@@ -122,17 +133,11 @@ void MinimizerprojSlave(void)
 
       if (task == TASKGRADHAMILTONIANOD) {
 
-	calcSlaterDetAuxod(&Q, &Qpp, &X);
-	calcgradSlaterDetAuxod(&Q, &Qpp, &X, &dX);
-	calcgradOvlapod(&Q, &Qpp, &X, &dX, &dn[0]);
-	calcgradHamiltonianod(&Int, &Q, &Qpp, &X, &dX, &dh[0]);
-
-	invertSlaterDet(&Qpp);
-
-	calcSlaterDetAuxod(&Q, &Qpp, &X); 
-	calcgradSlaterDetAuxod(&Q, &Qpp, &X, &dX);
-	calcgradOvlapod(&Q, &Qpp, &X, &dX, &dn[1]);
-	calcgradHamiltonianod(&Int, &Q, &Qpp, &X, &dX, &dh[1]);
+	for (ip=0; ip<=1; ip++) {
+	  calcgradSlaterDetAuxod(&Q, &Qpp[ip], &X[ip], &dX);
+	  calcgradOvlapod(&Q, &Qpp[ip], &X[ip], &dX, &dn[ip]);
+	  calcgradHamiltonianod(&Int, &Q, &Qpp[ip], &X[ip], &dX, &dh[ip]);
+	}
 
 	MPI_Send(&dh[0].val, 1, MPI_DOUBLE_COMPLEX, 0, TAGGRADHAMILTONIANODVAL, MPI_COMM_WORLD);
 	MPI_Send(dh[0].gradval, Q.ngauss*sizeof(gradGaussian),
@@ -150,6 +155,7 @@ void MinimizerprojSlave(void)
 
     }	
 
+    freeSlaterDetAuxinv(&Y);
   }
 
 }
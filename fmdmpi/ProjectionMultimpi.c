@@ -105,13 +105,9 @@ void calcprojectedMultiMBMEmpi(const Projection* P, const ManyBodyOperator* Op,
   int NA = MBA->N; int NB = MBB->N;
   int IA, IB;
 
-  SlaterDet Q, Qp, Qpp;
+  SlaterDet Q, Qp;
   allocateSlaterDet(&Q, MBA->A);
   allocateSlaterDet(&Qp, MBB->A);
-  allocateSlaterDet(&Qpp, MBB->A);
-
-  SlaterDetAux X;
-  allocateSlaterDetAux(&X, MAX(MBA->A, MBB->A));
 
   Symmetry S, Sp;
   int axialsym;
@@ -173,13 +169,23 @@ void calcprojectedMultiMBMEmpi(const Projection* P, const ManyBodyOperator* Op,
           dminarray(kappaA, nA), dmaxarray(kappaA, nA),
           dminarray(kappaB, nB), dmaxarray(kappaB, nB));
 
+  // projected kernel for a single pair of SlaterDets
+  int nkval=0;
+  for (p=0; p<=1; p++)
+    for (j=odd; j<jmax; j=j+2)
+      nkval += SQR(j+1)*(rank+1)*size;
+  complex double* kval = malloc(nkval*sizeof(complex double));
+
+  // for identical MultiSlaterDets only pairs iA <= iB are integrated
+  int herm = (MBA == MBB && usingHermiticity(Op));
+
   int c=0; 
-  int cmax=nA*nB; 
+  int cmax= herm ? nA*(nA+1)/2 : nA*nB; 
 
   for (iB=0; iB<nB; iB++) {
     MBB->get(MBB, iB, &Qp);
 
-    for (iA=0; iA<nA; iA++) {
+    for (iA=0; iA<(herm ? iB+1 : nA); iA++) {
       MBA->get(MBA, iA, &Q);
 
       // progress indicator
@@ -194,122 +200,63 @@ void calcprojectedMultiMBMEmpi(const Projection* P, const ManyBodyOperator* Op,
      // calcSlaterDetAuxod(&Qp, &Qp, &X);
     //  double normp = sqrt(creal(X.ovlap));  
 
-      // set up cm integration
-      cmintegrationpara cmpara;
-      double cmalpha = 0.5/(acmA[iA]+acmB[iB]);
-      _initcmintegration(P, cmalpha, &cmpara);
-      int ncm = cmpara.n;
-
-      // set up ang integration
-      angintegrationpara angpara;
-      double angkappa = dmin(kappaA[iA], kappaB[iB]);
-      _initangintegration(P, angkappa, S, Sp, &angpara);
-      int nang = angpara.n;
+      // kernel for this pair of SlaterDets, weights and symmetries of
+      // the many-body states are applied afterwards
+      projectionmpipara pp;
+      pp.P = *P;
+      pp.S = S; pp.Sp = Sp;
+      pp.symsel = 0;
+      pp.herm = 0;
+      pp.kappa = dmin(kappaA[iA], kappaB[iB]);
+      pp.cmalpha = 0.5/(acmA[iA]+acmB[iB]);
+      pp.n = 1;
+      pp.dim = dim;
+      pp.size = size;
+      pp.rank[0] = rank;
 
       BroadcastTask(&task);
       BroadcastSlaterDet(&Q);
       BroadcastSlaterDet(&Qp);
 
-      // loop over all the orientations
-      int pi;
-
-      int todo = nang*ncm;
-      int running=0;
-      int done=0;
-      int processor;
-      MPI_Status status;
-
-      // processor 0 is master
-      double pos[mpisize][3];
-      double angle[mpisize][3];
-      double weight[mpisize];
-      double projpar[6];
-  
-      // which slaves are working, at beginning none
-      int i;
-      int working[mpisize];
-      for (i=1; i<mpisize; i++)
-	working[i] = 0;
-
-      double weightang, weightcm;
-      complex double sval[2][(rank+1)*size];
-
-      int next=0;
-      while (done<todo) {
-
-	if (next<todo && running < mpisize-1) {	// supply slaves with work
-
-	  // find empty slave
-	  for (i=1; i<mpisize; i++)
-	    if (!working[i]) {
-	      processor = i;
-	      break;
-	    }
-
-	  getcmintegrationpoint(next/nang, &cmpara, pos[processor], &weightcm);
-	  getangintegrationpoint(next%nang, &angpara, &angle[processor][0], &angle[processor][1], &angle[processor][2], &weightang); 
-
-	 // weight[processor] = 1.0/(2*norm*normp)*weightcm*weightang;
-            weight[processor] = 0.5*weightcm*weightang;
-      
-	  for (i=0; i<3; i++) projpar[i] = angle[processor][i];
-	  for (i=0; i<3; i++) projpar[i+3] = pos[processor][i];
-
-	  MPI_Send(projpar, 6, MPI_DOUBLE, processor, TAGPROJECT6, MPI_COMM_WORLD);
-
-	  working[processor] = 1;
-	  running++;
-	  next++;
-	
-	} else {					// collect results from slaves
-
-	  MPI_Recv(sval, 2*(rank+1)*size, MPI_DOUBLE_COMPLEX, 
-		   MPI_ANY_SOURCE, TAGMEOD, MPI_COMM_WORLD, &status);
-	  processor = status.MPI_SOURCE;
-
-
-	  complex double w, wA, wB;
-	  Symmetry SA, SB;
-	  for (IB=0; IB<NB; IB++) {
-	    SB = MBB->symmetry(MBB, IB);
-	    wB = MBB->weight(MBB, IB, iB);
-	    for (IA=0; IA<NA; IA++) {
-	      SA = MBA->symmetry(MBA, IA);
-	      wA = MBA->weight(MBA, IA, iA);
-	      for (pi=0; pi<=1; pi++)
-		for (p=0; p<=1; p++)
-		  for (j=odd; j<jmax; j=j+2)
-		    for (k=-j; k<=j; k=k+2)
-		      for (m=-j; m<=j; m=m+2) {
-			if ((Op->rank != 0 || SymmetryAllowed(SA, p, j, m)) &&
-			    SymmetryAllowed(SB, p, j, k)) {
-			  w = conj(wA)*wB*	 
-			    weight[processor] * (p && pi%2 ? -1 : 1)*
-			    (j+1)/(8*SQR(M_PI))*Djmkstar(j,m,k,angle[processor][0],angle[processor][1],angle[processor][2]);
-			  for (l=0; l<dim; l++)
-			    for (r=0; r<=rank; r++)
-			      val[IA+IB*NA][idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] += w*sval[pi][r+l*(rank+1)];
-		    }	
+      integrateprojectedMBMEmpi(&pp, &Q, &Qp, Op->me, Op->par, kval);
+
+      complex double w, wA, wB, wh, whA, whB;
+      complex double* kpj;
+      Symmetry SA, SB;
+      for (IB=0; IB<NB; IB++) {
+	SB = MBB->symmetry(MBB, IB);
+	wB = MBB->weight(MBB, IB, iB);
+	whB = MBB->weight(MBB, IB, iA);
+	for (IA=0; IA<NA; IA++) {
+	  SA = MBA->symmetry(MBA, IA);
+	  wA = MBA->weight(MBA, IA, iA);
+	  whA = MBA->weight(MBA, IA, iB);
+	  w = conj(wA)*wB;
+	  wh = conj(whA)*whB;
+	  kpj = kval;
+	  for (p=0; p<=1; p++)
+	    for (j=odd; j<jmax; j=j+2) {
+	      for (k=-j; k<=j; k=k+2)
+		for (m=-j; m<=j; m=m+2) {
+		  if ((Op->rank != 0 || SymmetryAllowed(SA, p, j, m)) &&
+		      SymmetryAllowed(SB, p, j, k)) {
+		    for (l=0; l<dim; l++)
+		      for (r=0; r<=rank; r++)
+			val[IA+IB*NA][idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] += w*kpj[r+l*(rank+1)+idxjmk(j,m,k)*(rank+1)*size];
+		    // contribution of pair iB, iA by hermiticity
+		    if (herm && iA != iB)
+		      for (l=0; l<dim; l++)
+			for (r=0; r<=rank; r++)
+			  val[IA+IB*NA][idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] += wh*conj(kpj[r+l*(rank+1)+idxjmk(j,k,m)*(rank+1)*size]);
 		  }
-	      }
+		}
+	      kpj += SQR(j+1)*(rank+1)*size;
 	    }
-
-	  working[processor] = 0;
-	  running--;
-	  done++;
 	}
       }
 
-      // tell slaves we have finished
-      projpar[0] = -1.0;
-      for (processor=1; processor<mpisize; processor++) {
-	MPI_Send(projpar, 6, MPI_DOUBLE, processor, TAGPROJECT6, MPI_COMM_WORLD);
-      }
-
-      freeAngintegration(&angpara);
-      freecmintegration(&cmpara);
-
     }
   }
 
-}	
+  free(kval);
+}
@@ -20,6 +20,7 @@
 #include "fmd/Observables.h"
 
 #include "Communication.h"
+#include "Projectionmpi.h"
 #include "ProjectionSlave.h"
 
 
@@ -27,12 +28,9 @@
 
 void ProjectionSlave(void)
 {
-  MPI_Status status;
-
   Interaction Int;
   int A;
-  SlaterDet Q, Qp, Qpp;
-  SlaterDetAux X;
+  SlaterDet Q, Qp;
 
   int task;
 
@@ -45,8 +43,6 @@ void ProjectionSlave(void)
 
   allocateSlaterDet(&Q, A);
   allocateSlaterDet(&Qp, A);
-  allocateSlaterDet(&Qpp, A);
-  allocateSlaterDetAux(&X, A);
 
   while (1) {
 
@@ -55,57 +51,17 @@ void ProjectionSlave(void)
 	task != TASKPROJECTOBSERVABLESOD)
       return;
 
-    double projpar[6];
-    double *angle, *R;
-
     BroadcastSlaterDet(&Q);
     BroadcastSlaterDet(&Qp);
 
-    while (1) {
-
-      MPI_Recv(projpar, 6, MPI_DOUBLE, 0, TAGPROJECT6, MPI_COMM_WORLD, &status);
-      if (projpar[0] < 0.0)
-	break;
-	
-      angle = &projpar[0];
-      R = &projpar[3];
-
-      copySlaterDet(&Qp, &Qpp);
-
-      moveSlaterDet(&Qpp, R);
-      rotateSlaterDet(&Qpp, angle[0], angle[1], angle[2]);
-
-      if (task == TASKPROJECTOVLAPOD) {
-	complex double ovl[2];
-
-	calcSlaterDetAuxod(&Q, &Qpp, &X);
-	ovl[0] = X.ovlap;
-
-	invertSlaterDet(&Qpp);
-
-	calcSlaterDetAuxod(&Q, &Qpp, &X); 
-	ovl[1] = X.ovlap;
-
-	MPI_Send(ovl, 2*sizeof(complex double), MPI_BYTE, 
-		 0, TAGMEOD, MPI_COMM_WORLD);
-      }
-
-      if (task == TASKPROJECTOBSERVABLESOD) {
-	Observablesod obs[2];
-
-	calcSlaterDetAuxod(&Q, &Qpp, &X); 
-	calcObservablesod(&Int, &Q, &Qpp, &X, &obs[0]);
-
-	invertSlaterDet(&Qpp);
-
-	calcSlaterDetAuxod(&Q, &Qpp, &X); 
-	calcObservablesod(&Int, &Q, &Qpp, &X, &obs[1]);
-
-	MPI_Send(obs, 2*sizeof(Observablesod), MPI_BYTE, 
-		 0, TAGMEOD, MPI_COMM_WORLD);
-      }
+    // integrate over our share of the integration points
+    if (task == TASKPROJECTOVLAPOD)
+      integrateprojectedMBMEmpi(NULL, &Q, &Qp, 
+				calcOvlapod, NULL, NULL);
 
-    }	
+    if (task == TASKPROJECTOBSERVABLESOD)
+      integrateprojectedMBMEmpi(NULL, &Q, &Qp, 
+				(projectionmpikernel) calcObservablesod, &Int, NULL);
 
   }
 
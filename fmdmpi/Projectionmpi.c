@@ -29,6 +29,7 @@
 
 #include "misc/physics.h"
 #include "misc/utils.h"
+#include "misc/profile.h"
 
 #include "Communication.h"
 #include "Projectionmpi.h"
@@ -37,11 +38,215 @@
 #define SQR(x) (x)*(x)
 
 
+static inline double dmin(double a, double b)
+{
+  return (a < b ? a : b);
+}
+
+
+int projectedMBMEsizempi(const projectionmpipara* pp)
+{
+  int jmax = pp->P.jmax;
+  int odd = pp->P.odd;
+  int o, p, j;
+
+  int n=0;
+  for (o=0; o<pp->n; o++)
+    for (p=0; p<=1; p++)
+      for (j=odd; j<jmax; j=j+2)
+	n += SQR(j+1)*(pp->rank[o]+1)*pp->size;
+
+  return n;
+}
+
+
+void integrateprojectedMBMEmpi(const projectionmpipara* ppara,
+			       const SlaterDet* Q, const SlaterDet* Qp,
+			       projectionmpikernel me, void* mepar,
+			       complex double* mbme)
+{
+  projectionmpipara pp;
+  if (mpirank == 0)
+    pp = *ppara;
+  BroadcastParameters(&pp, sizeof(projectionmpipara));
+
+  const Projection* P = &pp.P;
+  int jmax = P->jmax;
+  int odd = P->odd;
+  int dim = pp.dim;
+  int size = pp.size;
+  int* ranko = pp.rank;
+
+  int l, r;
+  int o, p, j, m, k;
+
+  // offsets of operators in unprojected matrix elements
+  int sizeo[pp.n], io[pp.n];
+  int no=0;
+  for (o=0; o<pp.n; o++) {
+    sizeo[o] = size*(ranko[o]+1);
+    io[o] = no;
+    no += sizeo[o];
+  }
+
+  // offsets of operators and p, j blocks in projected matrix elements
+  int ipjo[pp.n][jmax+1];
+  int nme=0;
+  for (o=0; o<pp.n; o++)
+    for (p=0; p<=1; p++)
+      for (j=odd; j<jmax; j=j+2) {
+	ipjo[o][idxpij(jmax,p,j)] = nme;
+	nme += SQR(j+1)*sizeo[o];
+      }
+
+  // slaves accumulate into their own buffer
+  complex double* val = (mpirank == 0) ? mbme : malloc(nme*sizeof(complex double));
+  for (l=0; l<nme; l++)
+    val[l] = 0.0;
+
+  // all processes set up the same integration grids
+  cmintegrationpara cmpara;
+  _initcmintegration(P, pp.cmalpha, &cmpara);
+  int ncm = cmpara.n;
+
+  angintegrationpara angpara;
+  _initangintegration(P, pp.kappa, pp.S, pp.Sp, &angpara);
+  int nang = angpara.n;
+  const angDtable* Dtab = getangDtable(&angpara, jmax);
+
+  // only one point of each pair of inverse rotations, see calcprojectedMBME
+  int herm = pp.herm && angHermitian(&angpara);
+
+  // integration points are dealt round-robin, so that the points
+  // skipped for hermitian kernels are spread over all processes
+  int todo = nang*ncm;
+
+  // Qp rotated and its parity image, calculated together
+  SlaterDet Qpp[2];
+  SlaterDetAux X[2];
+  allocateSlaterDet(&Qpp[0], Qp->A);
+  allocateSlaterDet(&Qpp[1], Qp->A);
+  allocateSlaterDetAux(&X[0], Q->A > Qp->A ? Q->A : Qp->A);
+  allocateSlaterDetAux(&X[1], Q->A > Qp->A ? Q->A : Qp->A);
+
+  // Gaussian pair auxiliaries not changing over the integration points
+  SlaterDetAuxinv Y;
+  int compatible = (Q->A == Qp->A && Q->Z == Qp->Z && Q->N == Qp->N);
+  if (compatible)
+    initSlaterDetAuxinv(Q, Qp, &Y);
+
+  complex double sval[no];
+  complex double w;
+  double xcm[3], weightcm;
+  double alpha, beta, gamma, weightang;
+  double weight;
+  int i, iang, ip;
+
+  for (i=mpirank; i<todo; i+=mpisize) {
+    iang = i%nang;
+
+    if (herm && angpara.inv[iang] < iang)
+      continue;
+
+    getcmintegrationpoint(i/nang, &cmpara, xcm, &weightcm);
+    getangintegrationpoint(iang, &angpara, &alpha, &beta, &gamma, &weightang);
+    weight = 0.5*weightcm*weightang;
+    if (herm)
+      weight *= angHermitianweight(&angpara, iang);
+
+    copySlaterDet(Qp, &Qpp[0]);
+    moveSlaterDet(&Qpp[0], xcm);
+    rotateSlaterDet(&Qpp[0], alpha, beta, gamma);
+    copySlaterDet(&Qpp[0], &Qpp[1]);
+    invertSlaterDet(&Qpp[1]);
+
+    // Auxiliaries only for compatible SlaterDets
+    if (compatible)
+      calcSlaterDetAuxodinvparity(Q, &Qpp[0], &Y, &X[0], &X[1]);
+
+    for (ip=0; ip<=1; ip++) {
+      me(mepar, Q, &Qpp[ip], &X[ip], sval);
+
+      for (o=0; o<pp.n; o++)
+	for (p=0; p<=1; p++)
+	  for (j=odd; j<jmax; j=j+2)
+	    for (k=-j; k<=j; k=k+2)
+	      for (m=-j; m<=j; m=m+2) {
+		if (!pp.symsel ||
+		    ((ranko[o] != 0 || SymmetryAllowed(pp.S, p, j, m)) &&
+		     SymmetryAllowed(pp.Sp, p, j, k))) {
+		  w = weight * (p && ip%2 ? -1 : 1)*
+		    (j+1)/(8*SQR(M_PI))*angDstar(Dtab,iang,j,m,k);
+		  for (l=0; l<dim; l++)
+		    for (r=0; r<=ranko[o]; r++)
+		      val[ipjo[o][idxpij(jmax,p,j)]+r+l*(ranko[o]+1)+idxjmk(j,m,k)*sizeo[o]] += w*sval[r+l*(ranko[o]+1)+io[o]];
+		}
+	      }
+    }
+  }
+
+  if (compatible)
+    freeSlaterDetAuxinv(&Y);
+  freeSlaterDetAux(&X[0]);
+  freeSlaterDetAux(&X[1]);
+  freeSlaterDet(&Qpp[0]);
+  freeSlaterDet(&Qpp[1]);
+  freeAngintegration(&angpara);
+  freecmintegration(&cmpara);
+
+  // sum up contributions of all processes
+  PROFILEBEGIN("mpi reduce")
+  if (mpirank == 0) {
+    MPI_Reduce(MPI_IN_PLACE, val, nme, MPI_DOUBLE_COMPLEX, MPI_SUM, 0, MPI_COMM_WORLD);
+  } else {
+    MPI_Reduce(val, NULL, nme, MPI_DOUBLE_COMPLEX, MPI_SUM, 0, MPI_COMM_WORLD);
+    free(val);
+  }
+  PROFILEEND
+
+  // contributions of the inverse rotations, scalar operators only
+  if (herm && mpirank == 0)
+    for (o=0; o<pp.n; o++)
+      for (p=0; p<=1; p++)
+	for (j=odd; j<jmax; j=j+2)
+	  for (k=-j; k<=j; k=k+2)
+	    for (m=-j; m<=k; m=m+2)
+	      for (l=0; l<dim; l++)
+		angHermitianpair(&val[ipjo[o][idxpij(jmax,p,j)]+l+idxjmk(j,m,k)*sizeo[o]],
+				 &val[ipjo[o][idxpij(jmax,p,j)]+l+idxjmk(j,k,m)*sizeo[o]]);
+}
+
+
+static void initprojectionmpipara(const Projection* P,
+				  const SlaterDet* Q, const SlaterDet* Qp,
+				  Symmetry S, Symmetry Sp,
+				  projectionmpipara* pp)
+{
+  pp->P = *P;
+  pp->S = S; pp->Sp = Sp;
+  pp->symsel = 1;
+  pp->herm = 0;
+
+  // see initangintegration, initcmintegration
+  pp->kappa = 0.0;
+  if (P->ang == AngProdA) {
+    pp->kappa = dmin(_estimateangkappa(Q), _estimateangkappa(Qp));
+    fprintf(stderr, "kappa: %8.3f\n", pp->kappa);
+  }
+  pp->cmalpha = 0.5/(_estimateacm(Q)+_estimateacm(Qp));
+}
+
+
 void calcprojectedMBMEmpi(const Projection* P, const ManyBodyOperator* Op,
 			  const SlaterDet* Q, const SlaterDet* Qp,
 			  Symmetry S, Symmetry Sp,
 			  void* mbme)
 {
+  if (P->ang == AngAdapt) {
+    fprintf(stderr, "No parallelized adaptive angular integration yet !\n");
+    exit(127);
+  }
+
   // only implemented for some operators
 
   if (!strncmp(Op->name, "Ovlap", 5)) {
@@ -50,7 +255,7 @@ void calcprojectedMBMEmpi(const Projection* P, const ManyBodyOperator* Op,
   } else if (!strncmp(Op->name, "Observables-", 12)) {
     int task = TASKPROJECTOBSERVABLESOD;
     BroadcastTask(&task);
-  } else if (!strncmp(Op->name, "EMonopoleFormfactor-", 20)) {
+  } else if (!strncmp(Op->name, "EMonopoleFormfactors-", 21)) {
     int task = TASKPROJECTMONOPOLEFORMFACTOROD;
     BroadcastTask(&task);
   } else if (!strncmp(Op->name, "DiagonalDensityMatrixHO-", 24)) {
@@ -61,137 +266,39 @@ void calcprojectedMBMEmpi(const Projection* P, const ManyBodyOperator* Op,
     exit(127);
   }
 
-  int size=Op->size;
-  int dim=Op->dim;
-  int rank=Op->rank;
-  complex double (**val)[(rank+1)*size] = mbme;
-
-  SlaterDetAux  X;
+  complex double** val = mbme;
 
   int jmax = P->jmax;
   int odd = P->odd;
+  int p, j;
 
-  // norms of SlaterDets
-  //initSlaterDetAux(Q, &X);
-  // calcSlaterDetAuxod(Q, Q, &X);
-  // double norm = sqrt(creal(X.ovlap));
-  
-  //initSlaterDetAux(Qp, &X);
-  //calcSlaterDetAuxod(Qp, Qp, &X);
-  // double normp = sqrt(creal(X.ovlap));  
-
-  // set up cm integration
-  cmintegrationpara cmpara;
-  initcmintegration(P, Q, Qp, &cmpara);
-  int ncm = cmpara.n;
-
-  // set up angular momentum integration
-  angintegrationpara angpara;
-  initangintegration(P, Q, Qp, S, Sp, &angpara);
-  int nang = angpara.n;
-
-  int l, r;
-  int p, j, m, k;
+  projectionmpipara pp;
+  initprojectionmpipara(P, Q, Qp, S, Sp, &pp);
+  pp.n = 1;
+  pp.dim = Op->dim;
+  pp.size = Op->size;
+  pp.rank[0] = Op->rank;
 
-  // set matrix elements to zero
-  for (p=0; p<=1; p++)
-    for (j=odd; j<jmax; j=j+2) {
-      for (k=-j; k<=j; k=k+2)
-	for (m=-j; m<=j; m=m+2)
-	  for (l=0; l<dim; l++)
-	    for (r=0; r<=rank; r++)
-	      val[idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] = 0.0;
-    }	
+  // -H is only known to process 0, the slaves get it with pp
+  pp.herm = (S == Sp && usingHermiticity(Op) &&
+	     (P->cm == CMNone || P->cm == CMSimple) && sameSlaterDet(Q, Qp));
 
   BroadcastSlaterDet(Q);
   BroadcastSlaterDet(Qp);
 
-  // loop over all the orientations
-  complex double w;
-  int pi;
+  complex double* me = malloc(projectedMBMEsizempi(&pp)*sizeof(complex double));
 
-  int todo = nang*ncm;
-  int running=0;
-  int done=0;
-  int processor;
-  MPI_Status status;
-
-  // processor 0 is master
-  double pos[mpisize][3];
-  double angle[mpisize][3];
-  double weight[mpisize];
-  double projpar[6];
-  
-  // which slaves are working, at beginning none
-  int i;
-  int working[mpisize];
-  for (i=1; i<mpisize; i++)
-    working[i] = 0;
-
-  double weightang, weightcm;
-  complex double sval[2][(rank+1)*size];
-
-  int next=0;
-  while (done<todo) {
-
-    if (next<todo && running < mpisize-1) {	// supply slaves with work
-
-      // find empty slave
-      for (i=1; i<mpisize; i++)
-	if (!working[i]) {
-	  processor = i;
-	  break;
-	}
-
-      getcmintegrationpoint(next/nang, &cmpara, pos[processor], &weightcm);
-      getangintegrationpoint(next%nang, &angpara, &angle[processor][0], &angle[processor][1], &angle[processor][2], &weightang); 
-
-      //  weight[processor] = 1.0/(2*norm*normp)*weightcm*weightang;
-        weight[processor] = 0.5*weightcm*weightang;
-      
-      for (i=0; i<3; i++) projpar[i] = angle[processor][i];
-      for (i=0; i<3; i++) projpar[i+3] = pos[processor][i];
-
-      MPI_Send(projpar, 6, MPI_DOUBLE, processor, TAGPROJECT6, MPI_COMM_WORLD);
-
-      working[processor] = 1;
-      running++;
-      next++;
-	
-    } else {					// collect results from slaves
-
-      MPI_Recv(sval, 2*(rank+1)*size, MPI_DOUBLE_COMPLEX, 
-	       MPI_ANY_SOURCE, TAGMEOD, MPI_COMM_WORLD, &status);
-      processor = status.MPI_SOURCE;
-
-      for (pi=0; pi<=1; pi++)
-	for (p=0; p<=1; p++)
-	  for (j=odd; j<jmax; j=j+2)
-	    for (k=-j; k<=j; k=k+2)
-	      for (m=-j; m<=j; m=m+2) {
-		if ((Op-rank !=0 || SymmetryAllowed(S, p, j, m)) &&
-		    SymmetryAllowed(Sp, p, j, k)) {
-		  w = weight[processor] * (p && pi%2 ? -1 : 1)*
-		    (j+1)/(8*SQR(M_PI))*Djmkstar(j,m,k,angle[processor][0],angle[processor][1],angle[processor][2]);
-		  for (l=0; l<dim; l++)
-		    for (r=0; r<=rank; r++)
-		      val[idxpij(jmax,p,j)][idxjmk(j,m,k)][r+l*(rank+1)] += w*sval[pi][r+l*(rank+1)];
-		}
-	      }	
+  integrateprojectedMBMEmpi(&pp, Q, Qp, Op->me, Op->par, me);
 
-      working[processor] = 0;
-      running--;
-      done++;
+  int nme=0;
+  for (p=0; p<=1; p++)
+    for (j=odd; j<jmax; j=j+2) {
+      memcpy(val[idxpij(jmax,p,j)], me+nme, 
+	     SQR(j+1)*(Op->rank+1)*Op->size*sizeof(complex double));
+      nme += SQR(j+1)*(Op->rank+1)*Op->size;
     }
 
-  }
-
-  // tell slaves we have finished
-  projpar[0] = -1.0;
-  for (processor=1; processor<mpisize; processor++) {
-    MPI_Send(projpar, 6, MPI_DOUBLE, processor, TAGPROJECT6, MPI_COMM_WORLD);
-  }
-
+  free(me);
 }	
 
 
@@ -200,6 +307,11 @@ void calcprojectedMBMEsmpi(const Projection* P, const ManyBodyOperators* Ops,
 			   Symmetry S, Symmetry Sp,
 			   void* mbme)
 {
+  if (P->ang == AngAdapt) {
+    fprintf(stderr, "No parallelized adaptive angular integration yet !\n");
+    exit(127);
+  }
+
   // only implemented for some operators
 
   if (!strncmp(Ops->name, "OneNucleonOvlaps-", 17)) {
@@ -216,155 +328,40 @@ void calcprojectedMBMEsmpi(const Projection* P, const ManyBodyOperators* Ops,
     exit(127);
   }
 
-  int size=Ops->size;
-  int dim=Ops->dim;
   complex double ***val = mbme;
 
-  SlaterDetAux  X;
-
   int jmax = P->jmax;
   int odd = P->odd;
+  int o, p, j;
 
-  // norms of SlaterDets
-  // initSlaterDetAux(Q, &X);
-  // calcSlaterDetAuxod(Q, Q, &X);
-  // double norm = sqrt(creal(X.ovlap));
-  
-  // initSlaterDetAux(Qp, &X);
-  //  calcSlaterDetAuxod(Qp, Qp, &X);
-  //  double normp = sqrt(creal(X.ovlap));  
-
-  // set up cm integration
-  cmintegrationpara cmpara;
-  initcmintegration(P, Q, Qp, &cmpara);
-  int ncm = cmpara.n;
-
-  // set up angular momentum integration
-  angintegrationpara angpara;
-  initangintegration(P, Q, Qp, S, Sp, &angpara);
-  int nang = angpara.n;
-
-  int l, r;
-  int o, p, j, m, k;
-
-  // helpful for indexing matrix elements
+  if (Ops->n > MAXOPSMPI) {
+    fprintf(stderr, "too many operators in %s\n", Ops->name);
+    exit(127);
+  }
 
-  int ranko[Ops->n];
+  projectionmpipara pp;
+  initprojectionmpipara(P, Q, Qp, S, Sp, &pp);
+  pp.n = Ops->n;
+  pp.dim = Ops->dim;
+  pp.size = Ops->size;
   for (o=0; o<Ops->n; o++)
-    ranko[o] = Ops->Op[o].rank;
+    pp.rank[o] = Ops->Op[o].rank;
 
-  int sizeo[Ops->n];
-  for (o=0; o<Ops->n; o++)
-    sizeo[o] = size*(ranko[o]+1);
-
-  int io[Ops->n]; io[0] = 0;
-  for (o=0; o<Ops->n-1; o++)
-    io[o+1] = io[o]+sizeo[o];
+  BroadcastSlaterDet(Q);
+  BroadcastSlaterDet(Qp);
 
-  int no=0;
-  for (o=0; o<Ops->n; o++)
-    no += sizeo[o];
+  complex double* me = malloc(projectedMBMEsizempi(&pp)*sizeof(complex double));
 
+  integrateprojectedMBMEmpi(&pp, Q, Qp, (projectionmpikernel) Ops->me, Ops->par, me);
 
-  // set matrix elements to zero
+  int nme=0;
   for (o=0; o<Ops->n; o++)
     for (p=0; p<=1; p++)
       for (j=odd; j<jmax; j=j+2) {
-	for (k=-j; k<=j; k=k+2)
-	  for (m=-j; m<=j; m=m+2)
-	    for (l=0; l<dim; l++)
-	      for (r=0; r<=ranko[o]; r++)
-		val[o][idxpij(jmax,p,j)][r+l*(ranko[o]+1)+idxjmk(j,m,k)*sizeo[o]] = 0.0;
-    }	
-
-  BroadcastSlaterDet(Q);
-  BroadcastSlaterDet(Qp);
-
-  // loop over all the orientations
-  complex double w;
-  int pi;
-
-  int todo = nang*ncm;
-  int running=0;
-  int done=0;
-  int processor;
-  MPI_Status status;
-
-  // processor 0 is master
-  double pos[mpisize][3];
-  double angle[mpisize][3];
-  double weight[mpisize];
-  double projpar[6];
-  
-  // which slaves are working, at beginning none
-  int i;
-  int working[mpisize];
-  for (i=1; i<mpisize; i++)
-    working[i] = 0;
-
-  double weightang, weightcm;
-  complex double sval[2][no];
-
-  int next=0;
-  while (done<todo) {
-
-    if (next<todo && running < mpisize-1) {	// supply slaves with work
-
-      // find empty slave
-      for (i=1; i<mpisize; i++)
-	if (!working[i]) {
-	  processor = i;
-	  break;
-	}
-
-      getcmintegrationpoint(next/nang, &cmpara, pos[processor], &weightcm);
-      getangintegrationpoint(next%nang, &angpara, &angle[processor][0], &angle[processor][1], &angle[processor][2], &weightang); 
-
-    //  weight[processor] = 1.0/(2*norm*normp)*weightcm*weightang;
-         weight[processor] = 0.5*weightcm*weightang;
-      
-      for (i=0; i<3; i++) projpar[i] = angle[processor][i];
-      for (i=0; i<3; i++) projpar[i+3] = pos[processor][i];
-
-      MPI_Send(projpar, 6, MPI_DOUBLE, processor, TAGPROJECT6, MPI_COMM_WORLD);
-
-      working[processor] = 1;
-      running++;
-      next++;
-	
-    } else {					// collect results from slaves
-
-      MPI_Recv(sval, 2*no, MPI_DOUBLE_COMPLEX, 
-	       MPI_ANY_SOURCE, TAGMEOD, MPI_COMM_WORLD, &status);
-      processor = status.MPI_SOURCE;
-
-      for (pi=0; pi<=1; pi++)
-	for (o=0; o<Ops->n; o++)
-	  for (p=0; p<=1; p++)
-	    for (j=odd; j<jmax; j=j+2)
-	      for (k=-j; k<=j; k=k+2)
-		for (m=-j; m<=j; m=m+2) {
-		  if ((ranko[o] !=0 || SymmetryAllowed(S, p, j, m)) &&
-		      SymmetryAllowed(Sp, p, j, k)) {
-		    w = weight[processor] * (p && pi%2 ? -1 : 1)*
-		      (j+1)/(8*SQR(M_PI))*Djmkstar(j,m,k,angle[processor][0],angle[processor][1],angle[processor][2]);
-		    for (l=0; l<dim; l++)
-		      for (r=0; r<=ranko[o]; r++)
-			val[o][idxpij(jmax,p,j)][r+l*(ranko[o]+1)+idxjmk(j,m,k)*sizeo[o]] += w*sval[pi][r+l*(ranko[o]+1)+io[o]];
-		  }
-		}	
-
-      working[processor] = 0;
-      running--;
-      done++;
-    }
-
-  }
-
-  // tell slaves we have finished
-  projpar[0] = -1.0;
-  for (processor=1; processor<mpisize; processor++) {
-    MPI_Send(projpar, 6, MPI_DOUBLE, processor, TAGPROJECT6, MPI_COMM_WORLD);
-  }
+	memcpy(val[o][idxpij(jmax,p,j)], me+nme, 
+	       SQR(j+1)*(pp.rank[o]+1)*pp.size*sizeof(complex double));
+	nme += SQR(j+1)*(pp.rank[o]+1)*pp.size;
+      }
 
+  free(me);
 }	
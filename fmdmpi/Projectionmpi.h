@@ -20,6 +20,41 @@
 #include "fmd/Symmetry.h"
 
 
+#define MAXOPSMPI 16
+
+/// parameters of the projection integral, broadcast to all processes
+typedef struct {
+  Projection P;
+  Symmetry S, Sp;	///< symmetries used for the integration grid
+  int symsel;		///< select matrix elements allowed by S, Sp
+  int herm;		///< hermitian scalar diagonal kernel, half angular grid
+  double kappa;		///< for angular integration
+  double cmalpha;	///< for cm integration
+  int n;		///< number of operators
+  int dim, size;
+  int rank[MAXOPSMPI];
+} projectionmpipara;
+
+/// evaluates unprojected matrix elements of all operators
+typedef void (*projectionmpikernel)(void* par,
+				    const SlaterDet* Q, const SlaterDet* Qp,
+				    const SlaterDetAux* X,
+				    complex double* val);
+
+/// number of projected matrix elements of all operators
+int projectedMBMEsizempi(const projectionmpipara* pp);
+
+/// every process integrates over every mpisize-th integration point,
+/// the sum is collected in mbme on process 0
+/// parameters pp are broadcast from process 0, slaves pass NULL for pp
+/// matrix elements are stored operator by operator, for each p, j
+/// in the same layout as used by initprojectedMBME
+void integrateprojectedMBMEmpi(const projectionmpipara* pp,
+			       const SlaterDet* Q, const SlaterDet* Qp,
+			       projectionmpikernel me, void* mepar,
+			       complex double* mbme);
+
+
 void calcprojectedMBMEmpi(const Projection* P, const ManyBodyOperator* Op,
 			  const SlaterDet* Q, const SlaterDet* Qp,
 			  Symmetry S, Symmetry Sp,
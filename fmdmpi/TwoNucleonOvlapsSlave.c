@@ -18,6 +18,7 @@
 #include "fmd/TwoNucleonOvlaps.h"
 
 #include "Communication.h"
+#include "Projectionmpi.h"
 #include "TwoNucleonOvlapsSlave.h"
 
 #define MAX(x,y) ((x) > (y) ? (x) : (y))
@@ -33,11 +34,9 @@ void BroadcastTwoNucleonOvlapsPara(TwoNucleonOvlapsPara* TNOpar)
 
 void TwoNucleonOvlapsSlave(void)
 {
-  MPI_Status status;
-
   TwoNucleonOvlapsPara TNOpar;
   int A;
-  SlaterDet Q, Qp, Qpp;
+  SlaterDet Q, Qp;
 
   int task;
 
@@ -46,14 +45,10 @@ void TwoNucleonOvlapsSlave(void)
     return;
 
   BroadcastTwoNucleonOvlapsPara(&TNOpar);
-  int dim = MAX(DIMSPECT,DIMSPECY)* SQR(TNOpar.npoints);
   BroadcastA(&A);
 
-  complex double specamp[2][dim];
-
   allocateSlaterDet(&Q, A-2);
   allocateSlaterDet(&Qp, A);
-  allocateSlaterDet(&Qpp, A);
 
   while (1) {
 
@@ -62,41 +57,15 @@ void TwoNucleonOvlapsSlave(void)
 	task != TASKPROJECTTWONUCLEONOVLAPSYOD)
       return;
 
-    double projpar[6];
-    double *angle, *R;
-
     BroadcastSlaterDet(&Q);
     BroadcastSlaterDet(&Qp);
 
-    while (1) {
-
-      MPI_Recv(projpar, 6, MPI_DOUBLE, 0, TAGPROJECT6, MPI_COMM_WORLD, &status);
-      if (projpar[0] < 0.0)
-	break;
-	
-      angle = &projpar[0];
-      R = &projpar[3];
-      
-      copySlaterDet(&Qp, &Qpp);
-      moveSlaterDet(&Qpp, R);
-      
-      rotateSlaterDet(&Qpp, angle[0], angle[1], angle[2]);
-
-      if (task == TASKPROJECTTWONUCLEONOVLAPSTOD)
-	calcTwoNucleonOvlapsTod(&TNOpar, &Q, &Qpp, NULL, specamp[0]);
-      else if (task == TASKPROJECTTWONUCLEONOVLAPSYOD)
-	calcTwoNucleonOvlapsYod(&TNOpar, &Q, &Qpp, NULL, specamp[0]);
-
-      invertSlaterDet(&Qpp);
-
-      if (task == TASKPROJECTTWONUCLEONOVLAPSTOD)
-	calcTwoNucleonOvlapsTod(&TNOpar, &Q, &Qpp, NULL, specamp[1]);
-      else if (task == TASKPROJECTTWONUCLEONOVLAPSYOD)
-	calcTwoNucleonOvlapsYod(&TNOpar, &Q, &Qpp, NULL, specamp[1]);
-
-      MPI_Send(specamp, 2*dim*sizeof(complex double), MPI_BYTE, 
-	       0, TAGMEOD, MPI_COMM_WORLD);
-    }	
+    if (task == TASKPROJECTTWONUCLEONOVLAPSTOD)
+      integrateprojectedMBMEmpi(NULL, &Q, &Qp, 
+				(projectionmpikernel) calcTwoNucleonOvlapsTod, &TNOpar, NULL);
+    else if (task == TASKPROJECTTWONUCLEONOVLAPSYOD)
+      integrateprojectedMBMEmpi(NULL, &Q, &Qp, 
+				(projectionmpikernel) calcTwoNucleonOvlapsYod, &TNOpar, NULL);
 
   }
 
@@ -17,6 +17,7 @@
 #include "fmd/gradGaussian.h"
 #include "fmd/gradKineticEnergy.h"
 #include "fmd/gradCenterofMass.h"
+#include "fmd/gradPotential.h"
 
 #include "Communication.h"
 #include "gradHamiltonianmpi.h"
@@ -55,87 +56,99 @@ void calcgradHamiltonianodmpi(const Interaction *P,
 
 #define SQR(x) ((x)*(x))
 
-void calcgradPotentialmpi(const Interaction *P,
-                          const SlaterDet* Q, const SlaterDetAux* X, 
-                          const gradSlaterDetAux* dX,
-                          gradSlaterDet* dv)
+// every rank calculates a fixed share of the pairs k,l,
+// results are summed over all ranks and added to dv
+
+void calcgradPotentialmpiblock(const Interaction *P,
+			       const SlaterDet* Q, const SlaterDetAux* X, 
+			       const gradSlaterDetAux* dX,
+			       gradSlaterDet* dv)
 {
-  int task = TASKGRADPOTENTIAL;
   int i;
   int A=Q->A;
-  int todo=A*A;
   int ngauss=Q->ngauss;
-  int k[2]={0,0}; 
-  int done=0; int rank;
-  gradSlaterDet dvrowcol;
-  MPI_Status status;
-  
+  int k,l;
+  gradSlaterDet dvrowcol, dvsum;
+
   allocategradSlaterDet(&dvrowcol, A);
+  initgradSlaterDet(Q, &dvsum);
+
+  for (k=0; k<A; k++)
+    for (l=0; l<A; l++)
+      if ((l+k*A) % mpisize == mpirank) {
+	calcgradPotentialrowcol(P, Q, X, dX, &dvrowcol, k, l);
+	dvsum.val += dvrowcol.val;
+	for (i=0; i<ngauss; i++)
+	  addmulttogradGaussian(&dvsum.gradval[i], &dvrowcol.gradval[i], 1.0);
+      }
+
+  MPI_Allreduce(MPI_IN_PLACE, &dvsum.val, 1, MPI_DOUBLE_COMPLEX, MPI_SUM, 
+		MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, dvsum.gradval, 
+		ngauss*sizeof(gradGaussian)/sizeof(complex double), 
+		MPI_DOUBLE_COMPLEX, MPI_SUM, MPI_COMM_WORLD);
+
+  dv->val += dvsum.val;
+  for (i=0; i<ngauss; i++)
+    addmulttogradGaussian(&dv->gradval[i], &dvsum.gradval[i], 1.0);
+
+  freegradSlaterDet(&dvrowcol);
+  freegradSlaterDet(&dvsum);
+}
+
 
+void calcgradPotentialmpi(const Interaction *P,
+                          const SlaterDet* Q, const SlaterDetAux* X, 
+                          const gradSlaterDetAux* dX,
+                          gradSlaterDet* dv)
+{
+  int task = TASKGRADPOTENTIAL;
   BroadcastTask(&task);
+
   BroadcastSlaterDet(Q);
   // BroadcastSlaterDetAux(Q, X);
   // BroadcastgradSlaterDetAux(Q, dX);
 
-  // supply slaves with work
-  for (rank=1; rank<mpisize; rank++) {
-
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-    k[1]++;
-    if (k[1] == A) {
-      k[0]++; k[1]=0;
-    }
-  }
-
-  while (1) {
-    MPI_Recv(&dvrowcol.val, 1, MPI_DOUBLE_COMPLEX, MPI_ANY_SOURCE, 
-	     TAGGRADPOTENTIALVAL,
-             MPI_COMM_WORLD, &status);
-    MPI_Recv(dvrowcol.gradval, ngauss*sizeof(gradGaussian), 
-             MPI_BYTE, MPI_ANY_SOURCE, TAGGRADPOTENTIALGRAD, 
-             MPI_COMM_WORLD, &status); 
-    rank = status.MPI_SOURCE;
-
-    dv->val += dvrowcol.val;
-    for (i=0; i<ngauss; i++)
-      addmulttogradGaussian(&dv->gradval[i], &dvrowcol.gradval[i], 1.0);
-
-    done++;
-
-    // all work distributed ?
-    if (k[0] == A)
-      break;
-
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-
-    k[1]++;
-    if (k[1] == A) {
-      k[0]++; k[1]=0;
-    }
-  }
-
-  // collect remaining results
-  while (done<todo) {
-    MPI_Recv(&dvrowcol.val, 1, MPI_DOUBLE_COMPLEX, MPI_ANY_SOURCE, 
-	     TAGGRADPOTENTIALVAL,
-             MPI_COMM_WORLD, &status);
-    MPI_Recv(dvrowcol.gradval, ngauss*sizeof(gradGaussian), 
-             MPI_BYTE, MPI_ANY_SOURCE, TAGGRADPOTENTIALGRAD, 
-             MPI_COMM_WORLD, &status); 
-
-    dv->val += dvrowcol.val;
-    for (i=0; i<ngauss; i++)
-      addmulttogradGaussian(&dv->gradval[i], &dvrowcol.gradval[i], 1.0);
-    done++;
-  }
-
-  // tell slaves we have finished
-  k[0] = -1;
-  for (rank=1; rank<mpisize; rank++) {
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-  }
+  calcgradPotentialmpiblock(P, Q, X, dX, dv);
+}
+
+
+void calcgradPotentialodmpiblock(const Interaction *P,
+				 const SlaterDet* Q, const SlaterDet* Qp,
+				 const SlaterDetAux* X, 
+				 const gradSlaterDetAux* dX,
+				 gradSlaterDet* dv)
+{
+  int i;
+  int A=Q->A;
+  int ngauss=Q->ngauss;
+  int k,l;
+  gradSlaterDet dvrowcol, dvsum;
+
+  allocategradSlaterDet(&dvrowcol, A);
+  initgradSlaterDet(Q, &dvsum);
+
+  for (k=0; k<A; k++)
+    for (l=0; l<A; l++)
+      if ((l+k*A) % mpisize == mpirank) {
+	calcgradPotentialodrowcol(P, Q, Qp, X, dX, &dvrowcol, k, l);
+	dvsum.val += dvrowcol.val;
+	for (i=0; i<ngauss; i++)
+	  addmulttogradGaussian(&dvsum.gradval[i], &dvrowcol.gradval[i], 1.0);
+      }
+
+  MPI_Allreduce(MPI_IN_PLACE, &dvsum.val, 1, MPI_DOUBLE_COMPLEX, MPI_SUM, 
+		MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, dvsum.gradval, 
+		ngauss*sizeof(gradGaussian)/sizeof(complex double), 
+		MPI_DOUBLE_COMPLEX, MPI_SUM, MPI_COMM_WORLD);
+
+  dv->val += dvsum.val;
+  for (i=0; i<ngauss; i++)
+    addmulttogradGaussian(&dv->gradval[i], &dvsum.gradval[i], 1.0);
 
   freegradSlaterDet(&dvrowcol);
+  freegradSlaterDet(&dvsum);
 }
 
 
@@ -146,80 +159,12 @@ void calcgradPotentialodmpi(const Interaction *P,
 			    gradSlaterDet* dv)
 {
   int task = TASKGRADPOTENTIALOD;
-  int i;
-  int A=Q->A;
-  int todo=A*A;
-  int ngauss=Q->ngauss;
-  int k[2]={0,0}; 
-  int done=0; int rank;
-  gradSlaterDet dvrowcol;
-  MPI_Status status;
-  
-  allocategradSlaterDet(&dvrowcol, A);
-
   BroadcastTask(&task);
+
   BroadcastSlaterDet(Q);
   BroadcastSlaterDet(Qp);
   // BroadcastSlaterDetAux(Q, X);
   // BroadcastgradSlaterDetAux(Q, dX);
 
-  // supply slaves with work
-  for (rank=1; rank<mpisize; rank++) {
-
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-    k[1]++;
-    if (k[1] == A) {
-      k[0]++; k[1]=0;
-    }
-  }
-
-  while (1) {
-    MPI_Recv(&dvrowcol.val, 1, MPI_DOUBLE_COMPLEX, MPI_ANY_SOURCE, 
-	     TAGGRADPOTENTIALODVAL,
-             MPI_COMM_WORLD, &status);
-    MPI_Recv(dvrowcol.gradval, ngauss*sizeof(gradGaussian), 
-             MPI_BYTE, MPI_ANY_SOURCE, TAGGRADPOTENTIALODGRAD, 
-             MPI_COMM_WORLD, &status); 
-    rank = status.MPI_SOURCE;
-
-    dv->val += dvrowcol.val;
-    for (i=0; i<ngauss; i++)
-      addmulttogradGaussian(&dv->gradval[i], &dvrowcol.gradval[i], 1.0);
-
-    done++;
-
-    // all work distributed ?
-    if (k[0] == A)
-      break;
-
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-
-    k[1]++;
-    if (k[1] == A) {
-      k[0]++; k[1]=0;
-    }
-  }
-
-  // collect remaining results
-  while (done<todo) {
-    MPI_Recv(&dvrowcol.val, 1, MPI_DOUBLE_COMPLEX, MPI_ANY_SOURCE, 
-	     TAGGRADPOTENTIALODVAL,
-             MPI_COMM_WORLD, &status);
-    MPI_Recv(dvrowcol.gradval, ngauss*sizeof(gradGaussian), 
-             MPI_BYTE, MPI_ANY_SOURCE, TAGGRADPOTENTIALODGRAD, 
-             MPI_COMM_WORLD, &status); 
-
-    dv->val += dvrowcol.val;
-    for (i=0; i<ngauss; i++)
-      addmulttogradGaussian(&dv->gradval[i], &dvrowcol.gradval[i], 1.0);
-    done++;
-  }
-
-  // tell slaves we have finished
-  k[0] = -1;
-  for (rank=1; rank<mpisize; rank++) {
-    MPI_Send(k, 2, MPI_INT, rank, TAGROWCOL, MPI_COMM_WORLD);
-  }
-
-  freegradSlaterDet(&dvrowcol);
+  calcgradPotentialodmpiblock(P, Q, Qp, X, dX, dv);
 }
@@ -43,4 +43,17 @@ void calcgradPotentialodmpi(const Interaction *P,
 			    const gradSlaterDetAux* dX,
 			    gradSlaterDet* dv);
 
+/// share of potential gradient calculated on this rank,
+/// summed over all ranks and added to dv, called by master and slaves
+void calcgradPotentialmpiblock(const Interaction *P,
+			       const SlaterDet* Q, const SlaterDetAux* X, 
+			       const gradSlaterDetAux* dX,
+			       gradSlaterDet* dv);
+
+void calcgradPotentialodmpiblock(const Interaction *P,
+				 const SlaterDet* Q, const SlaterDet* Qp,
+				 const SlaterDetAux* X, 
+				 const gradSlaterDetAux* dX,
+				 gradSlaterDet* dv);
+
 #endif
@@ -0,0 +1,195 @@
+/*
+
+  profile.c
+
+  named timers and counters for the hot paths
+
+  wall and cpu times of nested entries are inclusive, for code
+  running in several threads times of all threads are summed
+
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "profile.h"
+
+
+#define MAXPROFILE 64
+
+typedef struct {
+  char name[48];
+  long calls;
+  double wall;
+  double cpu;
+} profileentry;
+
+static profileentry entry[MAXPROFILE];
+static int nentry = 0;
+
+
+#ifdef PROFILE
+
+int profileid(int* id, const char* name)
+{
+  int i;
+
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+  i = *id;
+  if (i >= 0)
+    return i;
+
+#ifdef _OPENMP
+#pragma omp critical(profile)
+#endif
+  {
+    if (*id < 0) {
+      for (i=0; i<nentry; i++)
+	if (!strcmp(entry[i].name, name))
+	  break;
+      if (i == nentry && nentry < MAXPROFILE) {
+	strncpy(entry[i].name, name, 47);
+	nentry++;
+      }
+
+      // entries beyond MAXPROFILE are collected in the last one
+      if (i >= MAXPROFILE)
+	i = MAXPROFILE-1;
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+      *id = i;
+    }
+    i = *id;
+  }
+
+  return i;
+}
+
+
+void profilestart(profilestamp* t)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  t->wall = ts.tv_sec+1e-9*ts.tv_nsec;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  t->cpu = ts.tv_sec+1e-9*ts.tv_nsec;
+}
+
+
+void profilestop(int id, const profilestamp* t)
+{
+  profilestamp s;
+  profilestart(&s);
+
+  double wall = s.wall-t->wall;
+  double cpu = s.cpu-t->cpu;
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  entry[id].calls++;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  entry[id].wall += wall;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  entry[id].cpu += cpu;
+}
+
+
+void profilecount(int id, long n)
+{
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+  entry[id].calls += n;
+}
+
+#endif
+
+
+void fprintprofile(FILE* fp)
+{
+  int i;
+
+  if (!nentry)
+    return;
+
+  fprintf(fp, "\n# profile (pid %d)\n", getpid());
+  fprintf(fp, "# %-30s %12s %12s %12s %12s\n", 
+	  "entry", "calls", "wall [s]", "cpu [s]", "usec/call");
+  for (i=0; i<nentry; i++)
+    fprintf(fp, "  %-30s %12ld %12.3f %12.3f %12.3f\n",
+	    entry[i].name, entry[i].calls, entry[i].wall, entry[i].cpu,
+	    entry[i].calls ? 1e6*entry[i].wall/entry[i].calls : 0.0);
+}
+
+
+void fprintprofileJSON(FILE* fp)
+{
+  int i;
+
+  fprintf(fp, "{\n  \"pid\": %d,\n  \"profile\": [\n", getpid());
+  for (i=0; i<nentry; i++)
+    fprintf(fp, "    {\"entry\": \"%s\", \"calls\": %ld, \"wall\": %.6f, \"cpu\": %.6f}%s\n",
+	    entry[i].name, entry[i].calls, entry[i].wall, entry[i].cpu,
+	    i < nentry-1 ? "," : "");
+  fprintf(fp, "  ]\n}\n");
+}
+
+
+#ifdef PROFILE
+
+// $FMDPROFILE may contain %p for the process id
+static void reportprofile(void)
+{
+  char* fmt = getenv("FMDPROFILE");
+  char fname[255];
+  FILE* fp;
+  char* p;
+  int n;
+
+  if (!nentry)
+    return;
+
+  if (fmt) {
+    // only %p is expanded, everything else is taken literally
+    if ((p = strstr(fmt, "%p")))
+      n = snprintf(fname, 255, "%.*s%d%s", (int) (p-fmt), fmt, getpid(), p+2);
+    else
+      n = snprintf(fname, 255, "%s", fmt);
+    if (n >= 255) {
+      fprintf(stderr, "FMDPROFILE too long\n");
+      fprintprofile(stderr);
+      return;
+    }
+    if ((fp = fopen(fname, "w"))) {
+      fprintprofileJSON(fp);
+      fclose(fp);
+      return;
+    }
+    fprintf(stderr, "couldn't open %s for writing\n", fname);
+  }
+
+  fprintprofile(stderr);
+}
+
+#endif
+
+
+void reportprofileatexit(void)
+{
+#ifdef PROFILE
+  atexit(reportprofile);
+#endif
+}
@@ -0,0 +1,74 @@
+/*
+
+  profile.h
+
+  named timers and counters for the hot paths,
+  compiled in only with -DPROFILE
+
+
+*/
+
+
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+#include <stdio.h>
+
+
+#ifdef PROFILE
+
+typedef struct {
+  double wall;
+  double cpu;
+} profilestamp;
+
+/// index of profiling entry name, created on first use and
+/// remembered in *id, safe to call from several threads
+int profileid(int* id, const char* name);
+
+/// start timer
+void profilestart(profilestamp* t);
+
+/// stop timer, add elapsed time and one call to entry id
+void profilestop(int id, const profilestamp* t);
+
+/// add n calls to entry id
+void profilecount(int id, long n);
+
+
+/// time the code between PROFILEBEGIN and PROFILEEND,
+/// both have to be in the same block
+#define PROFILEBEGIN(name) \
+  { static int _profileid = -1; profilestamp _profilet; \
+    int _profileidx = profileid(&_profileid, name); \
+    profilestart(&_profilet);
+
+#define PROFILEEND \
+    profilestop(_profileidx, &_profilet); }
+
+/// count n events
+#define PROFILECOUNT(name, n) \
+  { static int _profileid = -1; \
+    profilecount(profileid(&_profileid, name), n); }
+
+#else
+
+#define PROFILEBEGIN(name) {
+#define PROFILEEND }
+#define PROFILECOUNT(name, n)
+
+#endif
+
+
+/// print table of all profiling entries,
+/// nothing if compiled without -DPROFILE
+void fprintprofile(FILE* fp);
+
+/// write profiling entries as JSON
+void fprintprofileJSON(FILE* fp);
+
+/// report at exit, as JSON to file $FMDPROFILE if set (%p is replaced
+/// by the process id), else as table to stderr
+void reportprofileatexit(void);
+
+#endif
@@ -19,7 +19,12 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "md5.h"
+#include "profile.h"
 #include "utils.h"
 
 
@@ -40,6 +45,8 @@ void createinfo(int argc, char* argv[])
   for (i=0; i<argc; i++)
     sprintf(c+strlen(infostring), "%s ", argv[i]);
   sprintf(c+strlen(infostring), "\n");
+
+  reportprofileatexit();
 }
 
 
@@ -258,3 +265,16 @@ int readstringsfromfile(const char* fname, int* n, char* string[])
 
   return 0;
 }
+
+
+// without an explicit thread number OMP_NUM_THREADS is used
+void setnumthreads(int n)
+{
+#ifdef _OPENMP
+  if (n > 0)
+    omp_set_num_threads(n);
+#else
+  if (n > 1)
+    fprintf(stderr, "compiled without OpenMP support, ignoring %d threads\n", n);
+#endif
+}
@@ -71,5 +71,8 @@ char* nucleusIDLformat(const char* name);
 /// read list of strings from file
 int readstringsfromfile(const char* fname, int* n, char* string[]);
 
+/// set number of threads used in shared-memory parallel loops
+void setnumthreads(int n);
+
 
 #endif
@@ -15,6 +15,7 @@
 
 
 #include <stdio.h>
+#include <math.h>
 #include <complex.h>
 
 
@@ -101,4 +102,40 @@ inline static complex double cvec3spat(const complex double a[3],
 }
 
 
+/// complex square root, principal branch,
+/// real arithmetic only, can be vectorized
+inline static complex double csqrtv(complex double z)
+{
+  double x = creal(z), y = cimag(z);
+  double t = sqrt(0.5*(sqrt(x*x+y*y)+fabs(x)));
+  double u = (t > 0.0) ? 0.5*y/t : 0.0;
+
+  return (x >= 0.0) ? t+I*u : fabs(u)+I*copysign(t, y);
+}
+
+/// complex x^3/2, can be vectorized
+inline static complex double cpow32v(complex double x)
+{
+  return(x*csqrtv(x));
+}
+
+/// complex exponential for n arguments z = (re, im), overwritten with 
+/// the results, sin and cos are evaluated in separate loops as gcc
+/// does not vectorize the combined sincos
+inline static void cexpv(int n, double* re, double* im)
+{
+  int i;
+  double e[n];
+
+#pragma omp simd
+  for (i=0; i<n; i++) {
+    e[i] = exp(re[i]);
+    re[i] = e[i]*cos(im[i]);
+  }
+#pragma omp simd
+  for (i=0; i<n; i++)
+    im[i] = e[i]*sin(im[i]);
+}
+
+
 #endif
@@ -56,3 +56,17 @@ complex double dzcoulomb(complex double z)
     csqr(b[0]+z*(b[1]+z*(b[2]+z*(b[3]+z*(b[4]+z*(b[5]+z*b[6]))))));
 }
 
+
+void zcoulombv(int n, double* re, double* im)
+{
+  complex double z, f;
+  int i;
+
+#pragma omp simd private(z, f)
+  for (i=0; i<n; i++) {
+    z = re[i]+I*im[i];
+    f = (a[0]+z*(a[1]+z*(a[2]+z*(a[3]+z*(a[4]+z*a[5])))))/
+      (b[0]+z*(b[1]+z*(b[2]+z*(b[3]+z*(b[4]+z*(b[5]+z*b[6]))))));
+    re[i] = creal(f); im[i] = cimag(f);
+  }
+}
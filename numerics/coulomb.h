@@ -22,6 +22,9 @@ complex double zcoulomb(complex double z);
 
 complex double dzcoulomb(complex double z);
 
+/// zcoulomb for n arguments z = (re, im), overwritten with the results
+void zcoulombv(int n, double* re, double* im);
+
 
 #endif
 
@@ -263,3 +263,28 @@ void ShiftedPeriodicTrapezoidalPoints(int n, double a, double b, double shift,
     w[i] = h;
   }
 }
+
+
+// Clenshaw-Curtis rule with n points x[k] = cos(k pi/(n-1)), mapped to [a,b]
+// nodes of the rule with n points are contained in the rule with 2n-1 points
+
+void ClenshawCurtisPoints(int n, double a, double b,
+			  double x[], double w[])
+{
+  int N = n-1;
+  int k, j;
+
+  if (N < 1) {
+    x[0] = 0.5*(a+b); w[0] = b-a;
+    return;
+  }
+
+  for (k=0; k<=N; k++) {
+    double s = 1.0;
+    for (j=1; 2*j<=N; j++)
+      s -= (2*j == N ? 1.0 : 2.0)/(4*j*j-1)*cos(2*j*k*M_PI/N);
+
+    x[k] = a+0.5*(b-a)*(1.0+cos(k*M_PI/N));
+    w[k] = 0.5*(b-a)*(k == 0 || k == N ? 1.0 : 2.0)/N*s;
+  }
+}
@@ -40,6 +40,9 @@ void ExtendedTrapezoidalPoints(int n, double a, double b,
 void ShiftedPeriodicTrapezoidalPoints(int n, double a, double b, double shift,
 				      double x[], double w[]);
 
+void ClenshawCurtisPoints(int n, double a, double b,
+			  double x[], double w[]);
+
 #endif
   
   
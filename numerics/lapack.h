@@ -77,4 +77,14 @@ void FORTRAN(zgeev)(const char* JOBVL, const char* JOBVR,
 		    complex double* WORK, const int* LWORK, double* RWORK, 
 		    int* INFO);
 
+
+/// BLAS: matrix-matrix product C = alpha op(A).op(B) + beta C
+void FORTRAN(zgemm)(const char* TRANSA, const char* TRANSB,
+		    const int* M, const int* N, const int* K,
+		    const complex double* ALPHA,
+		    const complex double* A, const int* LDA,
+		    const complex double* B, const int* LDB,
+		    const complex double* BETA,
+		    complex double* C, const int* LDC);
+
 #endif
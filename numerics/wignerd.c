@@ -0,0 +1,58 @@
+/**
+
+  \file wignerd.c
+
+  tables of Wigner d-functions
+
+*/
+
+
+#include <math.h>
+
+#include "wignerd.h"
+
+
+// j, m, k are twice the physical quantities
+inline static int idx(int j, int m, int k)
+{
+  return ((j+m)/2 + (j+k)/2*(j+1));
+}
+
+
+// d^j is obtained by coupling d^(j-1/2) with d^(1/2), 
+// all terms are well behaved, no cancellations as in the explicit sum
+void djmktable(int jmax, double beta, double* d)
+{
+  double c = cos(0.5*beta);
+  double s = sin(0.5*beta);
+
+  int j, m, k;
+  double* dj;
+  const double* djm;
+  double val;
+
+  if (jmax < 1)
+    return;
+
+  d[0] = 1.0;
+
+  for (j=1; j<jmax; j++) {
+    dj = d+idxdj(j);
+    djm = d+idxdj(j-1);
+
+    for (k=-j; k<=j; k=k+2)
+      for (m=-j; m<=j; m=m+2) {
+	val = 0.0;
+	if (m > -j && k > -j)
+	  val += sqrt((j+m)*(j+k))*c*djm[idx(j-1,m-1,k-1)];
+	if (m > -j && k < j)
+	  val -= sqrt((j+m)*(j-k))*s*djm[idx(j-1,m-1,k+1)];
+	if (m < j && k > -j)
+	  val += sqrt((j-m)*(j+k))*s*djm[idx(j-1,m+1,k-1)];
+	if (m < j && k < j)
+	  val += sqrt((j-m)*(j-k))*c*djm[idx(j-1,m+1,k+1)];
+
+	dj[idx(j,m,k)] = val/(2*j);
+      }
+  }
+}
@@ -41,4 +41,15 @@ inline static complex double Djmkstar(int j, int m, int k,
   return (cexp(0.5*I*(m*alpha+k*gamma))*FORTRAN(djmnb)(&j, &m, &k, &beta));
 }
 
+
+/// offset of d^j block in table with all j' < j
+inline static int idxdj(int j)
+{
+  return (j*(j+1)*(2*j+1)/6);
+}
+
+/// d^j_mk(beta) for all j < jmax, needs idxdj(jmax) doubles,
+/// d^j_mk stored at idxdj(j) + (j+m)/2 + (j+k)/2*(j+1)
+void djmktable(int jmax, double beta, double* d);
+
 #endif